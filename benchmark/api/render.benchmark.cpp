@@ -2,16 +2,32 @@
 
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/map_observer.hpp>
+#include <mbgl/map/map_render_pool.hpp>
 #include <mbgl/gl/headless_frontend.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/renderer/renderer.hpp>
+#include <mbgl/renderer/renderer_backend.hpp>
+#include <mbgl/gl/context.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
+#include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
 #include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/tile/tile_id.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/png_encoder.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <random>
 
 using namespace mbgl;
 
@@ -35,18 +51,242 @@ static void prepare(Map& map, optional<std::string> json = {}) {
     map.getStyle().addImage(std::make_unique<style::Image>("test-icon",
                                                            decodeImage(util::read_file("benchmark/fixtures/api/default_marker.png")), 1.0));
 }
+
+// A grid of circles with consecutive feature IDs whose color depends on their feature state.
+static std::string featureStateStyle(std::size_t featureCount) {
+    std::string features;
+    for (std::size_t i = 0; i < featureCount; i++) {
+        const double lon = -74.005 + 0.025 * (i % 100) / 100;
+        const double lat = 40.715 + 0.025 * (i / 100) / 100;
+        features += std::string(i ? "," : "") +
+            R"({"type":"Feature","id":)" + util::toString(i) +
+            R"(,"properties":{},"geometry":{"type":"Point","coordinates":[)" +
+            util::toString(lon) + "," + util::toString(lat) + "]}}";
+    }
+
+    return R"({"version":8,"sources":{"points":{"type":"geojson","data":{"type":"FeatureCollection","features":[)" +
+        features +
+        R"(]}}},"layers":[{"id":"points","type":"circle","source":"points","paint":{"circle-radius":4,)"
+        R"("circle-color":["case",["boolean",["feature-state","hover"],false],"red","blue"]}}]})";
+}
+
+// A grid of circles whose radius and color are properties of the features, drawn by two layers
+// that share a bucket and the functions of those properties.
+static std::string dataDrivenStyle(std::size_t featureCount) {
+    const char* colors[] = { "red", "green", "blue", "orange", "purple" };
+    std::string features;
+    for (std::size_t i = 0; i < featureCount; i++) {
+        const double lon = -74.005 + 0.025 * (i % 100) / 100;
+        const double lat = 40.715 + 0.025 * (i / 100) / 100;
+        features += std::string(i ? "," : "") +
+            R"({"type":"Feature","properties":{"radius":)" + util::toString(2 + i % 8) +
+            R"(,"color":")" + colors[i % 5] +
+            R"("},"geometry":{"type":"Point","coordinates":[)" +
+            util::toString(lon) + "," + util::toString(lat) + "]}}";
+    }
+
+    const std::string paint = R"("circle-radius":["get","radius"],"circle-color":["get","color"])";
+    return R"({"version":8,"sources":{"points":{"type":"geojson","data":{"type":"FeatureCollection","features":[)" +
+        features +
+        R"(]}}},"layers":[{"id":"points","type":"circle","source":"points","paint":{)" + paint + R"(}},)"
+        R"({"id":"outlines","type":"circle","source":"points","paint":{)" + paint +
+        R"(,"circle-opacity":0,"circle-stroke-width":1}}]})";
+}
+
+// Raster tiles that all show the same opaque image.
+static std::string rasterStyle() {
+    return R"({"version":8,"sources":{"raster":{"type":"raster","tileSize":256,)"
+        R"("tiles":["asset://test/fixtures/image/tile.jpeg"]}},)"
+        R"("layers":[{"id":"raster","type":"raster","source":"raster"}]})";
+}
+
+// Hillshaded raster-dem tiles that all show the same synthetic terrain.
+static std::string hillshadeStyle() {
+    return R"({"version":8,"sources":{"dem":{"type":"raster-dem","tileSize":256,"maxzoom":14,)"
+        R"("tiles":["asset://benchmark/fixtures/api/terrain_rgb.png"]}},)"
+        R"("layers":[{"id":"hillshade","type":"hillshade","source":"dem"}]})";
+}
  
+// A single wavy polygon with `vertexCount` vertices, the size of a small country, which is
+// neither simplified nor split when tiled: it lies within tile 7/64/63.
+static std::string largePolygonStyle(std::size_t vertexCount) {
+    std::string coordinates;
+    for (std::size_t i = 0; i <= vertexCount; i++) {
+        const double angle = util::M2PI * (i % vertexCount) / vertexCount;
+        const double radius = 0.5 + 0.01 * (i % 2);
+        coordinates += std::string(i ? "," : "") + "[" + util::toString(1.4 + radius * std::cos(angle)) + "," +
+            util::toString(1.4 + radius * std::sin(angle)) + "]";
+    }
+
+    return R"({"version":8,"sources":{"polygon":{"type":"geojson","tolerance":0,"maxzoom":7,)"
+        R"("data":{"type":"Polygon","coordinates":[[)" + coordinates + R"(]]}}},)"
+        R"("layers":[{"id":"polygon","type":"fill","source":"polygon","paint":{"fill-color":"red",)"
+        R"("fill-outline-color":"black"}}]})";
+}
+
+// Counts the frames of a map in continuous mode, and whether the last one was complete.
+class FrameObserver : public MapObserver {
+public:
+    void onDidFinishRenderingFrame(RenderMode mode) override {
+        frames++;
+        complete = mode == RenderMode::Full;
+    }
+
+    std::size_t frames = 0;
+    bool complete = false;
+};
+
 } // end namespace
 
+// Renders the same map every frame, reading each image back before rendering the next one, or
+// while the next one renders.
 static void API_renderStill_reuse_map(::benchmark::State& state) {
     RenderBenchmark bench;
     HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
     Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
     prepare(map);
 
+    gl::Context& context = frontend.getBackend()->getContext();
+    const std::size_t drawCalls = context.drawCalls;
+    const std::size_t programBinds = context.getProgramBinds();
+    const std::size_t textureBinds = context.getTextureBinds();
+    const std::size_t stateChanges = context.getStateChanges();
+
+    const bool pipelined = state.range(0);
+    while (state.KeepRunning()) {
+        if (pipelined) {
+            frontend.renderPipelined(map);
+        } else {
+            frontend.render(map);
+        }
+    }
+
+    if (pipelined) {
+        frontend.finishRender();
+    }
+
+    state.counters["drawCalls"] = double(context.drawCalls - drawCalls) / state.iterations();
+    state.counters["programBinds"] = double(context.getProgramBinds() - programBinds) / state.iterations();
+    state.counters["textureBinds"] = double(context.getTextureBinds() - textureBinds) / state.iterations();
+    state.counters["stateChanges"] = double(context.getStateChanges() - stateChanges) / state.iterations();
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(pipelined ? "pipelined" : "synchronous");
+}
+
+// Renders the benchmark style with a translucent background layer over it, which is drawn with a
+// single draw call rather than one per tile, and reports the draw calls per frame.
+static void API_renderStill_background_overlay(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+    prepare(map);
+
+    auto overlay = std::make_unique<style::BackgroundLayer>("overlay");
+    overlay->setBackgroundColor(Color::black());
+    overlay->setBackgroundOpacity(0.25f);
+    map.getStyle().addLayer(std::move(overlay));
+    frontend.render(map);
+
+    gl::Context& context = frontend.getBackend()->getContext();
+    const std::size_t drawCalls = context.drawCalls;
+
+    while (state.KeepRunning()) {
+        frontend.render(map);
+    }
+
+    state.counters["drawCalls"] = double(context.drawCalls - drawCalls) / state.iterations();
+}
+
+// Loads and renders a style with a single large polygon, which is drawn in one segment when the
+// context supports 32-bit indices, and reports the draw calls per frame.
+static void API_renderStill_large_polygon(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+    const std::string style = largePolygonStyle(state.range(0));
+    map.setLatLngZoom({ 1.4, 1.4 }, 7);
+
+    gl::Context& context = frontend.getBackend()->getContext();
+    const std::size_t drawCalls = context.drawCalls;
+
+    while (state.KeepRunning()) {
+        map.getStyle().loadJSON(style);
+        frontend.render(map);
+    }
+
+    state.counters["drawCalls"] = double(context.drawCalls - drawCalls) / state.iterations();
+    state.SetLabel(context.supportsUint32Indices ? "32-bit indices" : "16-bit indices");
+}
+
+// Loads and renders a style with data-driven paint properties, with its paint attributes
+// uploaded as floats or in compact types, and reports the size of the vertex and index buffers
+// and the bytes per vertex, including paint attributes.
+static void API_renderStill_data_driven_attributes(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+    const std::string style = dataDrivenStyle(10000);
+    map.setLatLngZoom({ 40.7275, -73.9925 }, 15);
+
+    const bool compact = state.range(0);
+    frontend.getRenderer()->setCompactVertexAttributes(compact);
+
+    gl::Context& context = frontend.getBackend()->getContext();
+    const std::size_t vertexBytes = context.vertexBufferBytes;
+    const std::size_t vertices = context.vertexBufferVertices;
+    const std::size_t indexBytes = context.indexBufferBytes;
+
     while (state.KeepRunning()) {
+        map.getStyle().loadJSON(style);
         frontend.render(map);
     }
+
+    const double iterations = state.iterations();
+    state.counters["vertexBytes"] = (context.vertexBufferBytes - vertexBytes) / iterations;
+    state.counters["indexBytes"] = (context.indexBufferBytes - indexBytes) / iterations;
+    state.counters["bytesPerVertex"] = double(context.vertexBufferBytes - vertexBytes) / (context.vertexBufferVertices - vertices);
+    state.SetLabel(compact ? "compact" : "float");
+}
+
+// Renders the frames of a map in continuous mode right after zooming in, while its tiles are
+// still drawn in place of their children, with the tiles clipped with the stencil buffer or with
+// scissor rectangles from tile masks, and reports the draw calls and state changes per frame.
+static void API_renderContinuous_zoom_transition(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    FrameObserver observer;
+    Map map { frontend, observer, frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Continuous };
+    prepare(map);
+
+    const bool tileMasks = state.range(0);
+    frontend.getRenderer()->setTileMaskClipping(tileMasks);
+
+    auto renderFrame = [&] {
+        const std::size_t frames = observer.frames;
+        map.triggerRepaint();
+        while (observer.frames == frames) {
+            bench.loop.runOnce();
+        }
+    };
+
+    // The fixtures only have tiles of zoom level 15, which keep standing in for their children.
+    while (!observer.complete) {
+        renderFrame();
+    }
+    map.setZoom(16);
+    renderFrame();
+
+    gl::Context& context = frontend.getBackend()->getContext();
+    const std::size_t drawCalls = context.drawCalls;
+    const std::size_t stateChanges = context.getStateChanges();
+
+    while (state.KeepRunning()) {
+        renderFrame();
+    }
+
+    state.counters["drawCalls"] = double(context.drawCalls - drawCalls) / state.iterations();
+    state.counters["stateChanges"] = double(context.getStateChanges() - stateChanges) / state.iterations();
+    state.SetLabel(tileMasks ? "tile masks" : "stencil");
 }
 
 static void API_renderStill_reuse_map_switch_styles(::benchmark::State& state) {
@@ -62,6 +302,96 @@ static void API_renderStill_reuse_map_switch_styles(::benchmark::State& state) {
     }
 }
 
+static void API_renderStill_animate_paint_property(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+    prepare(map);
+    frontend.render(map);
+
+    auto park = map.getStyle().getLayer("park")->as<style::FillLayer>();
+    float t = 0;
+
+    while (state.KeepRunning()) {
+        t = t < 1 ? t + 0.01f : 0;
+        park->setFillColor(Color { t, 1 - t, 0.5f, 1.0f });
+        frontend.render(map);
+    }
+}
+
+static void API_renderStill_feature_state(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+
+    const std::size_t featureCount = 10000;
+    const auto updatesPerFrame = static_cast<std::size_t>(state.range(0));
+    map.getStyle().loadJSON(featureStateStyle(featureCount));
+    map.setLatLngZoom({ 40.726989, -73.992857 }, 15);
+    frontend.render(map);
+
+    Renderer& renderer = *frontend.getRenderer();
+    std::size_t next = 0;
+    bool hover = true;
+
+    while (state.KeepRunning()) {
+        for (std::size_t i = 0; i < updatesPerFrame; i++) {
+            renderer.setFeatureState("points", {}, util::toString(next), FeatureState {{ "hover", hover }});
+            if (++next == featureCount) {
+                next = 0;
+                hover = !hover;
+            }
+        }
+        frontend.render(map);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Renders a different area of raster tiles every frame, with or without compressed textures.
+static void API_renderStill_raster(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+    frontend.getRenderer()->setRasterTextureCompression(state.range(0));
+    map.getStyle().loadJSON(rasterStyle());
+
+    gl::Context& context = frontend.getBackend()->getContext();
+    std::size_t textureBytes = 0;
+    double longitude = -180;
+
+    while (state.KeepRunning()) {
+        longitude = longitude < 150 ? longitude + 10 : -180;
+        map.setLatLngZoom({ 0, longitude }, 8);
+        frontend.render(map);
+        textureBytes += frontend.getRenderer()->getRasterTextureBytes();
+    }
+
+    state.counters["textureMB"] = double(textureBytes) / state.iterations() / (1024 * 1024);
+    state.counters["uploadMs"] = std::chrono::duration<double, std::milli>(context.textureUploadTime).count() / state.iterations();
+    state.SetLabel(state.range(0) ? "compressed" : "rgba");
+}
+
+// Renders a different area of hillshaded tiles every frame, with the slopes prepared in a render
+// pass or on the workers.
+static void API_renderStill_hillshade(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 1000, 1000 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+    frontend.getRenderer()->setHillshadePrepareOnWorkers(state.range(0));
+    map.getStyle().loadJSON(hillshadeStyle());
+
+    double longitude = -180;
+
+    while (state.KeepRunning()) {
+        longitude = longitude < 150 ? longitude + 10 : -180;
+        map.setLatLngZoom({ 0, longitude }, 10);
+        frontend.render(map);
+    }
+
+    state.SetLabel(state.range(0) ? "workers" : "render pass");
+}
+
 static void API_renderStill_recreate_map(::benchmark::State& state) {
     RenderBenchmark bench;
     
@@ -73,6 +403,153 @@ static void API_renderStill_recreate_map(::benchmark::State& state) {
     }
 }
 
-BENCHMARK(API_renderStill_reuse_map);
+// Renders batches of 512x512 images of random places in Manhattan with a pool of maps, like a
+// tile server does, and reports the renders per second and the 99th percentile latency from
+// submitting a request to receiving its image.
+static void API_renderPool(::benchmark::State& state) {
+    using Clock = std::chrono::steady_clock;
+
+    RenderBenchmark bench;
+    MapRenderPool pool { bench.fileSource, bench.threadPool, "asset://benchmark/fixtures/api/style.json",
+                         static_cast<std::size_t>(state.range(0)) };
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::size_t remaining = 0;
+    std::vector<double> latencies;
+    std::exception_ptr failure;
+
+    std::mt19937 generator;
+    std::uniform_real_distribution<double> offset(-0.01, 0.01);
+
+    const auto renderBatch = [&](std::size_t count) {
+        remaining = count;
+        for (std::size_t i = 0; i < count; i++) {
+            CameraOptions camera;
+            camera.center = LatLng { 40.726989 + offset(generator), -73.992857 + offset(generator) };
+            camera.zoom = 15;
+
+            const auto start = Clock::now();
+            pool.render({ camera, { 512, 512 }, 1 }, [&, start](std::exception_ptr error, PremultipliedImage) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (error) {
+                    failure = error;
+                }
+                latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+                if (--remaining == 0) {
+                    finished.notify_one();
+                }
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return remaining == 0; });
+    };
+
+    // Every map of the pool loads the style and the tiles once, like servers do on startup.
+    renderBatch(pool.size());
+    latencies.clear();
+
+    const std::size_t batchSize = 4 * pool.size();
+    const auto start = Clock::now();
+
+    while (state.KeepRunning()) {
+        renderBatch(batchSize);
+    }
+
+    if (failure) {
+        state.SkipWithError(util::toString(failure).c_str());
+        return;
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["rendersPerSecond"] = latencies.size() / seconds;
+    state.counters["p99Ms"] = latencies[latencies.size() * 99 / 100];
+    state.SetItemsProcessed(latencies.size());
+}
+
+// Renders 512x512 images of random places in Manhattan and encodes them as PNGs like mbgl-render
+// does, either on the render thread or with a PNGEncoder on the workers, and reports the images
+// per second.
+static void API_renderStill_encodePNG(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 512, 512 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Static};
+    prepare(map);
+    frontend.render(map);
+
+    const bool async = state.range(0);
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::size_t pending = 0;
+    PNGEncoder encoder { bench.threadPool, 4 };
+
+    std::mt19937 generator;
+    std::uniform_real_distribution<double> offset(-0.01, 0.01);
+
+    while (state.KeepRunning()) {
+        map.setLatLngZoom({ 40.726989 + offset(generator), -73.992857 + offset(generator) }, 15);
+        PremultipliedImage image = frontend.render(map);
+
+        if (!async) {
+            benchmark::DoNotOptimize(encodePNG(image));
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending++;
+        }
+        encoder.encode(std::move(image), [&](std::exception_ptr, std::string png) {
+            benchmark::DoNotOptimize(png);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                finished.notify_one();
+            }
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return pending == 0; });
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(async ? "workers" : "render thread");
+}
+
+// Renders the 4x4 block of z15 tiles in Manhattan that the fixtures cache, as metatiles of 1x1
+// or 4x4 tiles, and reports the tiles per second.
+static void API_renderMetatile(::benchmark::State& state) {
+    RenderBenchmark bench;
+    HeadlessFrontend frontend { { 512, 512 }, 1, bench.fileSource, bench.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Tile};
+    prepare(map);
+
+    const uint32_t count = state.range(0);
+    const uint32_t blocks = 4 / count;
+    uint32_t next = 0;
+
+    while (state.KeepRunning()) {
+        const CanonicalTileID id { 15, 9647 + (next % blocks) * count, 12316 + (next / blocks) * count };
+        next = (next + 1) % (blocks * blocks);
+        benchmark::DoNotOptimize(frontend.renderMetatile(map, id, count));
+    }
+
+    state.SetItemsProcessed(state.iterations() * count * count);
+    state.SetLabel(util::toString(count) + "x" + util::toString(count));
+}
+
+BENCHMARK(API_renderStill_reuse_map)->Arg(false)->Arg(true)->UseRealTime();
+BENCHMARK(API_renderStill_background_overlay);
+BENCHMARK(API_renderStill_large_polygon)->Arg(20000)->Arg(200000)->Unit(benchmark::kMillisecond);
+BENCHMARK(API_renderStill_data_driven_attributes)->Arg(false)->Arg(true)->Unit(benchmark::kMillisecond);
+BENCHMARK(API_renderContinuous_zoom_transition)->Arg(false)->Arg(true);
 BENCHMARK(API_renderStill_reuse_map_switch_styles);
+BENCHMARK(API_renderStill_animate_paint_property);
+BENCHMARK(API_renderStill_feature_state)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(API_renderStill_raster)->Arg(false)->Arg(true);
+BENCHMARK(API_renderStill_hillshade)->Arg(false)->Arg(true);
 BENCHMARK(API_renderStill_recreate_map);
+BENCHMARK(API_renderStill_encodePNG)->Arg(false)->Arg(true)->UseRealTime();
+BENCHMARK(API_renderMetatile)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond);
+BENCHMARK(API_renderPool)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond)->UseRealTime();
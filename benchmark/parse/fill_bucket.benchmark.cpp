@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// The polygons of a layer of a fixture tile. The streets fixtures have no buildings, but their
+// water and landcover layers have plenty of large polygons.
+class PolygonLayer {
+public:
+    PolygonLayer(std::shared_ptr<const std::string> data, const std::string& name)
+        : tile(std::move(data)), layer(tile.getLayer(name)) {
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            if (feature->getType() == FeatureType::Polygon) {
+                GeometryCollection geometries = feature->getGeometries();
+                features.emplace_back(std::move(feature), std::move(geometries));
+            }
+        }
+    }
+
+    VectorTileData tile;
+    std::unique_ptr<GeometryTileLayer> layer;
+    std::vector<std::pair<std::unique_ptr<GeometryTileFeature>, GeometryCollection>> features;
+};
+
+} // namespace
+
+// Lays out the polygon layers of the streets fixture tiles into fill buckets, tessellating them
+// on the calling thread alone or with the help of a thread pool, and reports the vertices per
+// iteration.
+static void Layout_FillBucket(benchmark::State& state) {
+    const auto world = std::make_shared<const std::string>(util::read_file("test/fixtures/api/assets/streets/0-0-0.vector.pbf"));
+    const auto tile = std::make_shared<const std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+
+    std::vector<std::unique_ptr<PolygonLayer>> layers;
+    layers.push_back(std::make_unique<PolygonLayer>(world, "water"));
+    for (const auto& name : { "landcover", "landuse", "landuse_overlay", "water" }) {
+        layers.push_back(std::make_unique<PolygonLayer>(tile, name));
+    }
+
+    const bool parallel = state.range(0);
+    ThreadPool threadPool { 4 };
+    const BucketParameters parameters { { 0, 0, 0 }, MapMode::Static, 1.0, gl::IndexType::UnsignedInt, false,
+                                        parallel ? &threadPool : nullptr };
+
+    std::size_t vertices = 0;
+    while (state.KeepRunning()) {
+        for (const auto& layer : layers) {
+            FillBucket bucket { parameters, {} };
+            for (const auto& feature : layer->features) {
+                bucket.addFeature(*feature.first, feature.second);
+            }
+            bucket.finishFeatures();
+            vertices += bucket.getVertexCount();
+        }
+    }
+
+    state.counters["vertices"] = double(vertices) / state.iterations();
+    state.SetLabel(parallel ? "parallel" : "serial");
+}
+
+BENCHMARK(Layout_FillBucket)->Arg(false)->Arg(true)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/renderer/buckets/line_bucket.hpp>
+#include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mbgl;
+
+// Lays out the fill and line layers of a streets fixture tile into buckets the way the tile
+// worker does, first simplifying their geometries with the tolerance in pixels given as the
+// argument, and reports the vertices per iteration.
+static void Layout_Simplification(benchmark::State& state) {
+    const OverscaledTileID id { 10, 163, 395 };
+    const float pixelRatio = 1;
+    const double tolerance = state.range(0)
+        ? id.toUnwrapped().pixelsToTileUnits(state.range(0) / pixelRatio, id.overscaledZ)
+        : 0;
+
+    VectorTileData data { std::make_shared<const std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")) };
+    const std::vector<std::string> fillLayers { "landcover", "landuse", "landuse_overlay", "water" };
+    const std::vector<std::string> lineLayers { "road", "waterway", "admin" };
+
+    const BucketParameters parameters { id, MapMode::Static, pixelRatio, gl::IndexType::UnsignedInt, false, nullptr };
+    const style::LineLayoutProperties::Unevaluated lineLayout;
+
+    std::size_t vertices = 0;
+    auto layOut = [&] (Bucket& bucket, const std::string& name) {
+        auto layer = data.getLayer(name);
+        for (std::size_t i = 0; i < layer->featureCount(); i++) {
+            auto feature = layer->getFeature(i);
+            GeometryCollection geometries = feature->getGeometries();
+            if (tolerance > 0) {
+                geometries = simplifyGeometries(geometries, feature->getType(), tolerance);
+            }
+            if (!geometries.empty()) {
+                bucket.addFeature(*feature, geometries);
+            }
+        }
+        vertices += bucket.getVertexCount();
+    };
+
+    while (state.KeepRunning()) {
+        for (const auto& name : fillLayers) {
+            FillBucket bucket { parameters, {} };
+            layOut(bucket, name);
+        }
+        for (const auto& name : lineLayers) {
+            LineBucket bucket { parameters, {}, lineLayout };
+            layOut(bucket, name);
+        }
+    }
+
+    state.counters["vertices"] = double(vertices) / state.iterations();
+}
+
+BENCHMARK(Layout_Simplification)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/style/source_observer.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// A grid of points with consecutive feature IDs over Manhattan.
+FeatureCollection points(std::size_t featureCount) {
+    FeatureCollection features;
+    for (std::size_t i = 0; i < featureCount; i++) {
+        Feature feature { mapbox::geometry::point<double>{
+            -74.005 + 0.025 * (i % 256) / 256,
+            40.715 + 0.025 * (i / 256) / 256 } };
+        feature.id = uint64_t(i);
+        features.push_back(std::move(feature));
+    }
+    return features;
+}
+
+// The tile containing the grid at z14, which is cut again after every update.
+const CanonicalTileID tileID { 14, 4824, 6158 };
+
+std::shared_ptr<GeoJSONData> getData(const GeoJSONSource& source) {
+    return static_cast<const GeoJSONSource::Impl&>(*source.baseImpl).getData();
+}
+
+class LoadObserver : public SourceObserver {
+public:
+    LoadObserver(util::RunLoop& loop_) : loop(loop_) {}
+
+    void onSourceLoaded(Source&) override {
+        loop.stop();
+    }
+
+    util::RunLoop& loop;
+};
+
+} // end namespace
+
+// Moves a single feature and cuts the tile it is in, as happens when streaming positions of
+// tracked objects into a large data set.
+static void GeoJSONSource_updateFeature(::benchmark::State& state) {
+    const std::size_t featureCount = state.range(0);
+    GeoJSONSource source("source");
+    source.setGeoJSON(GeoJSON{ points(featureCount) });
+    getData(source)->getTile(tileID);
+
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        GeoJSONDiff diff;
+        Feature feature { mapbox::geometry::point<double>{ -74.0 + 0.00001 * (i % 100), 40.72 } };
+        feature.id = uint64_t(i++ % featureCount);
+        diff.add.push_back(std::move(feature));
+
+        source.updateGeoJSON(diff);
+        benchmark::DoNotOptimize(getData(source)->getTile(tileID));
+    }
+}
+
+// Replaces the whole data set to move a single feature, for comparison.
+static void GeoJSONSource_setGeoJSON(::benchmark::State& state) {
+    const std::size_t featureCount = state.range(0);
+    GeoJSONSource source("source");
+    FeatureCollection features = points(featureCount);
+
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        features[i % featureCount].geometry = mapbox::geometry::point<double>{ -74.0 + 0.00001 * (i % 100), 40.72 };
+        i++;
+
+        source.setGeoJSON(GeoJSON{ features });
+        benchmark::DoNotOptimize(getData(source)->getTile(tileID));
+    }
+}
+
+// Time the map thread is blocked by setGeoJSON with a large data set. Without a run loop, the
+// data is indexed synchronously, like it was before indexing moved to the thread pool; the
+// z0 tile is cut to include the initial geojson-vt split, which used to happen up front.
+static void GeoJSONSource_setGeoJSON_blocking_sync(::benchmark::State& state) {
+    GeoJSONOptions options;
+    options.cluster = state.range(1);
+    const GeoJSON geoJSON { points(state.range(0)) };
+
+    while (state.KeepRunning()) {
+        GeoJSONSource source("source", options);
+        source.setGeoJSON(geoJSON);
+        benchmark::DoNotOptimize(getData(source)->getTile({ 0, 0, 0 }));
+    }
+}
+
+// With a run loop, only copying the data to the loader blocks the map thread. Waiting for the
+// index isn't timed.
+static void GeoJSONSource_setGeoJSON_blocking_async(::benchmark::State& state) {
+    GeoJSONOptions options;
+    options.cluster = state.range(1);
+    const GeoJSON geoJSON { points(state.range(0)) };
+
+    util::RunLoop loop;
+    LoadObserver observer { loop };
+
+    while (state.KeepRunning()) {
+        GeoJSONSource source("source", options);
+        source.setObserver(&observer);
+        source.setGeoJSON(geoJSON);
+
+        state.PauseTiming();
+        loop.run();
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(GeoJSONSource_setGeoJSON_blocking_sync)->Args({ 100000, false })->Args({ 100000, true });
+BENCHMARK(GeoJSONSource_setGeoJSON_blocking_async)->Args({ 100000, false })->Args({ 100000, true });
+BENCHMARK(GeoJSONSource_updateFeature)->Arg(1000)->Arg(10000)->Arg(50000);
+BENCHMARK(GeoJSONSource_setGeoJSON)->Arg(1000)->Arg(10000)->Arg(50000);
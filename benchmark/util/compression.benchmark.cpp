@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+using util::CompressionCodec;
+
+namespace {
+
+// The data the offline database stores: vector tiles, a TileJSON and a raster tile, which
+// doesn't compress.
+const std::vector<std::string>& fixtures() {
+    static const std::vector<std::string> data {
+        util::read_file("test/fixtures/api/assets/streets/0-0-0.vector.pbf"),
+        util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"),
+        util::read_file("test/fixtures/api/assets/streets.json"),
+        util::read_file("test/fixtures/image/tile.png"),
+    };
+    return data;
+}
+
+} // end namespace
+
+// Compresses the fixtures as they are written to the database. `ratio` is the size of the data
+// relative to the size of the compressed data.
+static void Compression_compress(benchmark::State& state) {
+    const auto codec = CompressionCodec(state.range(0));
+    std::size_t rawSize = 0;
+    std::size_t compressedSize = 0;
+
+    while (state.KeepRunning()) {
+        rawSize = compressedSize = 0;
+        for (const auto& raw : fixtures()) {
+            const std::string compressed = util::compress(raw, codec);
+            rawSize += raw.size();
+            compressedSize += compressed.size();
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * rawSize);
+    state.counters["ratio"] = double(rawSize) / compressedSize;
+}
+
+// Decompresses the fixtures as they are read from the database on every cache hit.
+static void Compression_decompress(benchmark::State& state) {
+    const auto codec = CompressionCodec(state.range(0));
+    std::vector<std::string> compressed;
+    std::size_t rawSize = 0;
+    for (const auto& raw : fixtures()) {
+        compressed.push_back(util::compress(raw, codec));
+        rawSize += raw.size();
+    }
+
+    while (state.KeepRunning()) {
+        for (const auto& data : compressed) {
+            benchmark::DoNotOptimize(util::decompress(data, codec));
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * rawSize);
+}
+
+BENCHMARK(Compression_compress)
+    ->Arg(int(CompressionCodec::Zlib))
+    ->Arg(int(CompressionCodec::LZ4));
+BENCHMARK(Compression_decompress)
+    ->Arg(int(CompressionCodec::Zlib))
+    ->Arg(int(CompressionCodec::LZ4));
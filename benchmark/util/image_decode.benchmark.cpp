@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+// Decodes an encoded image into a premultiplied image, as raster tile workers and the sprite
+// parser do.
+static void decode(benchmark::State& state, const std::string& path) {
+    const std::string data = util::read_file(path);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(decodeImage(data));
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void Decode_RasterTilePNG(benchmark::State& state) {
+    decode(state, "test/fixtures/image/tile.png");
+}
+
+static void Decode_RasterTileJPEG(benchmark::State& state) {
+    decode(state, "test/fixtures/image/tile.jpeg");
+}
+
+static void Decode_RasterTileWebP(benchmark::State& state) {
+    decode(state, "test/fixtures/image/tile.webp");
+}
+
+static void Decode_Sprite(benchmark::State& state) {
+    decode(state, "test/fixtures/resources/sprite.png");
+}
+
+BENCHMARK(Decode_RasterTilePNG);
+BENCHMARK(Decode_RasterTileJPEG);
+BENCHMARK(Decode_RasterTileWebP);
+BENCHMARK(Decode_Sprite);
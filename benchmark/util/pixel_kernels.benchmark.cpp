@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/pixel_kernels.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+using util::InstructionSet;
+
+namespace {
+
+// Tiles of the size given by the first argument, with pixels that exercise every alpha value.
+std::vector<uint8_t> tile(std::size_t size) {
+    std::vector<uint8_t> data(size * size * 4);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data[i] = (i * 37 + i / 4) & 0xFF;
+    }
+    return data;
+}
+
+// Runs the benchmark with the instruction set given by the second argument, or skips it if the
+// CPU doesn't support it.
+template <class Fn>
+void run(::benchmark::State& state, Fn&& fn) {
+    const auto set = InstructionSet(state.range(1));
+    if (!util::supports(set)) {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+
+    const std::size_t count = state.range(0) * state.range(0);
+    while (state.KeepRunning()) {
+        fn(count, set);
+    }
+    state.SetBytesProcessed(state.iterations() * count * 4);
+}
+
+void arguments(::benchmark::internal::Benchmark* benchmark) {
+    for (auto size : { 256, 512 }) {
+        for (auto set : { InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::NEON }) {
+            benchmark->Args({ size, int(set) });
+        }
+    }
+}
+
+} // end namespace
+
+static void Util_premultiply(::benchmark::State& state) {
+    auto data = tile(state.range(0));
+    run(state, [&] (std::size_t count, InstructionSet set) {
+        util::premultiply(data.data(), count, set);
+    });
+}
+
+static void Util_unpremultiply(::benchmark::State& state) {
+    auto data = tile(state.range(0));
+    run(state, [&] (std::size_t count, InstructionSet set) {
+        util::unpremultiply(data.data(), count, set);
+    });
+}
+
+static void Util_decodeMapboxDEM(::benchmark::State& state) {
+    const auto data = tile(state.range(0));
+    std::vector<int32_t> elevation(data.size() / 4);
+    run(state, [&] (std::size_t count, InstructionSet set) {
+        util::decodeMapboxDEM(data.data(), elevation.data(), count, set);
+    });
+}
+
+static void Util_decodeTerrariumDEM(::benchmark::State& state) {
+    const auto data = tile(state.range(0));
+    std::vector<int32_t> elevation(data.size() / 4);
+    run(state, [&] (std::size_t count, InstructionSet set) {
+        util::decodeTerrariumDEM(data.data(), elevation.data(), count, set);
+    });
+}
+
+// Computes the hillshade slopes of a tile, with a padding of one pixel.
+static void Util_hillshadeSlopes(::benchmark::State& state) {
+    const std::size_t size = state.range(0);
+    std::vector<int32_t> elevation((size + 2) * (size + 2));
+    for (std::size_t i = 0; i < elevation.size(); i++) {
+        elevation[i] = 65536 + (i * 37 + i / (size + 2)) % 4000;
+    }
+    std::vector<uint8_t> slopes(size * size * 4);
+    run(state, [&] (std::size_t, InstructionSet set) {
+        for (std::size_t y = 0; y < size; y++) {
+            const int32_t* row = elevation.data() + (y + 1) * (size + 2) + 1;
+            util::hillshadeSlopes(row - size - 2, row, row + size + 2, slopes.data() + y * size * 4, size, 0.01f, set);
+        }
+    });
+}
+
+// Downsamples a tile to its first mipmap level.
+static void Util_downsample(::benchmark::State& state) {
+    const auto data = tile(state.range(0));
+    const std::size_t size = state.range(0);
+    std::vector<uint8_t> level(data.size() / 4);
+    run(state, [&] (std::size_t, InstructionSet set) {
+        for (std::size_t y = 0; y < size / 2; y++) {
+            const uint8_t* row = data.data() + 2 * y * size * 4;
+            util::downsample(row, row + size * 4, level.data() + y * size * 2, size / 2, set);
+        }
+    });
+}
+
+BENCHMARK(Util_premultiply)->Apply(arguments);
+BENCHMARK(Util_unpremultiply)->Apply(arguments);
+BENCHMARK(Util_decodeMapboxDEM)->Apply(arguments);
+BENCHMARK(Util_decodeTerrariumDEM)->Apply(arguments);
+BENCHMARK(Util_hillshadeSlopes)->Apply(arguments);
+BENCHMARK(Util_downsample)->Apply(arguments);
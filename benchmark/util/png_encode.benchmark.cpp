@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+// Encodes a rendered map with the given options, and reports the size of the PNG.
+static void encode(benchmark::State& state, const PNGEncodeOptions& options) {
+    const PremultipliedImage image = decodeImage(util::read_file("test/fixtures/annotations/emerald@2x.png"));
+    std::size_t size = 0;
+
+    while (state.KeepRunning()) {
+        size = encodePNG(image, options).size();
+    }
+
+    state.SetBytesProcessed(state.iterations() * image.bytes());
+    state.counters["ratio"] = double(image.bytes()) / size;
+}
+
+static void EncodePNG_Default(benchmark::State& state) {
+    encode(state, {});
+}
+
+static void EncodePNG_Fast(benchmark::State& state) {
+    PNGEncodeOptions options;
+    options.compressionLevel = 1;
+    options.filter = PNGEncodeOptions::Filter::Up;
+    encode(state, options);
+}
+
+static void EncodePNG_Adaptive(benchmark::State& state) {
+    PNGEncodeOptions options;
+    options.filter = PNGEncodeOptions::Filter::Adaptive;
+    encode(state, options);
+}
+
+static void EncodePNG_Smallest(benchmark::State& state) {
+    PNGEncodeOptions options;
+    options.compressionLevel = 9;
+    options.filter = PNGEncodeOptions::Filter::Adaptive;
+    encode(state, options);
+}
+
+static void EncodePNG_Quantize(benchmark::State& state) {
+    PNGEncodeOptions options;
+    options.palette = PNGEncodeOptions::Palette::Quantize;
+    encode(state, options);
+}
+
+BENCHMARK(EncodePNG_Default);
+BENCHMARK(EncodePNG_Fast);
+BENCHMARK(EncodePNG_Adaptive);
+BENCHMARK(EncodePNG_Smallest);
+BENCHMARK(EncodePNG_Quantize);
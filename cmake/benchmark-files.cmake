@@ -17,11 +17,20 @@ set(MBGL_BENCHMARK_FILES
     benchmark/function/source_function.benchmark.cpp
 
     # parse
+    benchmark/parse/fill_bucket.benchmark.cpp
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/simplification.benchmark.cpp
     benchmark/parse/tile_mask.benchmark.cpp
     benchmark/parse/vector_tile.benchmark.cpp
 
+    # style
+    benchmark/style/geojson_source.benchmark.cpp
+
     # util
+    benchmark/util/compression.benchmark.cpp
     benchmark/util/dtoa.benchmark.cpp
+    benchmark/util/image_decode.benchmark.cpp
+    benchmark/util/pixel_kernels.benchmark.cpp
+    benchmark/util/png_encode.benchmark.cpp
 
 )
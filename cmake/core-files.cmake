@@ -73,6 +73,7 @@ set(MBGL_CORE_FILES
     src/mbgl/gl/index_buffer.hpp
     src/mbgl/gl/object.cpp
     src/mbgl/gl/object.hpp
+    src/mbgl/gl/pixel_buffer_extension.hpp
     src/mbgl/gl/primitives.hpp
     src/mbgl/gl/program.hpp
     src/mbgl/gl/program_binary_extension.hpp
@@ -211,6 +212,8 @@ set(MBGL_CORE_FILES
     src/mbgl/renderer/renderer_backend.cpp
     src/mbgl/renderer/renderer_impl.cpp
     src/mbgl/renderer/renderer_impl.hpp
+    src/mbgl/renderer/source_state.cpp
+    src/mbgl/renderer/source_state.hpp
     src/mbgl/renderer/style_diff.cpp
     src/mbgl/renderer/style_diff.hpp
     src/mbgl/renderer/tile_mask.hpp
@@ -378,6 +381,8 @@ set(MBGL_CORE_FILES
     src/mbgl/style/custom_tile_loader.hpp
     src/mbgl/style/filter.cpp
     src/mbgl/style/filter_evaluator.cpp
+    src/mbgl/style/geojson_loader.cpp
+    src/mbgl/style/geojson_loader.hpp
     src/mbgl/style/image.cpp
     src/mbgl/style/image_impl.cpp
     src/mbgl/style/image_impl.hpp
@@ -674,6 +679,7 @@ set(MBGL_CORE_FILES
     include/mbgl/util/geometry.hpp
     include/mbgl/util/ignore.hpp
     include/mbgl/util/image.hpp
+    include/mbgl/util/image_buffer_pool.hpp
     include/mbgl/util/immutable.hpp
     include/mbgl/util/indexed_tuple.hpp
     include/mbgl/util/interpolate.hpp
@@ -681,6 +687,7 @@ set(MBGL_CORE_FILES
     include/mbgl/util/noncopyable.hpp
     include/mbgl/util/optional.hpp
     include/mbgl/util/platform.hpp
+    include/mbgl/util/png_encoder.hpp
     include/mbgl/util/premultiply.hpp
     include/mbgl/util/projection.hpp
     include/mbgl/util/range.hpp
@@ -704,6 +711,8 @@ set(MBGL_CORE_FILES
     src/mbgl/util/clip_id.cpp
     src/mbgl/util/clip_id.hpp
     src/mbgl/util/color.cpp
+    src/mbgl/util/compressed_image.cpp
+    src/mbgl/util/compressed_image.hpp
     src/mbgl/util/compression.cpp
     src/mbgl/util/constants.cpp
     src/mbgl/util/convert.cpp
@@ -721,6 +730,7 @@ set(MBGL_CORE_FILES
     src/mbgl/util/http_timeout.hpp
     src/mbgl/util/i18n.cpp
     src/mbgl/util/i18n.hpp
+    src/mbgl/util/image_buffer_pool.cpp
     src/mbgl/util/interpolate.cpp
     src/mbgl/util/intersection_tests.cpp
     src/mbgl/util/intersection_tests.hpp
@@ -737,8 +747,15 @@ set(MBGL_CORE_FILES
     src/mbgl/util/mat4.cpp
     src/mbgl/util/mat4.hpp
     src/mbgl/util/math.hpp
+    src/mbgl/util/mipmap.cpp
+    src/mbgl/util/mipmap.hpp
     src/mbgl/util/offscreen_texture.cpp
     src/mbgl/util/offscreen_texture.hpp
+    src/mbgl/util/parallel.cpp
+    src/mbgl/util/parallel.hpp
+    src/mbgl/util/pixel_kernels.cpp
+    src/mbgl/util/pixel_kernels.hpp
+    src/mbgl/util/png_encoder.cpp
     src/mbgl/util/premultiply.cpp
     src/mbgl/util/rapidjson.hpp
     src/mbgl/util/rect.hpp
@@ -17,6 +17,7 @@ set(MBGL_TEST_FILES
     test/api/api_misuse.test.cpp
     test/api/custom_geometry_source.test.cpp
     test/api/custom_layer.test.cpp
+    test/api/metatile.test.cpp
     test/api/query.test.cpp
     test/api/recycle_map.cpp
     test/api/zoom_history.cpp
@@ -31,6 +32,7 @@ set(MBGL_TEST_FILES
 
     # map
     test/map/map.test.cpp
+    test/map/map_render_pool.test.cpp
     test/map/prefetch.test.cpp
     test/map/transform.test.cpp
 
@@ -47,6 +49,7 @@ set(MBGL_TEST_FILES
     test/renderer/backend_scope.test.cpp
     test/renderer/group_by_layout.test.cpp
     test/renderer/image_manager.test.cpp
+    test/renderer/style_diff.test.cpp
 
     # sprite
     test/sprite/sprite_loader.test.cpp
@@ -131,16 +134,23 @@ set(MBGL_TEST_FILES
 
     # util
     test/util/async_task.test.cpp
+    test/util/compressed_image.test.cpp
+    test/util/compression.test.cpp
     test/util/dtoa.test.cpp
     test/util/geo.test.cpp
     test/util/grid_index.test.cpp
     test/util/http_timeout.test.cpp
     test/util/image.test.cpp
+    test/util/image_buffer_pool.test.cpp
     test/util/mapbox.test.cpp
     test/util/memory.test.cpp
     test/util/merge_lines.test.cpp
+    test/util/mipmap.test.cpp
     test/util/number_conversions.test.cpp
     test/util/offscreen_texture.test.cpp
+    test/util/parallel.test.cpp
+    test/util/pixel_kernels.test.cpp
+    test/util/png_encoder.test.cpp
     test/util/position.test.cpp
     test/util/projection.test.cpp
     test/util/run_loop.test.cpp
@@ -3,6 +3,7 @@
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/mode.hpp>
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/geo.hpp>
 
@@ -44,12 +45,48 @@ public:
     AnnotationIDs queryShapeAnnotations(const ScreenBox& box) const;
     AnnotationIDs getAnnotationIDs(const std::vector<Feature>&) const;
 
+    // Feature state. Properties of `state` are merged into the feature's existing state, which
+    // paint properties can read with ["feature-state", key]. Omit the source layer for GeoJSON
+    // sources. Only the paint attributes of the affected features are updated.
+    void setFeatureState(const std::string& sourceID, const optional<std::string>& sourceLayerID,
+                         const std::string& featureID, const FeatureState& state);
+    void getFeatureState(FeatureState& state, const std::string& sourceID, const optional<std::string>& sourceLayerID,
+                         const std::string& featureID) const;
+
     // Debug
     void dumpDebugLogs();
 
     // Memory
     void reduceMemoryUse();
 
+    // Encodes the textures of raster tiles loaded from now on in a block compressed format that
+    // takes an eighth of the memory, where the GPU supports BC1 or ETC. Compression is lossy, and
+    // tiles with translucent pixels remain uncompressed.
+    void setRasterTextureCompression(bool);
+
+    // The texture memory of the raster tiles drawn in the last frame.
+    std::size_t getRasterTextureBytes() const;
+
+    // Computes the slopes of raster-dem tiles loaded from now on for hillshade layers on worker
+    // threads, instead of in a render pass. This is faster where the GPU is emulated, as in
+    // headless rendering with OSMesa.
+    void setHillshadePrepareOnWorkers(bool);
+
+    // Uploads the vertex attributes of data-driven paint properties of tiles loaded from now on in
+    // the narrowest integer type that holds all of their values exactly, rather than as floats.
+    // Colors take half the memory. The values the shaders read are unchanged.
+    void setCompactVertexAttributes(bool);
+
+    // Clips the tiles of vector, GeoJSON and custom sources to the parts not covered by other
+    // tiles with scissor rectangles, instead of drawing clipping masks into the stencil buffer.
+    // Falls back to the stencil buffer while the map is rotated or pitched.
+    void setTileMaskClipping(bool);
+
+    // Tessellates the polygons of fill and fill extrusion layers of tiles loaded from now on on
+    // several worker threads at once, so that a tile with many polygons loads faster when other
+    // workers are idle.
+    void setParallelTessellation(bool);
+
 private:
     class Impl;
     std::unique_ptr<Impl> impl;
@@ -3,6 +3,7 @@
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/offline.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/optional.hpp>
 
@@ -123,6 +124,15 @@ public:
      */
     void setOfflineMapboxTileCountLimit(uint64_t) const;
 
+    /*
+     * Set the codec resources and tiles are compressed with when they are written to the
+     * database. Defaults to zlib. LZ4 takes more space, but decompresses several times
+     * faster, which is paid on every request served from the database. Existing data
+     * remains readable whichever codec is set. Once data is stored with LZ4, earlier SDK
+     * versions that open the database discard it.
+     */
+    void setOfflineCompressionCodec(util::CompressionCodec) const;
+
     /*
      * Pause file request activity.
      *
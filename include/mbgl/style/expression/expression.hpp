@@ -33,10 +33,14 @@ public:
     EvaluationContext(optional<float> zoom_, GeometryTileFeature const * feature_, optional<double> heatmapDensity_) :
         zoom(std::move(zoom_)), feature(feature_), heatmapDensity(std::move(heatmapDensity_))
     {}
+    EvaluationContext(optional<float> zoom_, GeometryTileFeature const * feature_, FeatureState const * featureState_) :
+        zoom(std::move(zoom_)), feature(feature_), featureState(featureState_)
+    {}
     
     optional<float> zoom;
     GeometryTileFeature const * feature;
     optional<double> heatmapDensity;
+    FeatureState const * featureState = nullptr;
 };
 
 template <typename T>
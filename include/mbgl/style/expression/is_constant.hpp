@@ -28,6 +28,7 @@ bool isGlobalPropertyConstant(const Expression& expression, const T& properties)
 
 bool isFeatureConstant(const Expression& expression);
 bool isZoomConstant(const Expression& e);
+bool isFeatureStateConstant(const Expression& e);
 
 
 } // namespace expression
@@ -77,14 +77,22 @@ public:
         };
     }
 
+    template <class Feature>
+    Range<T> evaluate(const Range<float>& zoomRange, const Feature& feature, const FeatureState& state, T finalDefaultValue) const {
+        return Range<T> {
+            evaluate(zoomRange.min, feature, state, finalDefaultValue),
+            evaluate(zoomRange.max, feature, state, finalDefaultValue)
+        };
+    }
+
     template <class Feature>
     T evaluate(float zoom, const Feature& feature, T finalDefaultValue) const {
-        const expression::EvaluationResult result = expression->evaluate(expression::EvaluationContext({zoom}, &feature));
-        if (result) {
-            const optional<T> typed = expression::fromExpressionValue<T>(*result);
-            return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
-        }
-        return defaultValue ? *defaultValue : finalDefaultValue;
+        return evaluated(expression->evaluate(expression::EvaluationContext({zoom}, &feature)), finalDefaultValue);
+    }
+
+    template <class Feature>
+    T evaluate(float zoom, const Feature& feature, const FeatureState& state, T finalDefaultValue) const {
+        return evaluated(expression->evaluate(expression::EvaluationContext({zoom}, &feature, &state)), finalDefaultValue);
     }
     
     float interpolationFactor(const Range<float>& inputLevels, const float inputValue) const {
@@ -119,6 +127,14 @@ public:
     bool useIntegerZoom = false;
     
 private:
+    T evaluated(const expression::EvaluationResult& result, T finalDefaultValue) const {
+        if (result) {
+            const optional<T> typed = expression::fromExpressionValue<T>(*result);
+            return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
+        }
+        return defaultValue ? *defaultValue : finalDefaultValue;
+    }
+
     std::shared_ptr<expression::Expression> expression;
     const variant<const expression::InterpolateBase*, const expression::Step*> zoomCurve;
 };
@@ -49,12 +49,12 @@ public:
 
     template <class Feature>
     T evaluate(const Feature& feature, T finalDefaultValue) const {
-        const expression::EvaluationResult result = expression->evaluate(expression::EvaluationContext(&feature));
-        if (result) {
-            const optional<T> typed = expression::fromExpressionValue<T>(*result);
-            return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
-        }
-        return defaultValue ? *defaultValue : finalDefaultValue;
+        return evaluated(expression->evaluate(expression::EvaluationContext(&feature)), finalDefaultValue);
+    }
+
+    template <class Feature>
+    T evaluate(const Feature& feature, const FeatureState& state, T finalDefaultValue) const {
+        return evaluated(expression->evaluate(expression::EvaluationContext({}, &feature, &state)), finalDefaultValue);
     }
 
     std::vector<optional<T>> possibleOutputs() const {
@@ -76,6 +76,14 @@ public:
     optional<T> defaultValue;
 
 private:
+    T evaluated(const expression::EvaluationResult& result, T finalDefaultValue) const {
+        if (result) {
+            const optional<T> typed = expression::fromExpressionValue<T>(*result);
+            return typed ? *typed : defaultValue ? *defaultValue : finalDefaultValue;
+        }
+        return defaultValue ? *defaultValue : finalDefaultValue;
+    }
+
     std::shared_ptr<expression::Expression> expression;
 };
 
@@ -2,15 +2,25 @@
 
 #include <mbgl/style/source.hpp>
 #include <mbgl/util/geojson.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <vector>
+
 namespace mbgl {
 
 class AsyncRequest;
+class Mailbox;
+class ThreadPool;
+template <class T>
+class Actor;
 
 namespace style {
 
+class GeoJSONData;
+class GeoJSONLoader;
+
 struct GeoJSONOptions {
     // GeoJSON-VT options
     uint8_t minzoom = 0;
@@ -25,14 +35,29 @@ struct GeoJSONOptions {
     uint8_t clusterMaxZoom = 17;
 };
 
+// Incremental changes to the features of a GeoJSON source. Features are matched by their ID;
+// features without an ID can't be changed individually and are ignored.
+struct GeoJSONDiff {
+    // New features, or replacements for existing features with the same ID.
+    FeatureCollection add;
+    std::vector<FeatureIdentifier> remove;
+};
+
 class GeoJSONSource : public Source {
 public:
     GeoJSONSource(const std::string& id, const GeoJSONOptions& = {});
     ~GeoJSONSource() final;
 
     void setURL(const std::string& url);
+
+    // Data is indexed on a background thread; the source is loaded once indexing completes.
     void setGeoJSON(const GeoJSON&);
 
+    // Applies changes to the data set with setGeoJSON. Only the changed features are tiled
+    // again, and only the tiles they touch are reloaded. Without prior data, the added features
+    // become the data set.
+    void updateGeoJSON(const GeoJSONDiff&);
+
     optional<std::string> getURL() const;
 
     class Impl;
@@ -41,8 +66,21 @@ public:
     void loadDescription(FileSource&) final;
 
 private:
+    friend class GeoJSONLoader;
+
+    Actor<GeoJSONLoader>* getLoader();
+    void onLoad(std::shared_ptr<GeoJSONData>, uint64_t correlationID);
+
     optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
+
+    std::shared_ptr<ThreadPool> threadPool;
+    std::shared_ptr<Mailbox> mailbox;
+    std::unique_ptr<Actor<GeoJSONLoader>> loader;
+
+    // Requests sent to the loader, and the last one whose data has been received.
+    uint64_t correlationID = 0;
+    uint64_t loadedCorrelationID = 0;
 };
 
 template <>
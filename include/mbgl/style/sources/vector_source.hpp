@@ -18,6 +18,15 @@ public:
     const variant<std::string, Tileset>& getURLOrTileset() const;
     optional<std::string> getURL() const;
 
+    // Simplifies the lines and polygons of the source's line and fill layers on the tile workers,
+    // dropping the vertices that are within this many physical pixels of the simplified
+    // geometry at the zoom level the tile is laid out for. 0, the default, disables it.
+    // Each tile is simplified on its own, so a line that crosses a tile boundary can jog by up
+    // to twice the tolerance at the seam, and polygons that share a border can leave gaps or
+    // overlap along it. Feature queries still use the original geometries.
+    void setSimplificationTolerance(float pixels);
+    float getSimplificationTolerance() const;
+
     class Impl;
     const Impl& impl() const;
 
@@ -1,12 +1,43 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace mbgl {
 namespace util {
 
-std::string compress(const std::string& raw);
+// Compresses with zlib at the given level from 0 to 9, or -1 for zlib's default, and
+// decompresses zlib or gzip streams.
+std::string compress(const std::string& raw, int level = -1);
 std::string decompress(const std::string& raw);
 
+// Whether `raw` starts with a zlib or gzip header. Tiles compressed by the server or by the
+// offline database do, but none of the tile formats do when uncompressed.
+bool isCompressed(const std::string& raw);
+
+// Tile data as the tile workers parse it. Tiles may still be compressed the way the server or the
+// offline database stored them, and are inflated on the worker thread that parses them rather
+// than by the file source. Returns `data` itself if it isn't compressed.
+std::shared_ptr<const std::string> inflateIfCompressed(std::shared_ptr<const std::string> data);
+
+// Codecs the offline database can store data with. The values are stored in its `compressed`
+// column, so they must never change.
+enum class CompressionCodec : uint8_t {
+    None = 0,
+    // Decompresses gzip streams too, which servers compress tiles with.
+    Zlib = 1,
+    // The LZ4 block format, prefixed with the uncompressed size as a 32 bit little endian
+    // integer. The prefix isn't part of the block format, so the data can't be passed to
+    // LZ4_decompress_safe() or read as an LZ4 frame as it is. It compresses less than zlib,
+    // but decompresses several times faster.
+    LZ4 = 2,
+};
+
+// Compresses and decompresses with the given codec. Throws std::runtime_error when the data
+// is corrupt or the codec is unknown.
+std::string compress(const std::string& raw, CompressionCodec);
+std::string decompress(const std::string& raw, CompressionCodec);
+
 } // namespace util
 } // namespace mbgl
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <mbgl/util/optional.hpp>
+#include <mbgl/util/string.hpp>
 
 #include <mapbox/geometry/feature.hpp>
 
+#include <string>
+#include <unordered_map>
+
 namespace mbgl {
 
 using Value = mapbox::geometry::value;
@@ -12,6 +16,22 @@ using PropertyMap = mapbox::geometry::property_map;
 using FeatureIdentifier = mapbox::geometry::identifier;
 using Feature = mapbox::geometry::feature<double>;
 
+// Mutable per-feature state that can be read by paint property expressions through
+// ["feature-state", key]. States are keyed by feature ID and grouped by source layer.
+using FeatureState = PropertyMap;
+using FeatureStates = std::unordered_map<std::string, FeatureState>;
+using LayerFeatureStates = std::unordered_map<std::string, FeatureStates>;
+
+inline std::string featureIDtoString(const FeatureIdentifier& id) {
+    return id.match(
+        [] (const std::string& value) {
+            return value;
+        },
+        [] (const auto& value) {
+            return util::toString(value);
+        });
+}
+
 template <class T>
 optional<T> numericValue(const Value& value) {
     return value.match(
@@ -3,6 +3,7 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/size.hpp>
+#include <mbgl/util/image_buffer_pool.hpp>
 
 #include <string>
 #include <cstring>
@@ -24,18 +25,28 @@ public:
 
     Image(Size size_)
         : size(std::move(size_)),
-          data(std::make_unique<uint8_t[]>(bytes())) {}
+          data(new uint8_t[bytes()]()) {}
+
+    // Draws the buffer from `pool`, and returns it there when destroyed. The buffer isn't
+    // initialized.
+    Image(Size size_, util::ImageBufferPool& pool)
+        : size(std::move(size_)),
+          data(pool.acquire(bytes())) {}
 
     Image(Size size_, const uint8_t* srcData, std::size_t srcLength)
         : size(std::move(size_)) {
         if (srcLength != bytes()) {
             throw std::invalid_argument("mismatched image size");
         }
-        data = std::make_unique<uint8_t[]>(bytes());
+        data.reset(new uint8_t[bytes()]);
         std::copy(srcData, srcData + srcLength, data.get());
     }
 
     Image(Size size_, std::unique_ptr<uint8_t[]> data_)
+        : size(std::move(size_)),
+          data(data_.release()) {}
+
+    Image(Size size_, util::ImageBuffer data_)
         : size(std::move(size_)),
           data(std::move(data_)) {}
 
@@ -163,15 +174,33 @@ public:
 
     Size size;
     static constexpr size_t channels = Mode == ImageAlphaMode::Exclusive ? 1 : 4;
-    std::unique_ptr<uint8_t[]> data;
+    util::ImageBuffer data;
 };
 
 using UnassociatedImage = Image<ImageAlphaMode::Unassociated>;
 using PremultipliedImage = Image<ImageAlphaMode::Premultiplied>;
 using AlphaImage = Image<ImageAlphaMode::Exclusive>;
 
+// Options of encodePNG. The defaults favor encoding speed over size.
+struct PNGEncodeOptions {
+    // The filters that predict each row before it is compressed. Adaptive chooses the filter of
+    // each row that leaves the smallest sum of absolute differences, like libpng does.
+    enum class Filter : uint8_t { None, Sub, Up, Average, Paeth, Adaptive };
+
+    // Whether to encode images as indexed color, which is only done when the image has at most
+    // 256 colors with Exact, so that it is lossless. Quantize reduces the colors of the other
+    // images with median cut. Indexed rows are never filtered.
+    enum class Palette : uint8_t { None, Exact, Quantize };
+
+    // The zlib compression level from 0 to 9, or -1 for zlib's default.
+    int compressionLevel = -1;
+    Filter filter = Filter::None;
+    Palette palette = Palette::None;
+};
+
 // TODO: don't use std::string for binary data.
 PremultipliedImage decodeImage(const std::string&);
 std::string encodePNG(const PremultipliedImage&);
+std::string encodePNG(const PremultipliedImage&, const PNGEncodeOptions&);
 
 } // namespace mbgl
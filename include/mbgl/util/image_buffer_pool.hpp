@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace mbgl {
+namespace util {
+
+class ImageBufferPool;
+
+// Frees an image buffer, or returns it to the pool it was drawn from.
+class ImageBufferDeleter {
+public:
+    ImageBufferDeleter() = default;
+    ImageBufferDeleter(ImageBufferPool& pool_, std::size_t capacity_)
+        : pool(&pool_), capacity(capacity_) {}
+
+    void operator()(uint8_t*) const;
+
+private:
+    ImageBufferPool* pool = nullptr;
+    std::size_t capacity = 0;
+};
+
+using ImageBuffer = std::unique_ptr<uint8_t[], ImageBufferDeleter>;
+
+// A thread safe pool of image buffers, grouped in size classes at most 25% apart, so that images
+// of similar size can reuse each other's buffers. Buffers return to the pool when the image they
+// belong to is destroyed. The pool must outlive all buffers drawn from it.
+class ImageBufferPool : private util::noncopyable {
+public:
+    struct Stats {
+        // Buffers drawn from the pool, and how many of those reused a returned buffer.
+        uint64_t acquired = 0;
+        uint64_t reused = 0;
+
+        // Bytes of buffers owned by images, and of returned buffers kept for reuse.
+        std::size_t bytesInUse = 0;
+        std::size_t bytesRetained = 0;
+
+        // The most bytes in use and retained at the same time.
+        std::size_t peakBytes = 0;
+
+        double reuseRate() const {
+            return acquired ? double(reused) / acquired : 0;
+        }
+    };
+
+    // Buffers smaller than this are left to the allocator.
+    static constexpr std::size_t minPooledBytes = 16 * 1024;
+
+    explicit ImageBufferPool(std::size_t maxRetainedBytes = 32 * 1024 * 1024);
+    ~ImageBufferPool();
+
+    // The pool used by the image decoders, DEM tiles and framebuffer readback.
+    static ImageBufferPool& getDefault();
+
+    // Returns an uninitialized buffer of at least `bytes` bytes.
+    ImageBuffer acquire(std::size_t bytes);
+
+    // Returned buffers beyond this many bytes are freed instead of kept for reuse.
+    void setMaxRetainedBytes(std::size_t);
+
+    // Frees all buffers kept for reuse.
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    friend class ImageBufferDeleter;
+    void release(uint8_t*, std::size_t capacity);
+
+    class Impl;
+    const std::unique_ptr<Impl> impl;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class Scheduler;
+template <class> class Actor;
+
+// Unpremultiplies and encodes images as PNGs on the workers of a scheduler, so that the thread
+// that rendered them can start rendering the next image right away. Up to `concurrency` images
+// are encoded at a time, each of them on a single worker.
+class PNGEncoder : private util::noncopyable {
+public:
+    // Called on the worker that encoded the image, with the PNG or the error encoding threw.
+    using Callback = std::function<void (std::exception_ptr, std::string)>;
+
+    PNGEncoder(Scheduler&, std::size_t concurrency, PNGEncodeOptions = {});
+
+    // Waits for the images being encoded, and drops the ones that haven't started.
+    ~PNGEncoder();
+
+    void encode(PremultipliedImage, Callback);
+
+private:
+    class Worker;
+
+    std::vector<std::unique_ptr<Actor<Worker>>> workers;
+    std::atomic<std::size_t> next { 0 };
+};
+
+} // namespace mbgl
@@ -14,16 +14,18 @@ using CGContextHandle = CFHandle<CGContextRef, CGContextRef, CGContextRelease>;
 CGImageRef CGImageCreateWithMGLPremultipliedImage(mbgl::PremultipliedImage&& src) {
     // We're converting the PremultipliedImage's backing store to a CGDataProvider, and are taking
     // over ownership of the memory.
+    // The buffer is released through its deleter, which may return it to the image buffer pool.
+    auto data = std::make_unique<decltype(src.data)>(std::move(src.data));
     CGDataProviderHandle provider(CGDataProviderCreateWithData(
-        NULL, src.data.get(), src.bytes(), [](void*, const void* data, size_t) {
-            delete[] reinterpret_cast<const decltype(src.data)::element_type*>(data);
+        data.get(), data->get(), src.bytes(), [](void* info, const void*, size_t) {
+            delete reinterpret_cast<decltype(src.data)*>(info);
         }));
     if (!provider) {
         return nil;
     }
 
     // If we successfully created the provider, it will take over management of the memory segment.
-    src.data.release();
+    data.release();
 
     CGColorSpaceHandle colorSpace(CGColorSpaceCreateDeviceRGB());
     if (!colorSpace) {
@@ -167,6 +167,10 @@ public:
         offlineDatabase->setOfflineMapboxTileCountLimit(limit);
     }
 
+    void setOfflineCompressionCodec(util::CompressionCodec codec) {
+        offlineDatabase->setCompressionCodec(codec);
+    }
+
     void setOnlineStatus(const bool status) {
         onlineFileSource.setOnlineStatus(status);
     }
@@ -287,6 +291,10 @@ void DefaultFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
     impl->actor().invoke(&Impl::setOfflineMapboxTileCountLimit, limit);
 }
 
+void DefaultFileSource::setOfflineCompressionCodec(util::CompressionCodec codec) const {
+    impl->actor().invoke(&Impl::setOfflineCompressionCodec, codec);
+}
+
 void DefaultFileSource::pause() {
     impl->pause();
 }
@@ -253,10 +253,17 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl* context_, Resource resource_, Fil
     handleError(curl_easy_setopt(handle, CURLOPT_WRITEDATA, this));
     handleError(curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, headerCallback));
     handleError(curl_easy_setopt(handle, CURLOPT_HEADERDATA, this));
+
+    // Tiles are passed on gzipped, the way the server sent them. The offline database stores them
+    // as they are, and the tile workers inflate them when they parse them. Only gzip is accepted
+    // for them, since servers send raw deflate streams as "deflate" too.
+    const bool tile = resource.kind == Resource::Kind::Tile;
+    const char* encoding = tile ? "gzip" : "gzip, deflate";
+    handleError(curl_easy_setopt(handle, CURLOPT_HTTP_CONTENT_DECODING, tile ? 0L : 1L));
 #if LIBCURL_VERSION_NUM >= ((7) << 16 | (21) << 8 | 6) // Renamed in 7.21.6
-    handleError(curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "gzip, deflate"));
+    handleError(curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, encoding));
 #else
-    handleError(curl_easy_setopt(handle, CURLOPT_ENCODING, "gzip, deflate"));
+    handleError(curl_easy_setopt(handle, CURLOPT_ENCODING, encoding));
 #endif
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapboxGL/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
@@ -1,9 +1,6 @@
 #include <mbgl/util/image.hpp>
-#include <mbgl/util/char_array_buffer.hpp>
 
-#include <istream>
-#include <sstream>
-#include <array>
+#include <cstring>
 
 extern "C"
 {
@@ -12,62 +9,51 @@ extern "C"
 
 namespace mbgl {
 
-const static unsigned BUF_SIZE = 4096;
-
-struct jpeg_stream_wrapper {
+// Reads straight from the encoded data, without copying it into a stream first.
+struct jpeg_memory_source {
     jpeg_source_mgr manager;
-    std::istream* stream;
-    std::array<JOCTET, BUF_SIZE> buffer;
+    const JOCTET* data;
+    size_t size;
 };
 
-static void init_source(j_decompress_ptr cinfo) {
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-    wrap->stream->seekg(0, std::ios_base::beg);
-}
+static void init_source(j_decompress_ptr) {}
 
 static boolean fill_input_buffer(j_decompress_ptr cinfo) {
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-    wrap->stream->read(reinterpret_cast<char*>(&wrap->buffer[0]), BUF_SIZE);
-    std::streamsize size = wrap->stream->gcount();
-    wrap->manager.next_input_byte = wrap->buffer.data();
-    wrap->manager.bytes_in_buffer = BUF_SIZE;
-    return (size > 0) ? TRUE : FALSE;
+    // All data is available up front, so running out of it means the image is truncated. Insert
+    // an end of image marker, like libjpeg's own memory source, to end decoding gracefully.
+    static const JOCTET eoi[2] = { 0xFF, JPEG_EOI };
+    cinfo->src->next_input_byte = eoi;
+    cinfo->src->bytes_in_buffer = 2;
+    return TRUE;
 }
 
 static void skip(j_decompress_ptr cinfo, long count) {
     if (count <= 0) return; // A zero or negative skip count should be treated as a no-op.
-    auto* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-
-    if (wrap->manager.bytes_in_buffer > 0 && count < static_cast<long>(wrap->manager.bytes_in_buffer))
-    {
-        wrap->manager.bytes_in_buffer -= count;
-        wrap->manager.next_input_byte = &wrap->buffer[BUF_SIZE - wrap->manager.bytes_in_buffer];
-    }
-    else
-    {
-        wrap->stream->seekg(count - wrap->manager.bytes_in_buffer, std::ios_base::cur);
-        // trigger buffer fill
-        wrap->manager.next_input_byte = nullptr;
-        wrap->manager.bytes_in_buffer = 0; // bytes_in_buffer may be zero on return.
+    if (static_cast<size_t>(count) > cinfo->src->bytes_in_buffer) {
+        fill_input_buffer(cinfo);
+    } else {
+        cinfo->src->next_input_byte += count;
+        cinfo->src->bytes_in_buffer -= count;
     }
 }
 
 static void term(j_decompress_ptr) {}
 
-static void attach_stream(j_decompress_ptr cinfo, std::istream* in) {
+static void attach_source(j_decompress_ptr cinfo, const uint8_t* data, size_t size) {
     if (cinfo->src == nullptr) {
         cinfo->src = (struct jpeg_source_mgr *)
-            (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo, JPOOL_PERMANENT, sizeof(jpeg_stream_wrapper));
+            (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo, JPOOL_PERMANENT, sizeof(jpeg_memory_source));
     }
-    auto * src = reinterpret_cast<jpeg_stream_wrapper*> (cinfo->src);
+    auto * src = reinterpret_cast<jpeg_memory_source*> (cinfo->src);
     src->manager.init_source = init_source;
     src->manager.fill_input_buffer = fill_input_buffer;
     src->manager.skip_input_data = skip;
     src->manager.resync_to_restart = jpeg_resync_to_restart;
     src->manager.term_source = term;
-    src->manager.bytes_in_buffer = 0;
-    src->manager.next_input_byte = nullptr;
-    src->stream = in;
+    src->manager.bytes_in_buffer = size;
+    src->manager.next_input_byte = reinterpret_cast<const JOCTET*>(data);
+    src->data = reinterpret_cast<const JOCTET*>(data);
+    src->size = size;
 }
 
 static void on_error(j_common_ptr) {}
@@ -90,9 +76,6 @@ struct jpeg_info_guard {
 };
 
 PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
-    util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
-    std::istream stream(&dataBuffer);
-
     jpeg_decompress_struct cinfo;
     jpeg_info_guard iguard(&cinfo);
     jpeg_error_mgr jerr;
@@ -100,12 +83,21 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     jerr.error_exit = on_error;
     jerr.output_message = on_error_message;
     jpeg_create_decompress(&cinfo);
-    attach_stream(&cinfo, &stream);
+    attach_source(&cinfo, data, size);
 
     int ret = jpeg_read_header(&cinfo, TRUE);
     if (ret != JPEG_HEADER_OK)
         throw std::runtime_error("JPEG Reader: failed to read header");
 
+    bool rgba = false;
+#if defined(JCS_ALPHA_EXTENSIONS)
+    // libjpeg-turbo can write opaque RGBA directly.
+    if (cinfo.out_color_space == JCS_RGB) {
+        cinfo.out_color_space = JCS_EXT_RGBA;
+        rgba = true;
+    }
+#endif
+
     jpeg_start_decompress(&cinfo);
 
     if (cinfo.out_color_space == JCS_UNKNOWN)
@@ -117,29 +109,41 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     size_t width = cinfo.output_width;
     size_t height = cinfo.output_height;
     size_t components = cinfo.output_components;
-    size_t rowStride = components * width;
-
-    PremultipliedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
-    uint8_t* dst = image.data.get();
 
-    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr) &cinfo, JPOOL_IMAGE, rowStride, 1);
+    // JPEG images are opaque, so they are premultiplied as they are. Every pixel is written by the
+    // decoder, so the buffer doesn't need to be initialized.
+    const Size imageSize { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+    PremultipliedImage image(imageSize, util::ImageBufferPool::getDefault());
 
     while (cinfo.output_scanline < cinfo.output_height) {
-        jpeg_read_scanlines(&cinfo, buffer, 1);
+        // Scanlines are decoded into the start of their row of the image, and expanded to RGBA
+        // in place from the end of the row, so that no pixel is overwritten before it's read.
+        uint8_t* row = image.data.get() + cinfo.output_scanline * width * 4;
+        JSAMPROW rows[1] = { row };
+        jpeg_read_scanlines(&cinfo, rows, 1);
+
+        if (rgba) {
+            continue;
+        }
 
-        for (size_t i = 0; i < width; ++i) {
-            dst[0] = buffer[0][components * i];
-            dst[3] = 0xFF;
+        for (size_t i = width; i-- > 0;) {
+            uint8_t* dst = row + 4 * i;
+            const uint8_t* src = row + components * i;
 
             if (components > 2) {
-                dst[1] = buffer[0][components * i + 1];
-                dst[2] = buffer[0][components * i + 2];
+                const uint8_t r = src[0];
+                const uint8_t g = src[1];
+                const uint8_t b = src[2];
+                dst[0] = r;
+                dst[1] = g;
+                dst[2] = b;
             } else {
-                dst[1] = dst[0];
-                dst[2] = dst[0];
+                const uint8_t v = src[0];
+                dst[0] = v;
+                dst[1] = v;
+                dst[2] = v;
             }
-
-            dst += 4;
+            dst[3] = 0xFF;
         }
     }
 
@@ -19,6 +19,7 @@ public:
     gl::Renderbuffer<gl::RenderbufferType::RGBA> color;
     gl::Renderbuffer<gl::RenderbufferType::DepthStencil> depthStencil;
     gl::Framebuffer framebuffer;
+    optional<gl::UniqueBuffer> pixelBuffer;
 };
 
 HeadlessBackend::HeadlessBackend(Size size_)
@@ -27,7 +28,9 @@ HeadlessBackend::HeadlessBackend(Size size_)
 
 HeadlessBackend::~HeadlessBackend() {
     BackendScope guard { *this };
-    view.reset();
+    for (auto& view : views) {
+        view.reset();
+    }
     context.reset();
 }
 
@@ -56,6 +59,7 @@ void HeadlessBackend::deactivate() {
 void HeadlessBackend::bind() {
     gl::Context& context_ = getContext();
 
+    auto& view = views[current];
     if (!view) {
         view = std::make_unique<View>(context_, size);
     }
@@ -75,11 +79,50 @@ void HeadlessBackend::updateAssumedState() {
 
 void HeadlessBackend::setSize(Size size_) {
     size = size_;
-    view.reset();
+    for (auto& view : views) {
+        view.reset();
+    }
+    reading = false;
+    stillImage = {};
 }
 
 PremultipliedImage HeadlessBackend::readStillImage() {
     return getContext().readFramebuffer<PremultipliedImage>(size);
 }
 
+void HeadlessBackend::startStillImageRead() {
+    assert(!reading);
+    gl::Context& context_ = getContext();
+    reading = true;
+
+    if (!context_.supportsPixelBuffers()) {
+        stillImage = context_.readFramebuffer<PremultipliedImage>(size);
+        return;
+    }
+
+    View& view = *views[current];
+    if (!view.pixelBuffer) {
+        view.pixelBuffer = context_.createPixelBuffer(size);
+    }
+
+    context_.bindFramebuffer = view.framebuffer.framebuffer;
+    context_.readFramebufferAsync(size, view.pixelBuffer->get());
+    current = 1 - current;
+}
+
+PremultipliedImage HeadlessBackend::finishStillImageRead() {
+    if (!reading) {
+        return {};
+    }
+
+    reading = false;
+    gl::Context& context_ = getContext();
+    if (!context_.supportsPixelBuffers()) {
+        return std::move(stillImage);
+    }
+
+    // The image was rendered into the other framebuffer.
+    return context_.readPixelBuffer<PremultipliedImage>(views[1 - current]->pixelBuffer->get(), size);
+}
+
 } // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <mbgl/renderer/renderer_backend.hpp>
 
+#include <array>
 #include <memory>
 #include <functional>
 
@@ -16,9 +17,17 @@ public:
     Size getFramebufferSize() const override;
     void updateAssumedState() override;
 
+    // Changing the size drops an image that is being read.
     void setSize(Size);
     PremultipliedImage readStillImage();
 
+    // Reads the image that was just rendered asynchronously: starts copying it into a pixel
+    // buffer, and switches to the second of two framebuffers, so that the next image renders
+    // while the copy is in progress. finishStillImageRead() returns the image, or an empty one
+    // when none is being read. Without pixel buffers, the image is read right away.
+    void startStillImageRead();
+    PremultipliedImage finishStillImageRead();
+
     class Impl {
     public:
         virtual ~Impl() = default;
@@ -44,7 +53,11 @@ private:
     bool active = false;
 
     class View;
-    std::unique_ptr<View> view;
+    std::array<std::unique_ptr<View>, 2> views;
+    std::size_t current = 0;
+
+    bool reading = false;
+    PremultipliedImage stillImage;
 };
 
 } // namespace mbgl
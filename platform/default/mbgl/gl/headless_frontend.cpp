@@ -1,10 +1,17 @@
 #include <mbgl/gl/headless_frontend.hpp>
 #include <mbgl/renderer/renderer.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
+#include <mbgl/renderer/backend_scope.hpp>
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/constants.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
 namespace mbgl {
 
 HeadlessFrontend::HeadlessFrontend(float pixelRatio_, FileSource& fileSource, Scheduler& scheduler, const optional<std::string> programCacheDir, GLContextMode mode, const optional<std::string> localFontFamily)
@@ -85,6 +92,71 @@ PremultipliedImage HeadlessFrontend::render(Map& map) {
     return result;
 }
 
+PremultipliedImage HeadlessFrontend::renderPipelined(Map& map) {
+    PremultipliedImage result;
+    bool rendered = false;
+
+    map.renderStill([&](std::exception_ptr error) {
+        if (error) {
+            std::rethrow_exception(error);
+        } else {
+            // The previous image was copied while this one rendered.
+            result = backend.finishStillImageRead();
+            backend.startStillImageRead();
+            rendered = true;
+        }
+    });
+
+    while (!rendered) {
+        util::RunLoop::Get()->runOnce();
+    }
+
+    return result;
+}
+
+PremultipliedImage HeadlessFrontend::finishRender() {
+    mbgl::BackendScope guard { backend };
+    return backend.finishStillImageRead();
+}
+
+std::vector<PremultipliedImage> HeadlessFrontend::renderMetatile(Map& map, const CanonicalTileID& id, uint32_t count, uint32_t tileSize) {
+    if (count == 0 || tileSize == 0) {
+        throw std::invalid_argument("metatile must have at least one tile of at least one pixel");
+    }
+    const uint64_t worldTiles = uint64_t(1) << id.z;
+    if (id.x + uint64_t(count) > worldTiles || id.y + uint64_t(count) > worldTiles) {
+        throw std::invalid_argument("metatile extends past the edge of the world");
+    }
+
+    const Size metatileSize { tileSize * count, tileSize * count };
+    setSize(metatileSize);
+    map.setSize(metatileSize);
+
+    CameraOptions camera;
+    // The center of the block is the corner of a tile one zoom level further in.
+    camera.center = LatLng(CanonicalTileID(id.z + 1, 2 * id.x + count, 2 * id.y + count));
+    // The zoom level at which the world is `tileSize` pixels wide times the tiles across it.
+    camera.zoom = id.z + std::log2(tileSize / util::tileSize);
+    camera.angle = 0;
+    camera.pitch = 0;
+    map.jumpTo(camera);
+
+    const PremultipliedImage metatile = render(map);
+
+    const uint32_t tilePixels = metatile.size.width / count;
+    std::vector<PremultipliedImage> tiles;
+    tiles.reserve(count * count);
+    for (uint32_t y = 0; y < count; y++) {
+        for (uint32_t x = 0; x < count; x++) {
+            PremultipliedImage tile({ tilePixels, tilePixels });
+            PremultipliedImage::copy(metatile, tile, { x * tilePixels, y * tilePixels }, { 0, 0 }, tile.size);
+            tiles.push_back(std::move(tile));
+        }
+    }
+
+    return tiles;
+}
+
 optional<TransformState> HeadlessFrontend::getTransformState() const {
     if (updateParameters) {
         return updateParameters->transformState;
@@ -7,9 +7,11 @@
 #include <mbgl/util/optional.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace mbgl {
 
+class CanonicalTileID;
 class FileSource;
 class Scheduler;
 class Renderer;
@@ -36,6 +38,22 @@ public:
     PremultipliedImage readStillImage();
     PremultipliedImage render(Map&);
 
+    // Renders like render(), but reads the image back while the next call renders, and returns
+    // the image of the previous call, or an empty image on the first one. finishRender() returns
+    // the image of the last call.
+    PremultipliedImage renderPipelined(Map&);
+    PremultipliedImage finishRender();
+
+    // Renders the `count` x `count` block of tiles whose top left tile is `id` with a map in
+    // MapMode::Tile. The block is rendered in a single pass, so tile loading, layout and label
+    // placement happen once for the whole block, and labels are consistent across the seams
+    // between its tiles. Returns the tiles of `tileSize` logical pixels, row by row. Resizes both
+    // the frontend and the map to the block and leaves them at that size, so that rendering more
+    // blocks of the same size doesn't reallocate the framebuffer. It also moves the camera of the
+    // map. Throws std::invalid_argument if the block is empty or extends past the edge of the
+    // world.
+    std::vector<PremultipliedImage> renderMetatile(Map&, const CanonicalTileID& id, uint32_t count, uint32_t tileSize = 512);
+
     optional<TransformState> getTransformState() const;
 
 private:
@@ -0,0 +1,180 @@
+#include <mbgl/map/map_render_pool.hpp>
+
+#include <mbgl/gl/headless_frontend.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread.hpp>
+
+#include <cassert>
+#include <stdexcept>
+
+namespace mbgl {
+
+// A map of the pool, which lives on its own thread.
+class MapRenderPool::Impl {
+public:
+    Impl(MapRenderPool& pool_,
+         std::size_t index_,
+         FileSource& fileSource_,
+         Scheduler& scheduler_,
+         std::string styleURL_,
+         float pixelRatio_,
+         optional<std::string> programCacheDir_)
+        : pool(pool_),
+          index(index_),
+          fileSource(fileSource_),
+          scheduler(scheduler_),
+          styleURL(std::move(styleURL_)),
+          programCacheDir(std::move(programCacheDir_)) {
+        create(pixelRatio_);
+    }
+
+    void render(Request request) {
+        if (request.pixelRatio != pixelRatio) {
+            create(request.pixelRatio);
+        }
+
+        map->setSize(request.size);
+        frontend->setSize(request.size);
+        map->jumpTo(request.camera);
+
+        map->renderStill([this] (std::exception_ptr error) {
+            pool.onRendered(index, error, error ? PremultipliedImage() : frontend->readStillImage());
+        });
+    }
+
+private:
+    // The pixel ratio of a map and its renderer can't be changed, so they are recreated. The
+    // style is loaded right away, so that it is ready by the time the first request arrives.
+    void create(float pixelRatio_) {
+        const Size size = frontend ? frontend->getSize() : Size { 256, 256 };
+        map.reset();
+        frontend.reset();
+
+        pixelRatio = pixelRatio_;
+        frontend = std::make_unique<HeadlessFrontend>(size, pixelRatio, fileSource, scheduler, programCacheDir);
+        map = std::make_unique<Map>(*frontend, MapObserver::nullObserver(), size, pixelRatio,
+                                    fileSource, scheduler, MapMode::Static);
+        map->getStyle().loadURL(styleURL);
+    }
+
+    MapRenderPool& pool;
+    const std::size_t index;
+    FileSource& fileSource;
+    Scheduler& scheduler;
+    const std::string styleURL;
+    const optional<std::string> programCacheDir;
+
+    float pixelRatio = 0;
+    std::unique_ptr<HeadlessFrontend> frontend;
+    std::unique_ptr<Map> map;
+};
+
+MapRenderPool::MapRenderPool(FileSource& fileSource,
+                             Scheduler& scheduler,
+                             const std::string& styleURL,
+                             std::size_t size,
+                             float pixelRatio,
+                             const optional<std::string> programCacheDir) {
+    assert(size > 0);
+    members.reserve(size);
+    threads.reserve(size);
+    for (std::size_t i = 0; i < size; i++) {
+        threads.push_back(std::make_unique<util::Thread<Impl>>(
+            "Map Render Pool " + util::toString(i), *this, i, fileSource, scheduler, styleURL,
+            pixelRatio, programCacheDir));
+        members.push_back({ false, pixelRatio, threads.back()->actor(), {} });
+    }
+}
+
+MapRenderPool::~MapRenderPool() {
+    std::deque<PendingRequest> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        std::swap(dropped, pending);
+    }
+
+    const auto error = std::make_exception_ptr(std::runtime_error("map render pool destroyed"));
+    for (auto& request : dropped) {
+        request.callback(error, {});
+    }
+
+    // Renders that complete while the maps are destroyed are called back as usual.
+    threads.clear();
+
+    for (auto& member : members) {
+        if (member.callback) {
+            member.callback(error, {});
+        }
+    }
+}
+
+std::size_t MapRenderPool::size() const {
+    return members.size();
+}
+
+void MapRenderPool::render(Request request, Callback callback) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    Member* idle = nullptr;
+    for (auto& member : members) {
+        if (!member.busy && (!idle || member.pixelRatio == request.pixelRatio)) {
+            idle = &member;
+            if (member.pixelRatio == request.pixelRatio) {
+                break;
+            }
+        }
+    }
+
+    if (!idle) {
+        pending.push_back({ std::move(request), std::move(callback) });
+        return;
+    }
+
+    idle->busy = true;
+    idle->pixelRatio = request.pixelRatio;
+    idle->callback = std::move(callback);
+    ActorRef<Impl> actor = idle->actor;
+    lock.unlock();
+
+    actor.invoke(&Impl::render, std::move(request));
+}
+
+// Called on the thread of the map that rendered. Hands it the next pending request, preferring
+// one with the pixel ratio the map already has, before calling back the one it rendered, so
+// that the pool stays consistent whatever the callback does.
+void MapRenderPool::onRendered(std::size_t index, std::exception_ptr error, PremultipliedImage image) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Member& member = members[index];
+    Callback callback = std::move(member.callback);
+    member.callback = nullptr;
+
+    if (stopping || pending.empty()) {
+        member.busy = false;
+        lock.unlock();
+        callback(error, std::move(image));
+        return;
+    }
+
+    auto next = pending.begin();
+    for (auto it = pending.begin(); it != pending.end(); ++it) {
+        if (it->request.pixelRatio == member.pixelRatio) {
+            next = it;
+            break;
+        }
+    }
+
+    PendingRequest request = std::move(*next);
+    pending.erase(next);
+    member.pixelRatio = request.request.pixelRatio;
+    member.callback = std::move(request.callback);
+    ActorRef<Impl> actor = member.actor;
+    lock.unlock();
+
+    actor.invoke(&Impl::render, std::move(request.request));
+    callback(error, std::move(image));
+}
+
+} // namespace mbgl
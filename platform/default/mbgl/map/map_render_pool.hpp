@@ -0,0 +1,89 @@
+#pragma once
+
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/map/camera.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class FileSource;
+class Scheduler;
+
+namespace util {
+template <class> class Thread;
+} // namespace util
+
+// Renders static images of a style with a pool of maps that are kept loaded, as tile servers do.
+// Creating a map, its renderer and loading the style costs far more than rendering, so requests
+// are multiplexed onto the maps instead. Each map renders on its own thread with its own
+// rendering context. All of them share the file source, and its cache of tiles, glyphs and
+// sprites, as well as the scheduler their workers run on.
+class MapRenderPool {
+public:
+    struct Request {
+        CameraOptions camera;
+        Size size;
+        float pixelRatio = 1;
+    };
+
+    // Called on the thread of the map that rendered the image, once the map is ready for its next
+    // request. Callbacks must not throw, since they run on the map's run loop.
+    using Callback = std::function<void (std::exception_ptr, PremultipliedImage)>;
+
+    MapRenderPool(FileSource&,
+                  Scheduler&,
+                  const std::string& styleURL,
+                  std::size_t size,
+                  float pixelRatio = 1,
+                  const optional<std::string> programCacheDir = {});
+
+    // Destroys the maps, and calls back the requests they haven't rendered yet with an error, on
+    // the calling thread. This includes the renders in progress that are still loading.
+    ~MapRenderPool();
+
+    // Renders on an idle map, preferring one that has the requested pixel ratio already, or
+    // queues the request until a map is idle. A map is recreated to change its pixel ratio.
+    void render(Request, Callback);
+
+    std::size_t size() const;
+
+private:
+    class Impl;
+
+    void onRendered(std::size_t index, std::exception_ptr, PremultipliedImage);
+
+    struct Member {
+        bool busy = false;
+        float pixelRatio;
+        ActorRef<Impl> actor;
+
+        // The callback of the request the map is rendering, kept here rather than in the
+        // message to the map, so that it's called back even if the map is destroyed first.
+        Callback callback;
+    };
+
+    struct PendingRequest {
+        Request request;
+        Callback callback;
+    };
+
+    std::mutex mutex;
+    std::vector<Member> members;
+    std::deque<PendingRequest> pending;
+    bool stopping = false;
+
+    // Destroyed first, so that no map reports a finished render to a destroyed pool.
+    std::vector<std::unique_ptr<util::Thread<Impl>>> threads;
+};
+
+} // namespace mbgl
@@ -45,7 +45,8 @@ void OfflineDatabase::ensureSchema() {
             case 3: // no-op and fall through
             case 4: migrateToVersion5(); // fall through
             case 5: migrateToVersion6(); // fall through
-            case 6: return;
+            case 6: // no-op and fall through
+            case 7: return;
             default: break; // downgrade, delete the database
             }
 
@@ -128,6 +129,16 @@ void OfflineDatabase::migrateToVersion6() {
     transaction.commit();
 }
 
+// Version 7 stores the codec in the `compressed` column instead of a boolean. The schema is
+// unchanged, but earlier versions would read data compressed with other codecs than zlib as
+// zlib, so they have to discard the database instead. Databases only move to it when the
+// first such row is stored, so that earlier versions keep the ones that don't have any.
+void OfflineDatabase::migrateToVersion7() {
+    if (userVersion() < 7) {
+        db->exec("PRAGMA user_version = 7");
+    }
+}
+
 mapbox::sqlite::Statement& OfflineDatabase::getStatement(const char* sql) {
     auto it = statements.find(sql);
     if (it == statements.end()) {
@@ -168,14 +179,24 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         return { false, 0 };
     }
 
+    // The data as it is stored.
+    const std::string* data = response.data.get();
     std::string compressedData;
-    bool compressed = false;
+    util::CompressionCodec codec = util::CompressionCodec::None;
     uint64_t size = 0;
 
     if (response.data) {
-        compressedData = util::compress(*response.data);
-        compressed = compressedData.size() < response.data->size();
-        size = compressed ? compressedData.size() : response.data->size();
+        if (resource.kind == Resource::Kind::Tile && util::isCompressed(*response.data)) {
+            // Tiles the server compressed are stored as they are instead of compressed again.
+            codec = util::CompressionCodec::Zlib;
+        } else if (compressionCodec != util::CompressionCodec::None) {
+            compressedData = util::compress(*response.data, compressionCodec);
+            if (compressedData.size() < response.data->size()) {
+                codec = compressionCodec;
+                data = &compressedData;
+            }
+        }
+        size = data->size();
     }
 
     if (evict_ && !evict(size)) {
@@ -183,17 +204,18 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         return { false, 0 };
     }
 
+    if (codec == util::CompressionCodec::LZ4) {
+        migrateToVersion7();
+    }
+
     bool inserted;
+    const std::string noData;
 
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        inserted = putTile(*resource.tileData, response,
-                compressed ? compressedData : response.data ? *response.data : "",
-                compressed);
+        inserted = putTile(*resource.tileData, response, data ? *data : noData, codec);
     } else {
-        inserted = putResource(resource, response,
-                compressed ? compressedData : response.data ? *response.data : "",
-                compressed);
+        inserted = putResource(resource, response, data ? *data : noData, codec);
     }
 
     return { inserted, size };
@@ -233,11 +255,10 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     auto data = query.get<optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
+        // Rows written before version 7 store `true` for zlib, which has the same value.
+        const auto codec = util::CompressionCodec(query.get<int>(5));
+        response.data = std::make_shared<std::string>(util::decompress(*data, codec));
         size = data->length();
     }
 
@@ -257,7 +278,7 @@ optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
-                                  bool compressed) {
+                                  util::CompressionCodec codec) {
     if (response.notModified) {
         // clang-format off
         mapbox::sqlite::Query notModifiedQuery{ getStatement(
@@ -306,10 +327,10 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     if (response.noContent) {
         updateQuery.bind(7, nullptr);
-        updateQuery.bind(8, false);
+        updateQuery.bind(8, int(util::CompressionCodec::None));
     } else {
         updateQuery.bindBlob(7, data.data(), data.size(), false);
-        updateQuery.bind(8, compressed);
+        updateQuery.bind(8, int(codec));
     }
 
     updateQuery.run();
@@ -334,10 +355,10 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     if (response.noContent) {
         insertQuery.bind(8, nullptr);
-        insertQuery.bind(9, false);
+        insertQuery.bind(9, int(util::CompressionCodec::None));
     } else {
         insertQuery.bindBlob(8, data.data(), data.size(), false);
-        insertQuery.bind(9, compressed);
+        insertQuery.bind(9, int(codec));
     }
 
     insertQuery.run();
@@ -401,12 +422,16 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     optional<std::string> data = query.get<optional<std::string>>(4);
     if (!data) {
         response.noContent = true;
-    } else if (query.get<bool>(5)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
         size = data->length();
+        // Rows written before version 7 store `true` for zlib, which has the same value.
+        const auto codec = util::CompressionCodec(query.get<int>(5));
+        if (codec == util::CompressionCodec::Zlib) {
+            // The tile workers inflate tiles when they parse them, instead of this thread.
+            response.data = std::make_shared<std::string>(std::move(*data));
+        } else {
+            response.data = std::make_shared<std::string>(util::decompress(*data, codec));
+        }
     }
 
     return std::make_pair(response, size);
@@ -440,7 +465,7 @@ optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              util::CompressionCodec codec) {
     if (response.notModified) {
         // clang-format off
         mapbox::sqlite::Query notModifiedQuery{ getStatement(
@@ -503,10 +528,10 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     if (response.noContent) {
         updateQuery.bind(6, nullptr);
-        updateQuery.bind(7, false);
+        updateQuery.bind(7, int(util::CompressionCodec::None));
     } else {
         updateQuery.bindBlob(6, data.data(), data.size(), false);
-        updateQuery.bind(7, compressed);
+        updateQuery.bind(7, int(codec));
     }
 
     updateQuery.run();
@@ -534,10 +559,10 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     if (response.noContent) {
         insertQuery.bind(11, nullptr);
-        insertQuery.bind(12, false);
+        insertQuery.bind(12, int(util::CompressionCodec::None));
     } else {
         insertQuery.bindBlob(11, data.data(), data.size(), false);
-        insertQuery.bind(12, compressed);
+        insertQuery.bind(12, int(codec));
     }
 
     insertQuery.run();
@@ -862,6 +887,10 @@ void OfflineDatabase::setOfflineMapboxTileCountLimit(uint64_t limit) {
     offlineMapboxTileCountLimit = limit;
 }
 
+void OfflineDatabase::setCompressionCodec(util::CompressionCodec codec) {
+    compressionCodec = codec;
+}
+
 uint64_t OfflineDatabase::getOfflineMapboxTileCountLimit() {
     return offlineMapboxTileCountLimit;
 }
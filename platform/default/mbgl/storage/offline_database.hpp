@@ -6,6 +6,7 @@
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mapbox.hpp>
+#include <mbgl/util/compression.hpp>
 
 #include <unordered_map>
 #include <memory>
@@ -58,6 +59,10 @@ public:
     bool offlineMapboxTileCountLimitExceeded();
     uint64_t getOfflineMapboxTileCount();
 
+    // The codec new data is compressed with. Data is stored uncompressed if that isn't smaller,
+    // and data stored with any codec can be read regardless.
+    void setCompressionCodec(util::CompressionCodec);
+
 private:
     void connect(int flags);
     int userVersion();
@@ -66,18 +71,19 @@ private:
     void migrateToVersion3();
     void migrateToVersion5();
     void migrateToVersion6();
+    void migrateToVersion7();
 
     mapbox::sqlite::Statement& getStatement(const char *);
 
     optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
     optional<int64_t> hasTile(const Resource::TileData&);
     bool putTile(const Resource::TileData&, const Response&,
-                 const std::string&, bool compressed);
+                 const std::string&, util::CompressionCodec);
 
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     optional<int64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
-                     const std::string&, bool compressed);
+                     const std::string&, util::CompressionCodec);
 
     optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     optional<int64_t> hasInternal(const Resource&);
@@ -101,6 +107,8 @@ private:
     uint64_t offlineMapboxTileCountLimit = util::mapbox::DEFAULT_OFFLINE_TILE_COUNT_LIMIT;
     optional<uint64_t> offlineMapboxTileCount;
 
+    util::CompressionCodec compressionCodec = util::CompressionCodec::Zlib;
+
     bool evict(uint64_t neededFreeSize);
 };
 
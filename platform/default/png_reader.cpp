@@ -1,10 +1,8 @@
 #include <mbgl/util/image.hpp>
-#include <mbgl/util/premultiply.hpp>
-#include <mbgl/util/char_array_buffer.hpp>
+#include <mbgl/util/pixel_kernels.hpp>
 #include <mbgl/util/logging.hpp>
 
-#include <istream>
-#include <sstream>
+#include <cstring>
 
 extern "C"
 {
@@ -39,14 +37,20 @@ static void user_warning_fn(png_structp, png_const_charp warning_msg) {
     Log::Warning(Event::Image, "ImageReader (PNG): %s", warning_msg);
 }
 
+// Reads straight from the encoded data, without copying it into a stream first.
+struct png_memory_source {
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+};
+
 static void png_read_data(png_structp png_ptr, png_bytep data, png_size_t length) {
-    auto* fin = reinterpret_cast<std::istream*>(png_get_io_ptr(png_ptr));
-    fin->read(reinterpret_cast<char*>(data), length);
-    std::streamsize read_count = fin->gcount();
-    if (read_count < 0 || static_cast<png_size_t>(read_count) != length)
-    {
+    auto* source = reinterpret_cast<png_memory_source*>(png_get_io_ptr(png_ptr));
+    if (length > source->size - source->offset) {
         png_error(png_ptr, "Read Error");
     }
+    std::memcpy(data, source->data + source->offset, length);
+    source->offset += length;
 }
 
 struct png_struct_guard {
@@ -63,18 +67,15 @@ struct png_struct_guard {
 };
 
 PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
-    util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
-    std::istream stream(&dataBuffer);
-
-    png_byte header[8] = { 0 };
-    stream.read(reinterpret_cast<char*>(header), 8);
-    if (stream.gcount() != 8)
+    if (size < 8)
         throw std::runtime_error("PNG reader: Could not read image");
 
-    int is_png = !png_sig_cmp(header, 0, 8);
+    int is_png = !png_sig_cmp(data, 0, 8);
     if (!is_png)
         throw std::runtime_error("File or stream is not a png");
 
+    png_memory_source source { data, size, 8 };
+
     png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
     if (!png_ptr)
         throw std::runtime_error("failed to allocate png_ptr");
@@ -88,7 +89,7 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
     if (!info_ptr)
         throw std::runtime_error("failed to create info_ptr");
 
-    png_set_read_fn(png_ptr, &stream, png_read_data);
+    png_set_read_fn(png_ptr, &source, png_read_data);
     png_set_sig_bytes(png_ptr, 8);
     png_read_info(png_ptr, info_ptr);
 
@@ -98,8 +99,6 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
     int color_type = 0;
     png_get_IHDR(png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, nullptr, nullptr, nullptr);
 
-    UnassociatedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
-
     if (color_type == PNG_COLOR_TYPE_PALETTE)
         png_set_expand(png_ptr);
 
@@ -118,25 +117,41 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
 
     png_set_add_alpha(png_ptr, 0xff, PNG_FILLER_AFTER);
 
-    if (png_get_interlace_type(png_ptr,info_ptr) == PNG_INTERLACE_ADAM7) {
-        png_set_interlace_handling(png_ptr); // FIXME: libpng bug?
-        // according to docs png_read_image
-        // "..automatically handles interlacing,
-        // so you don't need to call png_set_interlace_handling()"
-    }
+    // Images without an alpha channel don't need to be premultiplied.
+    const bool hasAlpha = (color_type & PNG_COLOR_MASK_ALPHA) || png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+
+    const int passes = png_set_interlace_handling(png_ptr);
 
     png_read_update_info(png_ptr, info_ptr);
 
-    // we can read whole image at once
-    // alloc row pointers
-    const std::unique_ptr<png_bytep[]> rows(new png_bytep[height]);
-    for (unsigned row = 0; row < height; ++row)
-        rows[row] = image.data.get() + row * width * 4;
-    png_read_image(png_ptr, rows.get());
+    // Every pixel is written by the decoder, so the buffer doesn't need to be initialized.
+    const Size imageSize { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+    PremultipliedImage image(imageSize, util::ImageBufferPool::getDefault());
+    const size_t stride = width * 4;
+
+    if (passes == 1) {
+        // Rows are premultiplied as soon as they are decoded, while they are still in cache.
+        for (png_uint_32 row = 0; row < height; ++row) {
+            uint8_t* rowData = image.data.get() + row * stride;
+            png_read_row(png_ptr, rowData, nullptr);
+            if (hasAlpha) {
+                util::premultiply(rowData, width);
+            }
+        }
+    } else {
+        // Interlaced images are only complete after the last pass.
+        const std::unique_ptr<png_bytep[]> rows(new png_bytep[height]);
+        for (png_uint_32 row = 0; row < height; ++row)
+            rows[row] = image.data.get() + row * stride;
+        png_read_image(png_ptr, rows.get());
+        if (hasAlpha) {
+            util::premultiply(image.data.get(), imageSize.area());
+        }
+    }
 
     png_read_end(png_ptr, nullptr);
 
-    return util::premultiply(std::move(image));
+    return image;
 }
 
 } // namespace mbgl
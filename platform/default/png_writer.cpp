@@ -7,8 +7,13 @@
 #include <boost/crc.hpp>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 
 #define NETWORK_BYTE_UINT32(value)                                                                 \
     char(value >> 24), char(value >> 16), char(value >> 8), char(value >> 0)
@@ -33,45 +38,279 @@ void addChunk(std::string& png, const char* type, const char* data = "", const u
     png.append(crc, 4);
 }
 
+using Filter = mbgl::PNGEncodeOptions::Filter;
+
+uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+// Writes `row` predicted with one of the PNG filters to `out`. `prior` is the previous row, or
+// a row of zeros for the first one, and `bpp` the number of bytes per pixel.
+void filterRow(uint8_t* out, Filter filter, const uint8_t* row, const uint8_t* prior, std::size_t length, std::size_t bpp) {
+    switch (filter) {
+    case Filter::Sub:
+        for (std::size_t i = 0; i < length; i++) {
+            out[i] = row[i] - (i >= bpp ? row[i - bpp] : 0);
+        }
+        break;
+    case Filter::Up:
+        for (std::size_t i = 0; i < length; i++) {
+            out[i] = row[i] - prior[i];
+        }
+        break;
+    case Filter::Average:
+        for (std::size_t i = 0; i < length; i++) {
+            out[i] = row[i] - ((i >= bpp ? row[i - bpp] : 0) + prior[i]) / 2;
+        }
+        break;
+    case Filter::Paeth:
+        for (std::size_t i = 0; i < length; i++) {
+            out[i] = row[i] - (i >= bpp ? paeth(row[i - bpp], prior[i], prior[i - bpp]) : prior[i]);
+        }
+        break;
+    default:
+        std::memcpy(out, row, length);
+        break;
+    }
+}
+
+// The sum of the filtered bytes as signed differences, which is smaller the better a filter
+// predicts the row.
+std::size_t cost(const uint8_t* filtered, std::size_t length) {
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i < length; i++) {
+        sum += std::abs(int8_t(filtered[i]));
+    }
+    return sum;
+}
+
+// Appends the rows of the image prefixed with their filter type to the IDAT data.
+std::string filterRows(const uint8_t* data, uint32_t height, std::size_t stride, std::size_t bpp, Filter filter) {
+    std::string idat((stride + 1) * height, '\0');
+    auto* out = reinterpret_cast<uint8_t*>(&idat[0]);
+
+    const std::vector<uint8_t> zeros(stride, 0);
+    std::vector<uint8_t> scratch(filter == Filter::Adaptive ? stride : 0);
+
+    for (uint32_t y = 0; y < height; y++, out += stride + 1) {
+        const uint8_t* row = data + y * stride;
+        const uint8_t* prior = y ? row - stride : zeros.data();
+
+        Filter rowFilter = filter;
+        if (filter == Filter::Adaptive) {
+            rowFilter = Filter::None;
+            std::size_t best = cost(row, stride);
+            for (auto candidate : { Filter::Sub, Filter::Up, Filter::Average, Filter::Paeth }) {
+                filterRow(scratch.data(), candidate, row, prior, stride, bpp);
+                const std::size_t candidateCost = cost(scratch.data(), stride);
+                if (candidateCost < best) {
+                    best = candidateCost;
+                    rowFilter = candidate;
+                }
+            }
+        }
+
+        out[0] = uint8_t(rowFilter);
+        filterRow(out + 1, rowFilter, row, prior, stride, bpp);
+    }
+
+    return idat;
+}
+
+uint32_t pack(const uint8_t* pixel) {
+    return uint32_t(pixel[0]) | uint32_t(pixel[1]) << 8 | uint32_t(pixel[2]) << 16 | uint32_t(pixel[3]) << 24;
+}
+
+uint8_t channel(uint32_t color, uint32_t index) {
+    return uint8_t(color >> (8 * index));
+}
+
+// Maps the colors of the image to at most 256 entries of `palette`, and its pixels to their
+// indices. Returns false when the image has more colors and `quantize` is false.
+bool buildPalette(const mbgl::UnassociatedImage& image, bool quantize, std::vector<uint32_t>& palette, std::string& indices) {
+    const std::size_t count = image.bytes() / 4;
+    if (count == 0) {
+        return false;
+    }
+
+    std::unordered_map<uint32_t, uint32_t> histogram;
+    for (std::size_t i = 0; i < count; i++) {
+        histogram[pack(image.data.get() + 4 * i)]++;
+        if (histogram.size() > 256 && !quantize) {
+            return false;
+        }
+    }
+
+    struct Entry {
+        uint32_t color;
+        uint32_t count;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(histogram.size());
+    for (const auto& bucket : histogram) {
+        entries.push_back({ bucket.first, bucket.second });
+    }
+
+    // Median cut: splits the box of colors with the largest range of a channel at the median of
+    // that channel, until there are 256 boxes, or each of them holds a single color.
+    struct Box {
+        std::size_t begin;
+        std::size_t end;
+        uint32_t channel;
+        uint32_t range;
+    };
+    const auto makeBox = [&](std::size_t begin, std::size_t end) {
+        Box box { begin, end, 0, 0 };
+        for (uint32_t c = 0; c < 4; c++) {
+            uint8_t min = 255, max = 0;
+            for (std::size_t i = begin; i < end; i++) {
+                min = std::min(min, channel(entries[i].color, c));
+                max = std::max(max, channel(entries[i].color, c));
+            }
+            if (max - min > int(box.range)) {
+                box.channel = c;
+                box.range = max - min;
+            }
+        }
+        return box;
+    };
+
+    std::vector<Box> boxes { makeBox(0, entries.size()) };
+    while (boxes.size() < 256) {
+        auto box = std::max_element(boxes.begin(), boxes.end(), [](const Box& a, const Box& b) {
+            return a.range < b.range;
+        });
+        if (box->range == 0) {
+            break;
+        }
+
+        const uint32_t c = box->channel;
+        std::sort(entries.begin() + box->begin, entries.begin() + box->end, [&](const Entry& a, const Entry& b) {
+            return channel(a.color, c) < channel(b.color, c);
+        });
+
+        uint64_t total = 0;
+        for (std::size_t i = box->begin; i < box->end; i++) {
+            total += entries[i].count;
+        }
+        std::size_t split = box->begin + 1;
+        for (uint64_t sum = entries[box->begin].count; split < box->end - 1 && sum * 2 < total; split++) {
+            sum += entries[split].count;
+        }
+
+        const std::size_t end = box->end;
+        *box = makeBox(box->begin, split);
+        boxes.push_back(makeBox(split, end));
+    }
+
+    // Each box becomes the average of its colors, weighted by the number of their pixels.
+    palette.clear();
+    for (const auto& box : boxes) {
+        uint64_t sums[4] = { 0, 0, 0, 0 };
+        uint64_t total = 0;
+        for (std::size_t i = box.begin; i < box.end; i++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                sums[c] += uint64_t(channel(entries[i].color, c)) * entries[i].count;
+            }
+            total += entries[i].count;
+        }
+        uint32_t color = 0;
+        for (uint32_t c = 0; c < 4; c++) {
+            color |= uint32_t((sums[c] + total / 2) / total) << (8 * c);
+        }
+        palette.push_back(color);
+    }
+
+    // Each color maps to the closest entry of the palette, which isn't always the one of its box.
+    std::unordered_map<uint32_t, uint8_t> index;
+    for (const auto& entry : entries) {
+        uint32_t best = std::numeric_limits<uint32_t>::max();
+        for (std::size_t i = 0; i < palette.size() && best; i++) {
+            uint32_t distance = 0;
+            for (uint32_t c = 0; c < 4; c++) {
+                const int difference = channel(entry.color, c) - channel(palette[i], c);
+                distance += difference * difference;
+            }
+            if (distance < best) {
+                best = distance;
+                index[entry.color] = uint8_t(i);
+            }
+        }
+    }
+
+    indices.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        indices[i] = char(index[pack(image.data.get() + 4 * i)]);
+    }
+
+    return true;
+}
+
 } // namespace
 
 namespace mbgl {
 
-// Encode PNGs without libpng.
 std::string encodePNG(const PremultipliedImage& pre) {
+    return encodePNG(pre, {});
+}
+
+// Encode PNGs without libpng.
+std::string encodePNG(const PremultipliedImage& pre, const PNGEncodeOptions& options) {
     // Make copy of the image so that we can unpremultiply it.
     const auto src = util::unpremultiply(pre.clone());
 
     // PNG magic bytes
     const char preamble[8] = { char(0x89), 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
 
-    // IHDR chunk for our RGBA image.
+    std::vector<uint32_t> palette;
+    std::string indices;
+    const bool indexed = options.palette != PNGEncodeOptions::Palette::None &&
+        buildPalette(src, options.palette == PNGEncodeOptions::Palette::Quantize, palette, indices);
+
+    // IHDR chunk for our RGBA or indexed image.
     const char ihdr[13] = {
         NETWORK_BYTE_UINT32(src.size.width),  // width
         NETWORK_BYTE_UINT32(src.size.height), // height
         8,                                    // bit depth == 8 bits
-        6,                                    // color type == RGBA
+        char(indexed ? 3 : 6),                // color type == indexed or RGBA
         0,                                    // compression method == deflate
         0,                                    // filter method == default
         0,                                    // interlace method == none
     };
 
     // Prepare the (compressed) data chunk.
-    const auto stride = src.stride();
-    std::string idat;
-    for (uint32_t y = 0; y < src.size.height; y++) {
-        // Every scanline needs to be prefixed with one byte that indicates the filter type.
-        idat.append(1, 0); // filter type 0
-        idat.append((const char*)(src.data.get() + y * stride), stride);
+    std::string idat = indexed
+        ? filterRows(reinterpret_cast<const uint8_t*>(indices.data()), src.size.height, src.size.width, 1, Filter::None)
+        : filterRows(src.data.get(), src.size.height, src.stride(), 4, options.filter);
+    idat = util::compress(idat, options.compressionLevel);
+
+    // The PLTE chunk with the colors of the palette, and the tRNS chunk with their alpha values.
+    std::string plte, trns;
+    for (uint32_t color : palette) {
+        plte.append({ char(channel(color, 0)), char(channel(color, 1)), char(channel(color, 2)) });
+        trns.append(1, char(channel(color, 3)));
+    }
+    // Entries missing from the tRNS chunk are opaque.
+    while (!trns.empty() && uint8_t(trns.back()) == 255) {
+        trns.pop_back();
     }
-    idat = util::compress(idat);
 
     // Assemble the PNG.
     std::string png;
-    png.reserve((8 /* preamble */) + (12 + 13 /* IHDR */) +
-                (12 + idat.size() /* IDAT */) + (12 /* IEND */));
+    png.reserve((8 /* preamble */) + (12 + 13 /* IHDR */) + (12 + plte.size() /* PLTE */) +
+                (12 + trns.size() /* tRNS */) + (12 + idat.size() /* IDAT */) + (12 /* IEND */));
     png.append(preamble, 8);
     addChunk(png, "IHDR", ihdr, 13);
+    if (indexed) {
+        addChunk(png, "PLTE", plte.data(), static_cast<uint32_t>(plte.size()));
+        if (!trns.empty()) {
+            addChunk(png, "tRNS", trns.data(), static_cast<uint32_t>(trns.size()));
+        }
+    }
     addChunk(png, "IDAT", idat.data(), static_cast<uint32_t>(idat.size()));
     addChunk(png, "IEND");
     return png;
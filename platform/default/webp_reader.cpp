@@ -15,16 +15,14 @@ PremultipliedImage decodeWebP(const uint8_t* data, size_t size) {
         throw std::runtime_error("failed to retrieve WebP basic header information");
     }
 
-    int stride = width * 4;
-    size_t webpSize = stride * height;
-    auto webp = std::make_unique<uint8_t[]>(webpSize);
+    // Decoded straight into the final image, which doesn't need to be initialized first.
+    UnassociatedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) },
+                            util::ImageBufferPool::getDefault());
 
-    if (!WebPDecodeRGBAInto(data, size, webp.get(), webpSize, stride)) {
+    if (!WebPDecodeRGBAInto(data, size, image.data.get(), image.bytes(), static_cast<int>(image.stride()))) {
         throw std::runtime_error("failed to decode WebP data");
     }
 
-    UnassociatedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) },
-                            std::move(webp));
     return util::premultiply(std::move(image));
 }
 
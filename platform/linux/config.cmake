@@ -64,6 +64,10 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/mbgl/gl/headless_backend.cpp
         PRIVATE platform/default/mbgl/gl/headless_backend.hpp
 
+        # Rendering server
+        PRIVATE platform/default/mbgl/map/map_render_pool.cpp
+        PRIVATE platform/default/mbgl/map/map_render_pool.hpp
+
         # Thread pool
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
@@ -39,6 +39,10 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/mbgl/map/map_snapshotter.cpp
         PRIVATE platform/default/mbgl/map/map_snapshotter.hpp
 
+        # Rendering server
+        PRIVATE platform/default/mbgl/map/map_render_pool.cpp
+        PRIVATE platform/default/mbgl/map/map_render_pool.hpp
+
         # Thread pool
         PRIVATE platform/default/mbgl/util/shared_thread_pool.cpp
         PRIVATE platform/default/mbgl/util/shared_thread_pool.hpp
@@ -483,15 +483,17 @@ void NodeMap::renderFinished() {
 
         cb->Call(1, argv);
     } else if (img.data) {
+        const std::size_t bytes = img.bytes();
+        auto data = std::make_unique<mbgl::util::ImageBuffer>(std::move(img.data));
         v8::Local<v8::Object> pixels = Nan::NewBuffer(
-            reinterpret_cast<char *>(img.data.get()), img.bytes(),
+            reinterpret_cast<char *>(data->get()), bytes,
             // Retain the data until the buffer is deleted.
             [](char *, void * hint) {
-                delete [] reinterpret_cast<uint8_t*>(hint);
+                delete reinterpret_cast<mbgl::util::ImageBuffer*>(hint);
             },
-            img.data.get()
+            data.get()
         ).ToLocalChecked();
-        img.data.release();
+        data.release();
 
         v8::Local<v8::Value> argv[] = {
             Nan::Null(),
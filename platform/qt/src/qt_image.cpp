@@ -7,14 +7,22 @@
 namespace mbgl {
 
 std::string encodePNG(const PremultipliedImage& pre) {
+    return encodePNG(pre, {});
+}
+
+// Qt chooses the filters and doesn't write indexed images, so only the compression level applies.
+std::string encodePNG(const PremultipliedImage& pre, const PNGEncodeOptions& options) {
     QImage image(pre.data.get(), pre.size.width, pre.size.height,
         QImage::Format_ARGB32_Premultiplied);
 
     QByteArray array;
     QBuffer buffer(&array);
 
+    // Qt maps a quality from 0 to 100 to the compression levels from 9 to 0.
+    const int quality = options.compressionLevel < 0 ? -1 : 100 - options.compressionLevel * 100 / 9;
+
     buffer.open(QIODevice::WriteOnly);
-    image.rgbSwapped().save(&buffer, "PNG");
+    image.rgbSwapped().save(&buffer, "PNG", quality);
 
     return std::string(array.constData(), array.size());
 }
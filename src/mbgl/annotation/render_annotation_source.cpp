@@ -3,9 +3,6 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 
-#include <mbgl/algorithm/generate_clip_ids.hpp>
-#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
-
 namespace mbgl {
 
 using namespace style;
@@ -48,7 +45,7 @@ void RenderAnnotationSource::update(Immutable<style::Source::Impl> baseImpl_,
 }
 
 void RenderAnnotationSource::startRender(PaintParameters& parameters) {
-    parameters.clipIDGenerator.update(tilePyramid.getRenderTiles());
+    parameters.updateClipping(tilePyramid.getRenderTiles());
     tilePyramid.startRender(parameters);
 }
 
@@ -1,5 +1,9 @@
 #include <mbgl/geometry/dem_data.hpp>
 #include <mbgl/math/clamp.hpp>
+#include <mbgl/util/pixel_kernels.hpp>
+
+#include <cmath>
+#include <cstdlib>
 
 namespace mbgl {
 
@@ -7,34 +11,24 @@ DEMData::DEMData(const PremultipliedImage& _image, Tileset::DEMEncoding encoding
     dim(_image.size.height),
     border(std::max<int32_t>(std::ceil(_image.size.height / 2), 1)),
     stride(dim + 2 * border),
-    image({ static_cast<uint32_t>(stride), static_cast<uint32_t>(stride) }) {
+    image({ static_cast<uint32_t>(stride), static_cast<uint32_t>(stride) }, util::ImageBufferPool::getDefault()) {
 
     if (_image.size.height != _image.size.width){
         throw std::runtime_error("raster-dem tiles must be square.");
     }
 
-    auto decodeMapbox = [] (const uint8_t r, const uint8_t g, const uint8_t b){
-        // https://www.mapbox.com/help/access-elevation-data/#mapbox-terrain-rgb
-        return (r * 256 * 256 + g * 256 + b)/10 - 10000;
-    };
-
-    auto decodeTerrarium = [] (const uint8_t r, const uint8_t g, const uint8_t b){
-        // https://aws.amazon.com/public-datasets/terrain/
-        return ((r * 256 + g + b / 256) - 32768);
-    };
-
-    auto decodeRGB = encoding == Tileset::DEMEncoding::Terrarium ? decodeTerrarium : decodeMapbox;
-
     std::memset(image.data.get(), 0, image.bytes());
 
+    auto decodeRGB = encoding == Tileset::DEMEncoding::Terrarium ? util::decodeTerrariumDEM : util::decodeMapboxDEM;
+
+    // Rows are decoded straight into the interior of the bordered image.
     for (int32_t y = 0; y < dim; y++) {
-        for (int32_t x = 0; x < dim; x++) {
-            const int32_t i = y * dim + x;
-            const int32_t j = i * 4;
-            set(x, y, decodeRGB(_image.data[j], _image.data[j+1], _image.data[j+2]));
-        }
+        decodeRGB(_image.data.get() + y * dim * 4,
+                  reinterpret_cast<int32_t*>(image.data.get()) + idx(0, y),
+                  dim,
+                  util::bestInstructionSet());
     }
-    
+
     // in order to avoid flashing seams between tiles, here we are initially populating a 1px border of
     // pixels around the image with the data of the nearest pixel from the image. this data is eventually
     // replaced when the tile's neighboring tiles are loaded and the accurate data can be backfilled using
@@ -66,7 +60,7 @@ DEMData::DEMData(const PremultipliedImage& _image, Tileset::DEMEncoding encoding
 // necessary because the hillshade formula calculates the dx/dz, dy/dz derivatives at each
 // pixel of the tile by querying the 8 surrounding pixels, and if we don't have the pixel
 // buffer we get seams at tile boundaries.
-void DEMData::backfillBorder(const DEMData& borderTileData, int8_t dx, int8_t dy) {
+Rect<uint32_t> DEMData::backfillBorder(const DEMData& borderTileData, int8_t dx, int8_t dy) {
     auto& o = borderTileData;
 
     // Tiles from the same source should always be of the same dimensions.
@@ -101,6 +95,63 @@ void DEMData::backfillBorder(const DEMData& borderTileData, int8_t dx, int8_t dy
             set(x, y, o.get(x + ox, y + oy));
         }
     }
+
+    return { static_cast<uint32_t>(xMin + border), static_cast<uint32_t>(yMin + border),
+             static_cast<uint32_t>(xMax - xMin), static_cast<uint32_t>(yMax - yMin) };
+}
+
+namespace {
+
+// The reciprocal of the hillshade_prepare shader's divisor of the slopes, converted from units
+// of DEMData elevations to the scale of the encoded bytes.
+float hillshadeScale(uint8_t zoom, uint8_t maxzoom) {
+    const float z = zoom;
+    const float exaggeration = z < 2.0f ? 0.4f : z < 4.5f ? 0.35f : 0.3f;
+    const float divisor = std::pow(2.0f, (z - float(maxzoom)) * exaggeration + 19.2562f - z);
+    // The shader divides elevations by 4, and maps slopes from [-1, 1] to [0, 255].
+    return 255.0f / 8.0f / divisor;
+}
+
+} // namespace
+
+PremultipliedImage DEMData::prepareHillshade(uint8_t zoom, uint8_t maxzoom) const {
+    PremultipliedImage result({ static_cast<uint32_t>(dim), static_cast<uint32_t>(dim) },
+                              util::ImageBufferPool::getDefault());
+    const float scale = hillshadeScale(zoom, maxzoom);
+    for (int32_t y = 0; y < dim; y++) {
+        prepareHillshade(result, 0, y, dim, scale);
+    }
+    return result;
+}
+
+Rect<uint32_t> DEMData::prepareHillshadeEdge(PremultipliedImage& result, int8_t dx, int8_t dy, uint8_t zoom, uint8_t maxzoom) const {
+    assert(result.size == Size(static_cast<uint32_t>(dim), static_cast<uint32_t>(dim)));
+    assert(std::abs(dx) <= 1 && std::abs(dy) <= 1 && (dx || dy));
+
+    // The slopes of an edge depend on the border next to it, and those of a corner on the
+    // diagonal neighbor too.
+    const int32_t x = dx > 0 ? dim - 1 : 0;
+    const int32_t y = dy > 0 ? dim - 1 : 0;
+    const int32_t width = dx ? 1 : dim;
+    const int32_t height = dy ? 1 : dim;
+
+    const float scale = hillshadeScale(zoom, maxzoom);
+    for (int32_t row = y; row < y + height; row++) {
+        prepareHillshade(result, x, row, width, scale);
+    }
+
+    return { static_cast<uint32_t>(x), static_cast<uint32_t>(y),
+             static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+}
+
+void DEMData::prepareHillshade(PremultipliedImage& result, int32_t x, int32_t y, int32_t count, float scale) const {
+    const int32_t* elevations = reinterpret_cast<const int32_t*>(image.data.get());
+    util::hillshadeSlopes(elevations + idx(x, y - 1),
+                          elevations + idx(x, y),
+                          elevations + idx(x, y + 1),
+                          result.data.get() + (y * dim + x) * 4,
+                          count,
+                          scale);
 }
 
 } // namespace mbgl
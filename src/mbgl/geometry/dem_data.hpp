@@ -2,6 +2,7 @@
 
 #include <mbgl/math/clamp.hpp>
 #include <mbgl/util/image.hpp>
+#include <mbgl/util/rect.hpp>
 #include <mbgl/util/tileset.hpp>
 
 #include <memory>
@@ -14,7 +15,9 @@ namespace mbgl {
 class DEMData {
 public:
     DEMData(const PremultipliedImage& image, Tileset::DEMEncoding encoding);
-    void backfillBorder(const DEMData& borderTileData, int8_t dx, int8_t dy);
+
+    // Returns the pixels of the image that were backfilled.
+    Rect<uint32_t> backfillBorder(const DEMData& borderTileData, int8_t dx, int8_t dy);
 
     void set(const int32_t x, const int32_t y, const int32_t value) {
         reinterpret_cast<int32_t*>(image.data.get())[idx(x, y)] = value + 65536;
@@ -28,6 +31,16 @@ public:
         return &image;
     }
 
+    // Computes the slopes the hillshade layer shades a tile at `zoom` with, like the
+    // hillshade_prepare shader does on the GPU, as an image of dim x dim pixels. `maxzoom` is the
+    // maximum zoom level of the source.
+    PremultipliedImage prepareHillshade(uint8_t zoom, uint8_t maxzoom) const;
+
+    // Recomputes the slopes of the outermost pixels of an image from prepareHillshade() next to
+    // the border toward the neighboring tile at `dx`, `dy`, after it was backfilled. Returns the
+    // pixels that were recomputed.
+    Rect<uint32_t> prepareHillshadeEdge(PremultipliedImage&, int8_t dx, int8_t dy, uint8_t zoom, uint8_t maxzoom) const;
+
     const int32_t dim;
     const int32_t border;
     const int32_t stride;
@@ -36,6 +49,8 @@ public:
     private:
         PremultipliedImage image;
 
+        void prepareHillshade(PremultipliedImage&, int32_t x, int32_t y, int32_t count, float scale) const;
+
         size_t idx(const int32_t x, const int32_t y) const {
             assert(x >= -border);
             assert(x < dim + border);
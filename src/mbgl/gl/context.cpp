@@ -3,9 +3,11 @@
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
 #include <mbgl/gl/program_binary_extension.hpp>
+#include <mbgl/gl/pixel_buffer_extension.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/compressed_image.hpp>
 
 #include <cstring>
 
@@ -125,6 +127,10 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
 #if MBGL_HAS_BINARY_PROGRAMS
         programBinary = std::make_unique<extension::ProgramBinary>(fn);
 #endif
+        if (strstr(extensions, "GL_ARB_pixel_buffer_object") != nullptr ||
+            strstr(extensions, "GL_NV_pixel_buffer_object") != nullptr) {
+            pixelBuffer = std::make_unique<extension::PixelBuffer>(fn);
+        }
 
 #if MBGL_USE_GLES2
         constexpr const char* halfFloatExtensionName = "OES_texture_half_float";
@@ -139,6 +145,24 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
             supportsHalfFloatTextures = true;
         }
 
+        supportsBC1Textures = strstr(extensions, "GL_EXT_texture_compression_s3tc") != nullptr ||
+                              strstr(extensions, "GL_EXT_texture_compression_dxt1") != nullptr;
+        supportsETC1Textures = strstr(extensions, "GL_OES_compressed_ETC1_RGB8_texture") != nullptr;
+#if MBGL_USE_GLES2
+        // ETC2 is part of OpenGL ES 3.0, which is backwards compatible with OpenGL ES 2.0.
+        if (const auto* version = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_VERSION)))) {
+            supportsETC2Textures = strncmp(version, "OpenGL ES ", 10) == 0 && version[10] >= '3';
+        }
+#else
+        supportsETC2Textures = strstr(extensions, "GL_ARB_ES3_compatibility") != nullptr;
+#endif
+
+#if MBGL_USE_GLES2
+        supportsUint32Indices = strstr(extensions, "GL_OES_element_index_uint") != nullptr;
+#else
+        supportsUint32Indices = true;
+#endif
+
         if (!supportsVertexArrays()) {
             Log::Warning(Event::OpenGL, "Not using Vertex Array Objects");
         }
@@ -241,6 +265,7 @@ UniqueBuffer Context::createVertexBuffer(const void* data, std::size_t size, con
     UniqueBuffer result { std::move(id), { this } };
     vertexBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, data, static_cast<GLenum>(usage)));
+    vertexBufferBytes += size;
     return result;
 }
 
@@ -256,6 +281,7 @@ UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size, cons
     bindVertexArray = 0;
     globalVertexArrayState.indexBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, static_cast<GLenum>(usage)));
+    indexBufferBytes += size;
     return result;
 }
 
@@ -377,9 +403,9 @@ UniqueRenderbuffer Context::createRenderbuffer(const RenderbufferType type, cons
     return renderbuffer;
 }
 
-std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size, const TextureFormat format, const bool flip) {
+util::ImageBuffer Context::readFramebuffer(const Size size, const TextureFormat format, const bool flip) {
     const size_t stride = size.width * (format == TextureFormat::RGBA ? 4 : 1);
-    auto data = std::make_unique<uint8_t[]>(stride * size.height);
+    auto data = util::ImageBufferPool::getDefault().acquire(stride * size.height);
 
     // When reading data from the framebuffer, make sure that we are storing the values
     // tightly packed into the buffer to avoid buffer overruns.
@@ -401,6 +427,54 @@ std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size, const Textu
     return data;
 }
 
+bool Context::supportsPixelBuffers() const {
+    return pixelBuffer && pixelBuffer->mapBufferRange && pixelBuffer->unmapBuffer;
+}
+
+UniqueBuffer Context::createPixelBuffer(const Size size) {
+    assert(supportsPixelBuffers());
+    BufferID id = 0;
+    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+    UniqueBuffer result { std::move(id), { this } };
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, result.get()));
+    MBGL_CHECK_ERROR(glBufferData(GL_PIXEL_PACK_BUFFER, size.width * size.height * 4, nullptr, GL_STREAM_READ));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    return result;
+}
+
+void Context::readFramebufferAsync(const Size size, const BufferID buffer) {
+    assert(supportsPixelBuffers());
+    pixelStorePack = { 1 };
+
+    // With a pixel pack buffer bound, the pixels are copied into it, at the given offset.
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer));
+    MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+}
+
+util::ImageBuffer Context::readPixelBuffer(const BufferID buffer, const Size size, const bool flip) {
+    assert(supportsPixelBuffers());
+    const size_t stride = size.width * 4;
+    auto data = util::ImageBufferPool::getDefault().acquire(stride * size.height);
+
+    // Mapping the buffer waits for the copy into it to finish.
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer));
+    const auto* pixels = static_cast<const uint8_t*>(MBGL_CHECK_ERROR(
+        pixelBuffer->mapBufferRange(GL_PIXEL_PACK_BUFFER, 0, stride * size.height, GL_MAP_READ_BIT)));
+    if (!pixels) {
+        MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+        throw std::runtime_error("failed to map pixel buffer");
+    }
+
+    for (uint32_t y = 0; y < size.height; y++) {
+        std::memcpy(data.get() + y * stride, pixels + (flip ? size.height - 1 - y : y) * stride, stride);
+    }
+
+    MBGL_CHECK_ERROR(pixelBuffer->unmapBuffer(GL_PIXEL_PACK_BUFFER));
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+    return data;
+}
+
 #if not MBGL_USE_GLES2
 void Context::drawPixels(const Size size, const void* data, TextureFormat format) {
     pixelStoreUnpack = { 1 };
@@ -534,13 +608,89 @@ Context::createTexture(const Size size, const void* data, TextureFormat format,
     return obj;
 }
 
-void Context::updateTexture(
-    TextureID id, const Size size, const void* data, TextureFormat format, TextureUnit unit, TextureType type) {
+void Context::updateTexture(TextureID id,
+                            const Size size,
+                            const void* data,
+                            TextureFormat format,
+                            TextureUnit unit,
+                            TextureType type,
+                            std::size_t level) {
     activeTextureUnit = unit;
     texture[unit] = id;
-    MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLenum>(format), size.width,
+    const TimePoint start = Clock::now();
+    MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), static_cast<GLenum>(format), size.width,
                                   size.height, 0, static_cast<GLenum>(format), static_cast<GLenum>(type),
                                   data));
+    if (data) {
+        textureUploadTime += Clock::now() - start;
+        textureUploadBytes += size.area() * (format == TextureFormat::RGBA ? 4 : 1) *
+                              (type == TextureType::UnsignedByte ? 1 : 2);
+    }
+}
+
+void Context::updateSubTexture(TextureID id,
+                               const Point<uint32_t> offset,
+                               const Size size,
+                               const void* data,
+                               TextureFormat format,
+                               TextureUnit unit) {
+    activeTextureUnit = unit;
+    texture[unit] = id;
+    pixelStoreUnpack = { 1 };
+    const TimePoint start = Clock::now();
+    MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, offset.x, offset.y, size.width, size.height,
+                                     static_cast<GLenum>(format), GL_UNSIGNED_BYTE, data));
+    textureUploadTime += Clock::now() - start;
+    textureUploadBytes += size.area() * (format == TextureFormat::RGBA ? 4 : 1);
+}
+
+bool Context::supportsCompressedImageFormat(const CompressedImageFormat format) const {
+    switch (format) {
+    case CompressedImageFormat::BC1:
+        return supportsBC1Textures;
+    case CompressedImageFormat::ETC1:
+        return supportsETC1Textures || supportsETC2Textures;
+    }
+    return false;
+}
+
+Texture Context::createTexture(const CompressedImage& image, TextureUnit unit) {
+    return createTexture(image, {}, unit);
+}
+
+Texture Context::createTexture(const CompressedImage& image,
+                               const std::vector<CompressedImage>& mipmaps,
+                               TextureUnit unit) {
+    assert(supportsCompressedImageFormat(image.format));
+
+    // ETC1 images are also valid ETC2 images, which is the more widely supported format.
+    constexpr GLenum COMPRESSED_RGB_S3TC_DXT1_EXT = 0x83F0;
+    constexpr GLenum ETC1_RGB8_OES = 0x8D64;
+    constexpr GLenum COMPRESSED_RGB8_ETC2 = 0x9274;
+    const GLenum format = image.format == CompressedImageFormat::BC1
+        ? COMPRESSED_RGB_S3TC_DXT1_EXT
+        : (supportsETC2Textures ? COMPRESSED_RGB8_ETC2 : ETC1_RGB8_OES);
+
+    auto obj = createTexture();
+    activeTextureUnit = unit;
+    texture[unit] = obj;
+    const TimePoint start = Clock::now();
+    for (std::size_t level = 0; level <= mipmaps.size(); level++) {
+        const CompressedImage& levelImage = level == 0 ? image : mipmaps[level - 1];
+        assert(levelImage.format == image.format);
+        MBGL_CHECK_ERROR(glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), format,
+                                                levelImage.size.width, levelImage.size.height, 0,
+                                                static_cast<GLsizei>(levelImage.bytes()),
+                                                levelImage.data.get()));
+        textureUploadBytes += levelImage.bytes();
+    }
+    textureUploadTime += Clock::now() - start;
+
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    return { image.size, std::move(obj) };
 }
 
 void Context::bindTexture(Texture& obj,
@@ -595,6 +745,7 @@ void Context::reset() {
 void Context::setDirtyState() {
     // Note: does not set viewport/scissorTest/bindFramebuffer to dirty
     // since they are handled separately in the view object.
+    scissor.setDirty();
     stencilFunc.setDirty();
     stencilMask.setDirty();
     stencilTest.setDirty();
@@ -727,13 +878,46 @@ void Context::setColorMode(const ColorMode& color) {
 }
 
 void Context::draw(PrimitiveType primitiveType,
+                   IndexType indexType,
                    std::size_t indexOffset,
                    std::size_t indexLength) {
+    drawCalls++;
+    const std::size_t indexSize = indexType == IndexType::UnsignedInt ? sizeof(uint32_t) : sizeof(uint16_t);
     MBGL_CHECK_ERROR(glDrawElements(
         static_cast<GLenum>(primitiveType),
         static_cast<GLsizei>(indexLength),
-        GL_UNSIGNED_SHORT,
-        reinterpret_cast<GLvoid*>(sizeof(uint16_t) * indexOffset)));
+        static_cast<GLenum>(indexType),
+        reinterpret_cast<GLvoid*>(indexSize * indexOffset)));
+}
+
+std::size_t Context::getProgramBinds() const {
+    return program.getChanges();
+}
+
+std::size_t Context::getTextureBinds() const {
+    std::size_t binds = 0;
+    for (const auto& binding : texture) {
+        binds += binding.getChanges();
+    }
+    return binds;
+}
+
+std::size_t Context::getStateChanges() const {
+    std::size_t changes = stencilFunc.getChanges() + stencilMask.getChanges() +
+        stencilTest.getChanges() + stencilOp.getChanges() + depthRange.getChanges() +
+        depthMask.getChanges() + depthTest.getChanges() + depthFunc.getChanges() +
+        blend.getChanges() + blendEquation.getChanges() + blendFunc.getChanges() +
+        blendColor.getChanges() + colorMask.getChanges() + clearDepth.getChanges() +
+        clearColor.getChanges() + clearStencil.getChanges() + lineWidth.getChanges() +
+        bindRenderbuffer.getChanges() + activeTextureUnit.getChanges() +
+        bindFramebuffer.getChanges() + viewport.getChanges() + scissorTest.getChanges() +
+        scissor.getChanges() + vertexBuffer.getChanges() + bindVertexArray.getChanges() +
+        pixelStorePack.getChanges() + pixelStoreUnpack.getChanges();
+#if not MBGL_USE_GLES2
+    changes += pointSize.getChanges() + pixelZoom.getChanges() + rasterPos.getChanges() +
+        pixelTransferDepth.getChanges() + pixelTransferStencil.getChanges();
+#endif // MBGL_USE_GLES2
+    return changes;
 }
 
 void Context::performCleanup() {
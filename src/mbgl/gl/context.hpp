@@ -16,7 +16,9 @@
 #include <mbgl/gl/stencil_mode.hpp>
 #include <mbgl/gl/color_mode.hpp>
 #include <mbgl/util/noncopyable.hpp>
-
+#include <mbgl/util/image_buffer_pool.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/geometry.hpp>
 
 #include <functional>
 #include <memory>
@@ -25,6 +27,10 @@
 #include <string>
 
 namespace mbgl {
+
+class CompressedImage;
+enum class CompressedImageFormat : uint8_t;
+
 namespace gl {
 
 constexpr size_t TextureMax = 64;
@@ -34,6 +40,7 @@ namespace extension {
 class VertexArray;
 class Debugging;
 class ProgramBinary;
+class PixelBuffer;
 } // namespace extension
 
 class Context : private util::noncopyable {
@@ -62,6 +69,17 @@ public:
 
     template <class Vertex, class DrawMode>
     VertexBuffer<Vertex, DrawMode> createVertexBuffer(VertexVector<Vertex, DrawMode>&& v, const BufferUsage usage = BufferUsage::StaticDraw) {
+        vertexBufferVertices += v.vertexSize();
+        return VertexBuffer<Vertex, DrawMode> {
+            v.vertexSize(),
+            createVertexBuffer(v.data(), v.byteSize(), usage)
+        };
+    }
+
+    // Uploads vertices that are retained on the CPU side for later updates.
+    template <class Vertex, class DrawMode>
+    VertexBuffer<Vertex, DrawMode> createVertexBuffer(const VertexVector<Vertex, DrawMode>& v, const BufferUsage usage = BufferUsage::StaticDraw) {
+        vertexBufferVertices += v.vertexSize();
         return VertexBuffer<Vertex, DrawMode> {
             v.vertexSize(),
             createVertexBuffer(v.data(), v.byteSize(), usage)
@@ -74,17 +92,31 @@ public:
         updateVertexBuffer(buffer.buffer, v.data(), v.byteSize());
     }
 
+    template <class Vertex, class DrawMode>
+    void updateVertexBuffer(VertexBuffer<Vertex, DrawMode>& buffer, const VertexVector<Vertex, DrawMode>& v) {
+        assert(v.vertexSize() == buffer.vertexCount);
+        updateVertexBuffer(buffer.buffer, v.data(), v.byteSize());
+    }
+
+    // Uploads vertices whose format is only known at runtime, such as the attributes of paint
+    // properties. They don't add to vertexBufferVertices.
+    UniqueBuffer createVertexBuffer(const void* data, std::size_t size, const BufferUsage usage);
+    void updateVertexBuffer(UniqueBuffer& buffer, const void* data, std::size_t size);
+
     template <class DrawMode>
     IndexBuffer<DrawMode> createIndexBuffer(IndexVector<DrawMode>&& v, const BufferUsage usage = BufferUsage::StaticDraw) {
+        assert(v.indexType() == IndexType::UnsignedShort || supportsUint32Indices);
         return IndexBuffer<DrawMode> {
             v.indexSize(),
-            createIndexBuffer(v.data(), v.byteSize(), usage)
+            createIndexBuffer(v.data(), v.byteSize(), usage),
+            v.indexType()
         };
     }
     
     template <class DrawMode>
     void updateIndexBuffer(IndexBuffer<DrawMode>& buffer, IndexVector<DrawMode>&& v) {
         assert(v.indexSize() == buffer.indexCount);
+        assert(v.indexType() == buffer.type);
         updateIndexBuffer(buffer.buffer, v.data(), v.byteSize());
     }
 
@@ -115,6 +147,23 @@ public:
         return { size, readFramebuffer(size, format, flip) };
     }
 
+    // Whether the framebuffer can be read into pixel buffers, without waiting for the GPU.
+    bool supportsPixelBuffers() const;
+
+    // Creates a pixel buffer for an RGBA framebuffer of the given size.
+    UniqueBuffer createPixelBuffer(Size);
+
+    // Starts copying the bound RGBA framebuffer into a pixel buffer, and returns right away.
+    void readFramebufferAsync(Size, BufferID pixelBuffer);
+
+    // Waits for the copy into a pixel buffer to finish, and returns its pixels. They are flipped
+    // vertically while they are copied out of the buffer, rather than in a separate pass.
+    template <typename Image>
+    Image readPixelBuffer(BufferID pixelBuffer, const Size size, bool flip = true) {
+        static_assert(Image::channels == 4, "image format mismatch");
+        return { size, readPixelBuffer(pixelBuffer, size, flip) };
+    }
+
 #if not MBGL_USE_GLES2
     template <typename Image>
     void drawPixels(const Image& image) {
@@ -132,6 +181,20 @@ public:
         return { image.size, createTexture(image.size, image.data.get(), format, unit, type) };
     }
 
+    // Create a texture from an image and its mipmap chain, as generated by util::mipmaps().
+    template <typename Image>
+    Texture createTexture(const Image& image,
+                          const std::vector<Image>& mipmaps,
+                          TextureUnit unit = 0) {
+        auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
+        Texture obj = createTexture(image, unit);
+        for (std::size_t level = 0; level < mipmaps.size(); level++) {
+            updateTexture(obj.texture.get(), mipmaps[level].size, mipmaps[level].data.get(), format,
+                          unit, TextureType::UnsignedByte, level + 1);
+        }
+        return obj;
+    }
+
     template <typename Image>
     void updateTexture(Texture& obj,
                        const Image& image,
@@ -142,6 +205,24 @@ public:
         obj.size = image.size;
     }
 
+    // Replaces the pixels of a texture from `offset` on with those of a smaller image.
+    template <typename Image>
+    void updateTexture(Texture& obj,
+                       const Image& image,
+                       const Point<uint32_t>& offset,
+                       TextureUnit unit = 0) {
+        assert(offset.x + image.size.width <= obj.size.width);
+        assert(offset.y + image.size.height <= obj.size.height);
+        auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
+        updateSubTexture(obj.texture.get(), offset, image.size, image.data.get(), format, unit);
+    }
+
+    // Create a texture from a block compressed image, in a format the context supports.
+    Texture createTexture(const CompressedImage&, TextureUnit unit = 0);
+    Texture createTexture(const CompressedImage&,
+                          const std::vector<CompressedImage>& mipmaps,
+                          TextureUnit unit = 0);
+
     // Creates an empty texture with the specified dimensions.
     Texture createTexture(const Size size,
                           TextureFormat format = TextureFormat::RGBA,
@@ -172,6 +253,7 @@ public:
     void setColorMode(const ColorMode&);
 
     void draw(PrimitiveType,
+              IndexType,
               std::size_t indexOffset,
               std::size_t indexLength);
 
@@ -210,17 +292,23 @@ public:
 private:
     bool cleanupOnDestruction = true;
 
+    bool supportsBC1Textures = false;
+    bool supportsETC1Textures = false;
+    bool supportsETC2Textures = false;
+
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
 #if MBGL_HAS_BINARY_PROGRAMS
     std::unique_ptr<extension::ProgramBinary> programBinary;
 #endif
+    std::unique_ptr<extension::PixelBuffer> pixelBuffer;
 
 public:
     State<value::ActiveTextureUnit> activeTextureUnit;
     State<value::BindFramebuffer> bindFramebuffer;
     State<value::Viewport> viewport;
     State<value::ScissorTest> scissorTest;
+    State<value::Scissor> scissor;
     std::array<State<value::BindTexture>, 2> texture;
     State<value::Program> program;
     State<value::BindVertexBuffer> vertexBuffer;
@@ -239,7 +327,30 @@ public:
 #endif // MBGL_USE_GLES2
 
     bool supportsHalfFloatTextures = false;
-    
+
+    // Whether index buffers may hold 32-bit indices.
+    bool supportsUint32Indices = false;
+
+    bool supportsCompressedImageFormat(CompressedImageFormat) const;
+
+    // Time spent in uploading texture data, and how much of it was uploaded.
+    Duration textureUploadTime = Duration::zero();
+    std::size_t textureUploadBytes = 0;
+
+    // The size of the vertex and index buffers created, and the number of vertices of the
+    // former, whose paint attributes are counted in their bytes but not as more vertices.
+    std::size_t vertexBufferBytes = 0;
+    std::size_t vertexBufferVertices = 0;
+    std::size_t indexBufferBytes = 0;
+
+    // The number of draw calls issued.
+    std::size_t drawCalls = 0;
+
+    // The number of times a program or a texture was bound, and other state was changed.
+    std::size_t getProgramBinds() const;
+    std::size_t getTextureBinds() const;
+    std::size_t getStateChanges() const;
+
 private:
     State<value::StencilFunc> stencilFunc;
     State<value::StencilMask> stencilMask;
@@ -263,15 +374,15 @@ private:
     State<value::PointSize> pointSize;
 #endif // MBGL_USE_GLES2
 
-    UniqueBuffer createVertexBuffer(const void* data, std::size_t size, const BufferUsage usage);
-    void updateVertexBuffer(UniqueBuffer& buffer, const void* data, std::size_t size);
     UniqueBuffer createIndexBuffer(const void* data, std::size_t size, const BufferUsage usage);
     void updateIndexBuffer(UniqueBuffer& buffer, const void* data, std::size_t size);
     UniqueTexture createTexture(Size size, const void* data, TextureFormat, TextureUnit, TextureType);
-    void updateTexture(TextureID, Size size, const void* data, TextureFormat, TextureUnit, TextureType);
+    void updateTexture(TextureID, Size size, const void* data, TextureFormat, TextureUnit, TextureType, std::size_t level = 0);
+    void updateSubTexture(TextureID, Point<uint32_t> offset, Size size, const void* data, TextureFormat, TextureUnit);
     UniqueFramebuffer createFramebuffer();
     UniqueRenderbuffer createRenderbuffer(RenderbufferType, Size size);
-    std::unique_ptr<uint8_t[]> readFramebuffer(Size, TextureFormat, bool flip);
+    util::ImageBuffer readFramebuffer(Size, TextureFormat, bool flip);
+    util::ImageBuffer readPixelBuffer(BufferID, Size, bool flip);
 #if not MBGL_USE_GLES2
     void drawPixels(Size size, const void* data, TextureFormat);
 #endif // MBGL_USE_GLES2
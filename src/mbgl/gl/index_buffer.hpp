@@ -2,8 +2,11 @@
 
 #include <mbgl/gl/object.hpp>
 #include <mbgl/gl/draw_mode.hpp>
+#include <mbgl/gl/types.hpp>
 #include <mbgl/util/ignore.hpp>
 
+#include <cassert>
+#include <limits>
 #include <vector>
 
 namespace mbgl {
@@ -14,22 +17,53 @@ class IndexVector {
 public:
     static constexpr std::size_t groupSize = DrawMode::bufferGroupSize;
 
+    IndexVector() = default;
+
+    // 32-bit indices let a single segment span all of a bucket's vertices, but may only be
+    // used with a context that supports them.
+    explicit IndexVector(IndexType type_) : type(type_) {}
+
     template <class... Args>
     void emplace_back(Args&&... args) {
         static_assert(sizeof...(args) == groupSize, "wrong buffer element count");
-        util::ignore({(v.emplace_back(std::forward<Args>(args)), 0)...});
+        if (type == IndexType::UnsignedInt) {
+            util::ignore({(v32.emplace_back(static_cast<uint32_t>(args)), 0)...});
+        } else {
+            util::ignore({(v.emplace_back(static_cast<uint16_t>(args)), 0)...});
+        }
     }
 
-    std::size_t indexSize() const { return v.size(); }
-    std::size_t byteSize() const { return v.size() * sizeof(uint16_t); }
+    IndexType indexType() const { return type; }
 
-    bool empty() const { return v.empty(); }
-    void clear() { v.clear(); }
-    const uint16_t* data() const { return v.data(); }
-    const std::vector<uint16_t>& vector() const { return v; }
+    // The number of vertices a segment can span, so that all of its indices fit the index type.
+    std::size_t maxSegmentVertices() const {
+        return type == IndexType::UnsignedInt ? std::numeric_limits<uint32_t>::max()
+                                              : std::numeric_limits<uint16_t>::max();
+    }
+
+    std::size_t indexSize() const { return type == IndexType::UnsignedInt ? v32.size() : v.size(); }
+    std::size_t byteSize() const {
+        return type == IndexType::UnsignedInt ? v32.size() * sizeof(uint32_t) : v.size() * sizeof(uint16_t);
+    }
+
+    bool empty() const { return indexSize() == 0; }
+    void clear() { v.clear(); v32.clear(); }
+    const void* data() const {
+        return type == IndexType::UnsignedInt ? static_cast<const void*>(v32.data()) : v.data();
+    }
+    const std::vector<uint16_t>& vector() const {
+        assert(type == IndexType::UnsignedShort);
+        return v;
+    }
+    const std::vector<uint32_t>& vector32() const {
+        assert(type == IndexType::UnsignedInt);
+        return v32;
+    }
 
 private:
+    IndexType type = IndexType::UnsignedShort;
     std::vector<uint16_t> v;
+    std::vector<uint32_t> v32;
 };
 
 template <class DrawMode>
@@ -37,6 +71,7 @@ class IndexBuffer {
 public:
     std::size_t indexCount;
     UniqueBuffer buffer;
+    IndexType type = IndexType::UnsignedShort;
 };
 
 } // namespace gl
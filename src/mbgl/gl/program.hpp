@@ -135,6 +135,7 @@ public:
                         Attributes::toBindingArray(attributeLocations, attributeBindings));
 
         context.draw(drawMode.primitiveType,
+                     indexBuffer.type,
                      indexOffset,
                      indexLength);
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <tuple>
 
 namespace mbgl {
@@ -24,6 +25,7 @@ public:
         if (*this != value) {
             setCurrentValue(value);
             set(std::index_sequence_for<Args...>{});
+            changes++;
         }
     }
 
@@ -54,6 +56,11 @@ public:
         return dirty;
     }
 
+    // The number of OpenGL calls that set this piece of state.
+    std::size_t getChanges() const {
+        return changes;
+    }
+
 private:
     template <std::size_t... I>
     void set(std::index_sequence<I...>) {
@@ -63,6 +70,7 @@ private:
 private:
     typename T::Type currentValue = T::Default;
     bool dirty = true;
+    std::size_t changes = 0;
     const std::tuple<Args...> params;
 };
 
@@ -113,6 +113,13 @@ enum class UniformDataType : uint32_t {
     SamplerCube = 0x8B60,
 };
 
+// The type of the elements of an index buffer. 32-bit indices need OpenGL ES 2.0's
+// OES_element_index_uint extension, and are core in desktop OpenGL.
+enum class IndexType : uint32_t {
+    UnsignedShort = 0x1403,
+    UnsignedInt = 0x1405,
+};
+
 enum class BufferUsage : uint32_t {
     StreamDraw = 0x88E0,
     StaticDraw = 0x88E4,
@@ -183,6 +183,13 @@ struct Viewport {
     static Type Get();
 };
 
+struct Scissor {
+    using Type = Viewport::Type;
+    static const constexpr Type Default = { 0, 0, { 0, 0 } };
+    static void Set(const Type&);
+    static Type Get();
+};
+
 struct ScissorTest {
     using Type = bool;
     static const constexpr Type Default = false;
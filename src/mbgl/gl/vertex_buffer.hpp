@@ -27,6 +27,7 @@ public:
 
     bool empty() const { return v.empty(); }
     void clear() { v.clear(); }
+    Vertex& at(std::size_t n) { return v.at(n); }
     const Vertex* data() const { return v.data(); }
     const std::vector<Vertex>& vector() const { return v; }
 
@@ -771,6 +771,9 @@ void Map::Impl::onUpdate() {
         style->impl->getImageImpls(),
         style->impl->getSourceImpls(),
         style->impl->getLayerImpls(),
+        style->impl->getImageJournal(),
+        style->impl->getSourceJournal(),
+        style->impl->getLayerJournal(),
         annotationManager,
         prefetchZoomDelta,
         bool(stillImageRequest)
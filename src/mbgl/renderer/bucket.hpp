@@ -1,9 +1,14 @@
 #pragma once
 
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 
 #include <atomic>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
@@ -13,6 +18,14 @@ class Context;
 
 class RenderLayer;
 
+class FeatureVertexRange {
+public:
+    // Index of the feature within the bucket's source layer.
+    std::size_t index;
+    std::size_t start;
+    std::size_t end;
+};
+
 class Bucket : private util::noncopyable {
 public:
     Bucket() = default;
@@ -24,12 +37,44 @@ public:
     virtual void addFeature(const GeometryTileFeature&,
                             const GeometryCollection&) {};
 
+    // Called once all features have been added. Buckets that defer part of their layout until
+    // then, to spread it across several threads, complete it here.
+    virtual void finishFeatures() {}
+
     // As long as this bucket has a Prepare render pass, this function is getting called. Typically,
-    // this only happens once when the bucket is being rendered for the first time.
+    // this only happens once when the bucket is being rendered for the first time. The geometry
+    // buffers are created on the first upload only; the uploads that follow a paint-only update
+    // or a feature state change replace just the paint attribute buffers.
     virtual void upload(gl::Context&) = 0;
 
     virtual bool hasData() const = 0;
 
+    // Paint-only updates. For buckets whose geometry doesn't depend on paint properties, the
+    // worker records each feature's index along with `getVertexCount()` after adding it. On a
+    // paint-only style change, it replays these features through `populatePaintPropertyBinders`
+    // on a freshly created bucket, without laying out any geometry. `updatePaintPropertyBinders`
+    // then moves the resulting binders into the original bucket, so that only the paint
+    // attribute buffers are uploaded again.
+    virtual bool supportsPaintPropertyUpdates() const {
+        return false;
+    }
+
+    virtual std::size_t getVertexCount() const {
+        return 0;
+    }
+
+    virtual void populatePaintPropertyBinders(const GeometryTileFeature&, std::size_t) {}
+    virtual void updatePaintPropertyBinders(Bucket&) {}
+
+    // Feature state. For the same buckets, the worker also records the vertex ranges of all
+    // features with an ID. When the state of some of these features changes, their paint
+    // attributes are re-evaluated and patched in place, and only the paint attribute buffers
+    // are uploaded again.
+    virtual void updateFeatureState(const GeometryTileLayer&, const FeatureStates&) {}
+
+    std::string sourceLayer;
+    std::unordered_map<std::string, std::vector<FeatureVertexRange>> featureVertexRanges;
+
     virtual float getQueryRadius(const RenderLayer&) const {
         return 0;
     };
@@ -39,6 +84,26 @@ public:
     }
 
 protected:
+    template <class Binders>
+    bool updateFeatureVertices(std::map<std::string, Binders>& binders,
+                               const GeometryTileLayer& layer,
+                               const FeatureStates& states) const {
+        bool updated = false;
+        for (const auto& state : states) {
+            auto it = featureVertexRanges.find(state.first);
+            if (it == featureVertexRanges.end()) {
+                continue;
+            }
+            for (const auto& range : it->second) {
+                std::unique_ptr<GeometryTileFeature> feature = layer.getFeature(range.index);
+                for (auto& pair : binders) {
+                    updated = pair.second.updateVertexVectors(*feature, state.second, range.start, range.end) || updated;
+                }
+            }
+        }
+        return updated;
+    }
+
     std::atomic<bool> uploaded { false };
 };
 
@@ -1,15 +1,25 @@
 #pragma once
 
+#include <mbgl/gl/types.hpp>
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
 
 namespace mbgl {
 
+class Scheduler;
+
 class BucketParameters {
 public:
     const OverscaledTileID tileID;
     const MapMode mode;
     const float pixelRatio;
+    // The widest indices the rendering context supports.
+    const gl::IndexType indexType = gl::IndexType::UnsignedShort;
+    // Whether to upload the attributes of data-driven paint properties in compact types.
+    const bool compactVertexAttributes = false;
+    // Tessellates the polygons of fill and fill extrusion buckets on the threads of this scheduler
+    // as well, once all features are added, when set.
+    Scheduler* const tessellationScheduler = nullptr;
 };
 
 } // namespace mbgl
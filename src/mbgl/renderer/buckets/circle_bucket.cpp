@@ -18,13 +18,17 @@ CircleBucket::CircleBucket(const BucketParameters& parameters, const std::vector
             std::forward_as_tuple(layer->getID()),
             std::forward_as_tuple(
                 layer->as<RenderCircleLayer>()->evaluated,
-                parameters.tileID.overscaledZ));
+                parameters.tileID.overscaledZ,
+                parameters.compactVertexAttributes,
+                paintPropertyBinders));
     }
 }
 
 void CircleBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    indexBuffer = context.createIndexBuffer(std::move(triangles));
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        indexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -37,6 +41,32 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+bool CircleBucket::supportsPaintPropertyUpdates() const {
+    return true;
+}
+
+std::size_t CircleBucket::getVertexCount() const {
+    return vertices.vertexSize();
+}
+
+void CircleBucket::populatePaintPropertyBinders(const GeometryTileFeature& feature, std::size_t vertexCount) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertexCount);
+    }
+}
+
+void CircleBucket::updatePaintPropertyBinders(Bucket& other) {
+    assert(dynamic_cast<CircleBucket*>(&other));
+    paintPropertyBinders = std::move(static_cast<CircleBucket&>(other).paintPropertyBinders);
+    uploaded = false;
+}
+
+void CircleBucket::updateFeatureState(const GeometryTileLayer& layer, const FeatureStates& states) {
+    if (updateFeatureVertices(paintPropertyBinders, layer, states)) {
+        uploaded = false;
+    }
+}
+
 void CircleBucket::addFeature(const GeometryTileFeature& feature,
                               const GeometryCollection& geometry) {
     constexpr const uint16_t vertexLength = 4;
@@ -23,6 +23,12 @@ public:
 
     void upload(gl::Context&) override;
 
+    bool supportsPaintPropertyUpdates() const override;
+    std::size_t getVertexCount() const override;
+    void populatePaintPropertyBinders(const GeometryTileFeature&, std::size_t vertexCount) override;
+    void updatePaintPropertyBinders(Bucket&) override;
+    void updateFeatureState(const GeometryTileLayer&, const FeatureStates&) override;
+
     float getQueryRadius(const RenderLayer&) const override;
 
     gl::VertexVector<CircleLayoutVertex> vertices;
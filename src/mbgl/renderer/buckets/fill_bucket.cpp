@@ -4,6 +4,7 @@
 #include <mbgl/style/layers/fill_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_fill_layer.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/parallel.hpp>
 
 #include <mapbox/earcut.hpp>
 
@@ -27,14 +28,19 @@ using namespace style;
 
 struct GeometryTooLongException : std::exception {};
 
-FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<const RenderLayer*>& layers) {
+FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<const RenderLayer*>& layers)
+    : lines(parameters.indexType),
+      triangles(parameters.indexType),
+      tessellationScheduler(parameters.tessellationScheduler) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(
             std::piecewise_construct,
             std::forward_as_tuple(layer->getID()),
             std::forward_as_tuple(
                 layer->as<RenderFillLayer>()->evaluated,
-                parameters.tileID.overscaledZ));
+                parameters.tileID.overscaledZ,
+                parameters.compactVertexAttributes,
+                paintPropertyBinders));
     }
 }
 
@@ -44,11 +50,12 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
+        const std::size_t maxVertices = triangles.maxSegmentVertices();
         std::size_t totalVertices = 0;
 
         for (const auto& ring : polygon) {
             totalVertices += ring.size();
-            if (totalVertices > std::numeric_limits<uint16_t>::max())
+            if (totalVertices > maxVertices)
                 throw GeometryTooLongException();
         }
 
@@ -60,13 +67,13 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
             if (nVertices == 0)
                 continue;
 
-            if (lineSegments.empty() || lineSegments.back().vertexLength + nVertices > std::numeric_limits<uint16_t>::max()) {
+            if (lineSegments.empty() || lineSegments.back().vertexLength + nVertices > maxVertices) {
                 lineSegments.emplace_back(vertices.vertexSize(), lines.indexSize());
             }
 
             auto& lineSegment = lineSegments.back();
-            assert(lineSegment.vertexLength <= std::numeric_limits<uint16_t>::max());
-            uint16_t lineIndex = lineSegment.vertexLength;
+            assert(lineSegment.vertexLength <= maxVertices);
+            const std::size_t lineIndex = lineSegment.vertexLength;
 
             vertices.emplace_back(FillProgram::layoutVertex(ring[0]));
             lines.emplace_back(lineIndex + nVertices - 1, lineIndex);
@@ -80,38 +87,69 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
             lineSegment.indexLength += nVertices * 2;
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
+        PendingPolygon pending { std::move(polygon), startVertices, totalVertices };
+        if (tessellationScheduler) {
+            pendingPolygons.push_back(std::move(pending));
+        } else {
+            addTriangles(pending, mapbox::earcut(pending.polygon));
+        }
+    }
 
-        std::size_t nIndicies = indices.size();
-        assert(nIndicies % 3 == 0);
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertices.vertexSize());
+    }
+}
 
-        if (triangleSegments.empty() || triangleSegments.back().vertexLength + totalVertices > std::numeric_limits<uint16_t>::max()) {
-            triangleSegments.emplace_back(startVertices, triangles.indexSize());
-        }
+void FillBucket::finishFeatures() {
+    if (pendingPolygons.empty()) {
+        return;
+    }
 
-        auto& triangleSegment = triangleSegments.back();
-        assert(triangleSegment.vertexLength <= std::numeric_limits<uint16_t>::max());
-        uint16_t triangleIndex = triangleSegment.vertexLength;
+    std::size_t pendingVertices = 0;
+    for (const auto& pending : pendingPolygons) {
+        pendingVertices += pending.vertexCount;
+    }
 
-        for (uint32_t i = 0; i < nIndicies; i += 3) {
-            triangles.emplace_back(triangleIndex + indices[i],
-                                   triangleIndex + indices[i + 1],
-                                   triangleIndex + indices[i + 2]);
-        }
+    // Polygons are tessellated in any order, and their triangles added in feature order.
+    std::vector<std::vector<uint32_t>> indices(pendingPolygons.size());
+    util::parallelFor(*tessellationScheduler, pendingPolygons.size(), util::helpersFor(pendingVertices, 4096),
+                      [&] (std::size_t i) { indices[i] = mapbox::earcut(pendingPolygons[i].polygon); });
 
-        triangleSegment.vertexLength += totalVertices;
-        triangleSegment.indexLength += nIndicies;
+    for (std::size_t i = 0; i < pendingPolygons.size(); i++) {
+        addTriangles(pendingPolygons[i], indices[i]);
     }
+    pendingPolygons.clear();
+}
 
-    for (auto& pair : paintPropertyBinders) {
-        pair.second.populateVertexVectors(feature, vertices.vertexSize());
+void FillBucket::addTriangles(const PendingPolygon& pending, const std::vector<uint32_t>& indices) {
+    const std::size_t maxVertices = triangles.maxSegmentVertices();
+    std::size_t nIndicies = indices.size();
+    assert(nIndicies % 3 == 0);
+
+    if (triangleSegments.empty() || triangleSegments.back().vertexLength + pending.vertexCount > maxVertices) {
+        triangleSegments.emplace_back(pending.startVertex, triangles.indexSize());
+    }
+
+    auto& triangleSegment = triangleSegments.back();
+    assert(triangleSegment.vertexLength <= maxVertices);
+    const std::size_t triangleIndex = triangleSegment.vertexLength;
+
+    for (uint32_t i = 0; i < nIndicies; i += 3) {
+        triangles.emplace_back(triangleIndex + indices[i],
+                               triangleIndex + indices[i + 1],
+                               triangleIndex + indices[i + 2]);
     }
+
+    triangleSegment.vertexLength += pending.vertexCount;
+    triangleSegment.indexLength += nIndicies;
 }
 
 void FillBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    lineIndexBuffer = context.createIndexBuffer(std::move(lines));
-    triangleIndexBuffer = context.createIndexBuffer(std::move(triangles));
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        lineIndexBuffer = context.createIndexBuffer(std::move(lines));
+        triangleIndexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -124,6 +162,32 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !lineSegments.empty();
 }
 
+bool FillBucket::supportsPaintPropertyUpdates() const {
+    return true;
+}
+
+std::size_t FillBucket::getVertexCount() const {
+    return vertices.vertexSize();
+}
+
+void FillBucket::populatePaintPropertyBinders(const GeometryTileFeature& feature, std::size_t vertexCount) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertexCount);
+    }
+}
+
+void FillBucket::updatePaintPropertyBinders(Bucket& other) {
+    assert(dynamic_cast<FillBucket*>(&other));
+    paintPropertyBinders = std::move(static_cast<FillBucket&>(other).paintPropertyBinders);
+    uploaded = false;
+}
+
+void FillBucket::updateFeatureState(const GeometryTileLayer& layer, const FeatureStates& states) {
+    if (updateFeatureVertices(paintPropertyBinders, layer, states)) {
+        uploaded = false;
+    }
+}
+
 float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     if (!layer.is<RenderFillLayer>()) {
         return 0;
@@ -13,6 +13,7 @@
 namespace mbgl {
 
 class BucketParameters;
+class Scheduler;
 
 class FillBucket : public Bucket {
 public:
@@ -20,10 +21,17 @@ public:
 
     void addFeature(const GeometryTileFeature&,
                     const GeometryCollection&) override;
+    void finishFeatures() override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
 
+    bool supportsPaintPropertyUpdates() const override;
+    std::size_t getVertexCount() const override;
+    void populatePaintPropertyBinders(const GeometryTileFeature&, std::size_t vertexCount) override;
+    void updatePaintPropertyBinders(Bucket&) override;
+    void updateFeatureState(const GeometryTileLayer&, const FeatureStates&) override;
+
     float getQueryRadius(const RenderLayer&) const override;
 
     gl::VertexVector<FillLayoutVertex> vertices;
@@ -37,6 +45,19 @@ public:
     optional<gl::IndexBuffer<gl::Triangles>> triangleIndexBuffer;
 
     std::map<std::string, FillProgram::PaintPropertyBinders> paintPropertyBinders;
+
+private:
+    // A polygon whose outline has been added, but which hasn't been tessellated yet.
+    struct PendingPolygon {
+        GeometryCollection polygon;
+        std::size_t startVertex;
+        std::size_t vertexCount;
+    };
+
+    void addTriangles(const PendingPolygon&, const std::vector<uint32_t>& indices);
+
+    Scheduler* const tessellationScheduler;
+    std::vector<PendingPolygon> pendingPolygons;
 };
 
 } // namespace mbgl
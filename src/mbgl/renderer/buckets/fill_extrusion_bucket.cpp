@@ -5,6 +5,7 @@
 #include <mbgl/renderer/layers/render_fill_extrusion_layer.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/parallel.hpp>
 
 #include <mapbox/earcut.hpp>
 
@@ -34,13 +35,17 @@ using namespace style;
 
 struct GeometryTooLongException : std::exception {};
 
-FillExtrusionBucket::FillExtrusionBucket(const BucketParameters& parameters, const std::vector<const RenderLayer*>& layers) {
+FillExtrusionBucket::FillExtrusionBucket(const BucketParameters& parameters, const std::vector<const RenderLayer*>& layers)
+    : triangles(parameters.indexType),
+      tessellationScheduler(parameters.tessellationScheduler) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(std::piecewise_construct,
                                      std::forward_as_tuple(layer->getID()),
                                      std::forward_as_tuple(
                                                            layer->as<RenderFillExtrusionLayer>()->evaluated,
-                                                           parameters.tileID.overscaledZ));
+                                                           parameters.tileID.overscaledZ,
+                                                           parameters.compactVertexAttributes,
+                                                           paintPropertyBinders));
     }
 }
 
@@ -50,33 +55,24 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
+        const std::size_t maxVertices = triangles.maxSegmentVertices();
         std::size_t totalVertices = 0;
 
         for (const auto& ring : polygon) {
             totalVertices += ring.size();
-            if (totalVertices > std::numeric_limits<uint16_t>::max())
-                throw GeometryTooLongException();
         }
 
         if (totalVertices == 0) continue;
 
-        std::vector<uint32_t> flatIndices;
-        flatIndices.reserve(totalVertices);
+        // Each vertex of the roof, but the first, adds four wall vertices.
+        const std::size_t extrudedVertices = 5 * (totalVertices - 1) + 1;
+        if (extrudedVertices > maxVertices)
+            throw GeometryTooLongException();
 
-        std::size_t startVertices = vertices.vertexSize();
+        PendingPolygon pending { {}, vertices.vertexSize(), 0, {}, {} };
+        pending.roofIndices.reserve(totalVertices);
 
-        if (triangleSegments.empty() ||
-            triangleSegments.back().vertexLength + (5 * (totalVertices - 1) + 1) >
-                std::numeric_limits<uint16_t>::max()) {
-            triangleSegments.emplace_back(startVertices, triangles.indexSize());
-        }
-
-        auto& triangleSegment = triangleSegments.back();
-        assert(triangleSegment.vertexLength <= std::numeric_limits<uint16_t>::max());
-        uint16_t triangleIndex = triangleSegment.vertexLength;
-
-        assert(triangleIndex + (5 * (totalVertices - 1) + 1) <=
-               std::numeric_limits<uint16_t>::max());
+        uint32_t triangleIndex = 0;
 
         for (const auto& ring : polygon) {
             std::size_t nVertices = ring.size();
@@ -91,7 +87,7 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
 
                 vertices.emplace_back(
                     FillExtrusionProgram::layoutVertex(p1, 0, 0, 1, 1, edgeDistance));
-                flatIndices.emplace_back(triangleIndex);
+                pending.roofIndices.emplace_back(triangleIndex);
                 triangleIndex++;
 
                 if (i != 0) {
@@ -118,27 +114,22 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
                     vertices.emplace_back(
                         FillExtrusionProgram::layoutVertex(p2, perp.x, perp.y, 0, 1, edgeDistance));
 
-                    triangles.emplace_back(triangleIndex, triangleIndex + 1, triangleIndex + 2);
-                    triangles.emplace_back(triangleIndex + 1, triangleIndex + 2, triangleIndex + 3);
+                    pending.wallTriangles.insert(pending.wallTriangles.end(), {
+                        triangleIndex, triangleIndex + 1, triangleIndex + 2,
+                        triangleIndex + 1, triangleIndex + 2, triangleIndex + 3
+                    });
                     triangleIndex += 4;
-                    triangleSegment.vertexLength += 4;
-                    triangleSegment.indexLength += 6;
                 }
             }
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
-
-        std::size_t nIndices = indices.size();
-        assert(nIndices % 3 == 0);
-
-        for (uint32_t i = 0; i < nIndices; i += 3) {
-            triangles.emplace_back(flatIndices[indices[i]], flatIndices[indices[i + 1]],
-                                   flatIndices[indices[i + 2]]);
+        pending.vertexCount = triangleIndex;
+        pending.polygon = std::move(polygon);
+        if (tessellationScheduler) {
+            pendingPolygons.push_back(std::move(pending));
+        } else {
+            addTriangles(pending, mapbox::earcut(pending.polygon));
         }
-
-        triangleSegment.vertexLength += totalVertices;
-        triangleSegment.indexLength += nIndices;
     }
 
     for (auto& pair : paintPropertyBinders) {
@@ -146,9 +137,62 @@ void FillExtrusionBucket::addFeature(const GeometryTileFeature& feature,
     }
 }
 
+void FillExtrusionBucket::finishFeatures() {
+    if (pendingPolygons.empty()) {
+        return;
+    }
+
+    std::size_t pendingVertices = 0;
+    for (const auto& pending : pendingPolygons) {
+        pendingVertices += pending.roofIndices.size();
+    }
+
+    // Roofs are tessellated in any order, and their triangles added in feature order.
+    std::vector<std::vector<uint32_t>> indices(pendingPolygons.size());
+    util::parallelFor(*tessellationScheduler, pendingPolygons.size(), util::helpersFor(pendingVertices, 4096),
+                      [&] (std::size_t i) { indices[i] = mapbox::earcut(pendingPolygons[i].polygon); });
+
+    for (std::size_t i = 0; i < pendingPolygons.size(); i++) {
+        addTriangles(pendingPolygons[i], indices[i]);
+    }
+    pendingPolygons.clear();
+}
+
+void FillExtrusionBucket::addTriangles(const PendingPolygon& pending, const std::vector<uint32_t>& indices) {
+    const std::size_t maxVertices = triangles.maxSegmentVertices();
+    std::size_t nIndices = indices.size();
+    assert(nIndices % 3 == 0);
+
+    if (triangleSegments.empty() ||
+        triangleSegments.back().vertexLength + pending.vertexCount > maxVertices) {
+        triangleSegments.emplace_back(pending.startVertex, triangles.indexSize());
+    }
+
+    auto& triangleSegment = triangleSegments.back();
+    assert(triangleSegment.vertexLength + pending.vertexCount <= maxVertices);
+    const std::size_t triangleIndex = triangleSegment.vertexLength;
+
+    const auto& walls = pending.wallTriangles;
+    for (std::size_t i = 0; i < walls.size(); i += 3) {
+        triangles.emplace_back(triangleIndex + walls[i], triangleIndex + walls[i + 1],
+                               triangleIndex + walls[i + 2]);
+    }
+
+    const auto& roof = pending.roofIndices;
+    for (uint32_t i = 0; i < nIndices; i += 3) {
+        triangles.emplace_back(triangleIndex + roof[indices[i]], triangleIndex + roof[indices[i + 1]],
+                               triangleIndex + roof[indices[i + 2]]);
+    }
+
+    triangleSegment.vertexLength += pending.vertexCount;
+    triangleSegment.indexLength += walls.size() + nIndices;
+}
+
 void FillExtrusionBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    indexBuffer = context.createIndexBuffer(std::move(triangles));
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        indexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -161,6 +205,32 @@ bool FillExtrusionBucket::hasData() const {
     return !triangleSegments.empty();
 }
 
+bool FillExtrusionBucket::supportsPaintPropertyUpdates() const {
+    return true;
+}
+
+std::size_t FillExtrusionBucket::getVertexCount() const {
+    return vertices.vertexSize();
+}
+
+void FillExtrusionBucket::populatePaintPropertyBinders(const GeometryTileFeature& feature, std::size_t vertexCount) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertexCount);
+    }
+}
+
+void FillExtrusionBucket::updatePaintPropertyBinders(Bucket& other) {
+    assert(dynamic_cast<FillExtrusionBucket*>(&other));
+    paintPropertyBinders = std::move(static_cast<FillExtrusionBucket&>(other).paintPropertyBinders);
+    uploaded = false;
+}
+
+void FillExtrusionBucket::updateFeatureState(const GeometryTileLayer& layer, const FeatureStates& states) {
+    if (updateFeatureVertices(paintPropertyBinders, layer, states)) {
+        uploaded = false;
+    }
+}
+
 float FillExtrusionBucket::getQueryRadius(const RenderLayer& layer) const {
     if (!layer.is<RenderFillExtrusionLayer>()) {
         return 0;
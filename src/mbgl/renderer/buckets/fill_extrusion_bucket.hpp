@@ -11,6 +11,7 @@
 namespace mbgl {
 
 class BucketParameters;
+class Scheduler;
 
 class FillExtrusionBucket : public Bucket {
 public:
@@ -18,10 +19,17 @@ public:
 
     void addFeature(const GeometryTileFeature&,
                     const GeometryCollection&) override;
+    void finishFeatures() override;
     bool hasData() const override;
 
     void upload(gl::Context&) override;
 
+    bool supportsPaintPropertyUpdates() const override;
+    std::size_t getVertexCount() const override;
+    void populatePaintPropertyBinders(const GeometryTileFeature&, std::size_t vertexCount) override;
+    void updatePaintPropertyBinders(Bucket&) override;
+    void updateFeatureState(const GeometryTileLayer&, const FeatureStates&) override;
+
     float getQueryRadius(const RenderLayer&) const override;
 
     gl::VertexVector<FillExtrusionLayoutVertex> vertices;
@@ -32,6 +40,22 @@ public:
     optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
     
     std::unordered_map<std::string, FillExtrusionProgram::PaintPropertyBinders> paintPropertyBinders;
+
+private:
+    // A polygon whose roof and wall vertices have been added, but whose roof hasn't been
+    // tessellated yet. Indices are relative to the first vertex of the polygon.
+    struct PendingPolygon {
+        GeometryCollection polygon;
+        std::size_t startVertex;
+        std::size_t vertexCount;
+        std::vector<uint32_t> roofIndices;
+        std::vector<uint32_t> wallTriangles;
+    };
+
+    void addTriangles(const PendingPolygon&, const std::vector<uint32_t>& indices);
+
+    Scheduler* const tessellationScheduler;
+    std::vector<PendingPolygon> pendingPolygons;
 };
 
 } // namespace mbgl
@@ -18,13 +18,17 @@ HeatmapBucket::HeatmapBucket(const BucketParameters& parameters, const std::vect
             std::forward_as_tuple(layer->getID()),
             std::forward_as_tuple(
                 layer->as<RenderHeatmapLayer>()->evaluated,
-                parameters.tileID.overscaledZ));
+                parameters.tileID.overscaledZ,
+                parameters.compactVertexAttributes,
+                paintPropertyBinders));
     }
 }
 
 void HeatmapBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    indexBuffer = context.createIndexBuffer(std::move(triangles));
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        indexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -37,6 +41,32 @@ bool HeatmapBucket::hasData() const {
     return !segments.empty();
 }
 
+bool HeatmapBucket::supportsPaintPropertyUpdates() const {
+    return true;
+}
+
+std::size_t HeatmapBucket::getVertexCount() const {
+    return vertices.vertexSize();
+}
+
+void HeatmapBucket::populatePaintPropertyBinders(const GeometryTileFeature& feature, std::size_t vertexCount) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertexCount);
+    }
+}
+
+void HeatmapBucket::updatePaintPropertyBinders(Bucket& other) {
+    assert(dynamic_cast<HeatmapBucket*>(&other));
+    paintPropertyBinders = std::move(static_cast<HeatmapBucket&>(other).paintPropertyBinders);
+    uploaded = false;
+}
+
+void HeatmapBucket::updateFeatureState(const GeometryTileLayer& layer, const FeatureStates& states) {
+    if (updateFeatureVertices(paintPropertyBinders, layer, states)) {
+        uploaded = false;
+    }
+}
+
 void HeatmapBucket::addFeature(const GeometryTileFeature& feature,
                               const GeometryCollection& geometry) {
     constexpr const uint16_t vertexLength = 4;
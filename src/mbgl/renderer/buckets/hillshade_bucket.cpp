@@ -8,6 +8,25 @@ namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+// Uploads only the regions of an image that changed since it was uploaded to `texture`.
+void updateRegions(gl::Context& context,
+                   gl::Texture& texture,
+                   const PremultipliedImage& image,
+                   const std::vector<Rect<uint32_t>>& regions) {
+    for (const auto& region : regions) {
+        if (!region.hasArea()) {
+            continue;
+        }
+        PremultipliedImage pixels({ region.w, region.h });
+        PremultipliedImage::copy(image, pixels, { region.x, region.y }, { 0, 0 }, pixels.size);
+        context.updateTexture(texture, pixels, { region.x, region.y });
+    }
+}
+
+} // namespace
+
 HillshadeBucket::HillshadeBucket(PremultipliedImage&& image_, Tileset::DEMEncoding encoding): demdata(image_, encoding) {
 }
 
@@ -22,16 +41,50 @@ DEMData& HillshadeBucket::getDEMData() {
     return demdata;
 }
 
+void HillshadeBucket::prepare(uint8_t zoom_, uint8_t maxzoom_) {
+    zoom = zoom_;
+    maxzoom = maxzoom_;
+    slopes = demdata.prepareHillshade(zoom, maxzoom);
+}
+
+void HillshadeBucket::backfillBorder(const HillshadeBucket& borderBucket, int8_t dx, int8_t dy) {
+    const Rect<uint32_t> region = demdata.backfillBorder(borderBucket.demdata, dx, dy);
+    if (slopes.valid()) {
+        // Only the slopes along the backfilled border change.
+        changedRegions.push_back(demdata.prepareHillshadeEdge(slopes, dx, dy, zoom, maxzoom));
+    } else {
+        changedRegions.push_back(region);
+    }
+    prepared = false;
+    uploaded = false;
+}
+
 void HillshadeBucket::upload(gl::Context& context) {
     if (!hasData()) {
         return;
     }
 
 
-    const PremultipliedImage* image = demdata.getImage();
-    dem = context.createTexture(*image);
+    if (slopes.valid()) {
+        // The DEM itself is only needed on the GPU for the prepare pass.
+        if (!texture) {
+            texture = context.createTexture(slopes);
+        } else {
+            updateRegions(context, *texture, slopes, changedRegions);
+        }
+        prepared = true;
+    } else {
+        const PremultipliedImage& image = *demdata.getImage();
+        if (!dem) {
+            dem = context.createTexture(image);
+        } else {
+            updateRegions(context, *dem, image, changedRegions);
+        }
+    }
+    changedRegions.clear();
 
-    if (!segments.empty()) {
+    // Buffers are only uploaded again after setMask() cleared them.
+    if (!segments.empty() && !vertexBuffer) {
         vertexBuffer = context.createVertexBuffer(std::move(vertices));
         indexBuffer = context.createIndexBuffer(std::move(indices));
     }
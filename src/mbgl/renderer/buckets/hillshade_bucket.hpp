@@ -12,6 +12,9 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/optional.hpp>
+#include <mbgl/util/rect.hpp>
+
+#include <vector>
 
 namespace mbgl {
 
@@ -44,6 +47,18 @@ public:
         prepared = preparedState;
     }
 
+    // Computes the slopes on the CPU, so that the texture is uploaded prepared, instead of being
+    // rendered from the DEM by the hillshade_prepare pass.
+    void prepare(uint8_t zoom, uint8_t maxzoom);
+
+    // Backfills the border of the DEM toward the neighboring tile at `dx`, `dy` from its DEM, and
+    // queues the pixels that changed for uploading.
+    void backfillBorder(const HillshadeBucket&, int8_t dx, int8_t dy);
+
+    bool hasSlopes() const {
+        return slopes.valid();
+    }
+
     // Raster-DEM Tile Sources use the default buffers from Painter
     gl::VertexVector<HillshadeLayoutVertex> vertices;
     gl::IndexVector<gl::Triangles> indices;
@@ -54,6 +69,14 @@ public:
 private: 
     DEMData demdata;
     bool prepared = false;
+
+    PremultipliedImage slopes;
+    uint8_t zoom = 0;
+    uint8_t maxzoom = 0;
+
+    // Regions of the DEM, or of the slopes if they were prepared on the CPU, that changed since
+    // they were uploaded.
+    std::vector<Rect<uint32_t>> changedRegions;
 };
 
 } // namespace mbgl
@@ -15,6 +15,7 @@ LineBucket::LineBucket(const BucketParameters& parameters,
                        const std::vector<const RenderLayer*>& layers,
                        const style::LineLayoutProperties::Unevaluated& layout_)
     : layout(layout_.evaluate(PropertyEvaluationParameters(parameters.tileID.overscaledZ))),
+      triangles(parameters.indexType),
       overscaling(parameters.tileID.overscaleFactor()),
       zoom(parameters.tileID.overscaledZ) {
     for (const auto& layer : layers) {
@@ -23,7 +24,9 @@ LineBucket::LineBucket(const BucketParameters& parameters,
             std::forward_as_tuple(layer->getID()),
             std::forward_as_tuple(
                 layer->as<RenderLineLayer>()->evaluated,
-                parameters.tileID.overscaledZ));
+                parameters.tileID.overscaledZ,
+                parameters.compactVertexAttributes,
+                paintPropertyBinders));
     }
 }
 
@@ -374,13 +377,14 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates, const Geome
     const std::size_t endVertex = vertices.vertexSize();
     const std::size_t vertexCount = endVertex - startVertex;
 
-    if (segments.empty() || segments.back().vertexLength + vertexCount > std::numeric_limits<uint16_t>::max()) {
+    const std::size_t maxVertices = triangles.maxSegmentVertices();
+    if (segments.empty() || segments.back().vertexLength + vertexCount > maxVertices) {
         segments.emplace_back(startVertex, triangles.indexSize());
     }
 
     auto& segment = segments.back();
-    assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
-    uint16_t index = segment.vertexLength;
+    assert(segment.vertexLength <= maxVertices);
+    const std::size_t index = segment.vertexLength;
 
     for (const auto& triangle : triangleStore) {
         triangles.emplace_back(index + triangle.a, index + triangle.b, index + triangle.c);
@@ -451,8 +455,10 @@ void LineBucket::addPieSliceVertex(const GeometryCoordinate& currentVertex,
 }
 
 void LineBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    indexBuffer = context.createIndexBuffer(std::move(triangles));
+    if (!vertexBuffer) {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+        indexBuffer = context.createIndexBuffer(std::move(triangles));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -465,6 +471,32 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+bool LineBucket::supportsPaintPropertyUpdates() const {
+    return true;
+}
+
+std::size_t LineBucket::getVertexCount() const {
+    return vertices.vertexSize();
+}
+
+void LineBucket::populatePaintPropertyBinders(const GeometryTileFeature& feature, std::size_t vertexCount) {
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.populateVertexVectors(feature, vertexCount);
+    }
+}
+
+void LineBucket::updatePaintPropertyBinders(Bucket& other) {
+    assert(dynamic_cast<LineBucket*>(&other));
+    paintPropertyBinders = std::move(static_cast<LineBucket&>(other).paintPropertyBinders);
+    uploaded = false;
+}
+
+void LineBucket::updateFeatureState(const GeometryTileLayer& layer, const FeatureStates& states) {
+    if (updateFeatureVertices(paintPropertyBinders, layer, states)) {
+        uploaded = false;
+    }
+}
+
 template <class Property>
 static float get(const RenderLineLayer& layer, const std::map<std::string, LineProgram::PaintPropertyBinders>& paintPropertyBinders) {
     auto it = paintPropertyBinders.find(layer.getID());
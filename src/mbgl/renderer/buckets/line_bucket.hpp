@@ -27,6 +27,12 @@ public:
 
     void upload(gl::Context&) override;
 
+    bool supportsPaintPropertyUpdates() const override;
+    std::size_t getVertexCount() const override;
+    void populatePaintPropertyBinders(const GeometryTileFeature&, std::size_t vertexCount) override;
+    void updatePaintPropertyBinders(Bucket&) override;
+    void updateFeatureState(const GeometryTileLayer&, const FeatureStates&) override;
+
     float getQueryRadius(const RenderLayer&) const override;
 
     style::LineLayoutProperties::PossiblyEvaluated layout;
@@ -44,8 +50,8 @@ private:
     void addGeometry(const GeometryCoordinates&, const GeometryTileFeature&);
 
     struct TriangleElement {
-        TriangleElement(uint16_t a_, uint16_t b_, uint16_t c_) : a(a_), b(b_), c(c_) {}
-        uint16_t a, b, c;
+        TriangleElement(uint32_t a_, uint32_t b_, uint32_t c_) : a(a_), b(b_), c(c_) {}
+        uint32_t a, b, c;
     };
     void addCurrentVertex(const GeometryCoordinate& currentVertex, double& distance,
             const Point<double>& normal, double endLeft, double endRight, bool round,
@@ -7,7 +7,8 @@ namespace mbgl {
 
 using namespace style;
 
-RasterBucket::RasterBucket(PremultipliedImage&& image_) {
+RasterBucket::RasterBucket(PremultipliedImage&& image_, std::vector<PremultipliedImage>&& mipmaps_)
+    : mipmaps(std::move(mipmaps_)) {
     image = std::make_shared<PremultipliedImage>(std::move(image_));
 }
 
@@ -15,12 +16,18 @@ RasterBucket::RasterBucket(std::shared_ptr<PremultipliedImage> image_): image(im
 
 }
 
+RasterBucket::RasterBucket(CompressedImage&& image_, std::vector<CompressedImage>&& mipmaps_)
+    : compressedMipmaps(std::move(mipmaps_)) {
+    compressedImage = std::make_shared<CompressedImage>(std::move(image_));
+}
+
 void RasterBucket::upload(gl::Context& context) {
     if (!hasData()) {
         return;
     }
     if (!texture) {
-        texture = context.createTexture(*image);
+        texture = compressedImage ? context.createTexture(*compressedImage, compressedMipmaps)
+                                  : context.createTexture(*image, mipmaps);
     }
     if (!segments.empty()) {
         vertexBuffer = context.createVertexBuffer(std::move(vertices));
@@ -41,6 +48,9 @@ void RasterBucket::clear() {
 
 void RasterBucket::setImage(std::shared_ptr<PremultipliedImage> image_) {
     image = std::move(image_);
+    compressedImage = {};
+    mipmaps.clear();
+    compressedMipmaps.clear();
     texture = {};
     uploaded = false;
 }
@@ -103,8 +113,31 @@ void RasterBucket::setMask(TileMask&& mask_) {
     }
 }
 
+std::size_t RasterBucket::textureBytes() const {
+    if (!texture) {
+        return 0;
+    }
+    std::size_t bytes = 0;
+    if (compressedImage) {
+        bytes += compressedImage->bytes();
+        for (const auto& level : compressedMipmaps) {
+            bytes += level.bytes();
+        }
+    } else {
+        bytes += image->bytes();
+        for (const auto& level : mipmaps) {
+            bytes += level.bytes();
+        }
+    }
+    return bytes;
+}
+
+bool RasterBucket::hasMipmaps() const {
+    return compressedImage ? !compressedMipmaps.empty() : !mipmaps.empty();
+}
+
 bool RasterBucket::hasData() const {
-    return !!image;
+    return image || compressedImage;
 }
 
 } // namespace mbgl
@@ -6,6 +6,7 @@
 #include <mbgl/programs/raster_program.hpp>
 #include <mbgl/renderer/bucket.hpp>
 #include <mbgl/renderer/tile_mask.hpp>
+#include <mbgl/util/compressed_image.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/optional.hpp>
@@ -14,8 +15,9 @@ namespace mbgl {
 
 class RasterBucket : public Bucket {
 public:
-    RasterBucket(PremultipliedImage&&);
+    RasterBucket(PremultipliedImage&&, std::vector<PremultipliedImage>&& mipmaps = {});
     RasterBucket(std::shared_ptr<PremultipliedImage>);
+    RasterBucket(CompressedImage&&, std::vector<CompressedImage>&& mipmaps = {});
 
     void upload(gl::Context&) override;
     bool hasData() const override;
@@ -24,7 +26,18 @@ public:
     void setImage(std::shared_ptr<PremultipliedImage>);
     void setMask(TileMask&&);
 
+    // The size of the texture in GPU memory, including its mipmaps.
+    std::size_t textureBytes() const;
+
+    // Whether the texture has a complete mipmap chain, and can be sampled with mipmapping.
+    bool hasMipmaps() const;
+
     std::shared_ptr<PremultipliedImage> image;
+    std::shared_ptr<CompressedImage> compressedImage;
+    // Either set is generated on the worker thread, so that mipmaps don't need to be generated
+    // by the GPU on the render thread.
+    std::vector<PremultipliedImage> mipmaps;
+    std::vector<CompressedImage> compressedMipmaps;
     optional<gl::Texture> texture;
     TileMask mask{ { 0, 0, 0 } };
 
@@ -2,11 +2,15 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace mbgl {
 
 class RenderLayer;
 
+// Returns a key that is equal for layers that can share a bucket.
+std::string layoutKey(const RenderLayer&);
+
 std::vector<std::vector<const RenderLayer*>> groupByLayout(const std::vector<std::unique_ptr<RenderLayer>>&);
 
 } // namespace mbgl
@@ -7,6 +7,10 @@
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/programs/background_program.hpp>
 #include <mbgl/util/tile_cover.hpp>
+#include <mbgl/util/mat4.hpp>
+
+#include <algorithm>
+#include <limits>
 
 namespace mbgl {
 
@@ -85,27 +89,47 @@ void RenderBackgroundLayer::render(PaintParameters& parameters, RenderSource*) {
             );
         }
     } else {
-        for (const auto& tileID : util::tileCover(parameters.state, parameters.state.getIntegerZoom())) {
-            parameters.programs.background.draw(
-                parameters.context,
-                gl::Triangles(),
-                parameters.depthModeForSublayer(0, gl::DepthMode::ReadOnly),
-                gl::StencilMode::disabled(),
-                parameters.colorModeForRenderPass(),
-                BackgroundProgram::UniformValues {
-                    uniforms::u_matrix::Value{ parameters.matrixForTile(tileID) },
-                    uniforms::u_color::Value{ evaluated.get<BackgroundColor>() },
-                    uniforms::u_opacity::Value{ evaluated.get<BackgroundOpacity>() },
-                },
-                parameters.staticData.tileVertexBuffer,
-                parameters.staticData.quadTriangleIndexBuffer,
-                parameters.staticData.tileTriangleSegments,
-                paintAttributeData,
-                properties,
-                parameters.state.getZoom(),
-                getID()
-            );
+        const uint8_t z = parameters.state.getIntegerZoom();
+        const auto tileIDs = util::tileCover(parameters.state, z);
+        if (tileIDs.empty()) {
+            return;
+        }
+
+        // Every tile is drawn with the same color, so instead of drawing the tiles one by one, the
+        // tile quad is stretched over their bounding box in a single draw. The visible part of the
+        // bounding box is the visible part of the tiles.
+        int64_t minX = std::numeric_limits<int64_t>::max(), minY = minX;
+        int64_t maxX = std::numeric_limits<int64_t>::min(), maxY = maxX;
+        for (const auto& tileID : tileIDs) {
+            const int64_t x = int64_t(tileID.wrap) * (1ll << z) + tileID.canonical.x;
+            minX = std::min(minX, x);
+            maxX = std::max(maxX, x);
+            minY = std::min<int64_t>(minY, tileID.canonical.y);
+            maxY = std::max<int64_t>(maxY, tileID.canonical.y);
         }
+
+        mat4 matrix = parameters.matrixForTile(UnwrappedTileID(z, minX, minY));
+        matrix::scale(matrix, matrix, maxX - minX + 1, maxY - minY + 1, 1);
+
+        parameters.programs.background.draw(
+            parameters.context,
+            gl::Triangles(),
+            parameters.depthModeForSublayer(0, gl::DepthMode::ReadOnly),
+            gl::StencilMode::disabled(),
+            parameters.colorModeForRenderPass(),
+            BackgroundProgram::UniformValues {
+                uniforms::u_matrix::Value{ matrix },
+                uniforms::u_color::Value{ evaluated.get<BackgroundColor>() },
+                uniforms::u_opacity::Value{ evaluated.get<BackgroundOpacity>() },
+            },
+            parameters.staticData.tileVertexBuffer,
+            parameters.staticData.quadTriangleIndexBuffer,
+            parameters.staticData.tileTriangleSegments,
+            paintAttributeData,
+            properties,
+            parameters.state.getZoom(),
+            getID()
+        );
     }
 }
 
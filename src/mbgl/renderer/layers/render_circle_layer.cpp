@@ -59,37 +59,46 @@ void RenderCircleLayer::render(PaintParameters& parameters, RenderSource*) {
         assert(dynamic_cast<CircleBucket*>(tile.tile.getBucket(*baseImpl)));
         CircleBucket& bucket = *reinterpret_cast<CircleBucket*>(tile.tile.getBucket(*baseImpl));
 
-        parameters.programs.circle.get(evaluated).draw(
-            parameters.context,
-            gl::Triangles(),
-            parameters.depthModeForSublayer(0, gl::DepthMode::ReadOnly),
-            parameters.mapMode != MapMode::Continuous
-                ? parameters.stencilModeForClipping(tile.clip)
-                : gl::StencilMode::disabled(),
-            parameters.colorModeForRenderPass(),
-            CircleProgram::UniformValues {
-                uniforms::u_matrix::Value{
-                    tile.translatedMatrix(evaluated.get<CircleTranslate>(),
-                                          evaluated.get<CircleTranslateAnchor>(),
-                                          parameters.state)
+        auto draw = [&] {
+            parameters.programs.circle.get(evaluated).draw(
+                parameters.context,
+                gl::Triangles(),
+                parameters.depthModeForSublayer(0, gl::DepthMode::ReadOnly),
+                parameters.mapMode != MapMode::Continuous
+                    ? parameters.stencilModeForClipping(tile.clip)
+                    : gl::StencilMode::disabled(),
+                parameters.colorModeForRenderPass(),
+                CircleProgram::UniformValues {
+                    uniforms::u_matrix::Value{
+                        tile.translatedMatrix(evaluated.get<CircleTranslate>(),
+                                              evaluated.get<CircleTranslateAnchor>(),
+                                              parameters.state)
+                    },
+                    uniforms::u_scale_with_map::Value{ scaleWithMap },
+                    uniforms::u_extrude_scale::Value{ pitchWithMap
+                        ? std::array<float, 2> {{
+                            tile.id.pixelsToTileUnits(1, parameters.state.getZoom()),
+                            tile.id.pixelsToTileUnits(1, parameters.state.getZoom()) }}
+                        : parameters.pixelsToGLUnits },
+                    uniforms::u_camera_to_center_distance::Value{ parameters.state.getCameraToCenterDistance() },
+                    uniforms::u_pitch_with_map::Value{ pitchWithMap }
                 },
-                uniforms::u_scale_with_map::Value{ scaleWithMap },
-                uniforms::u_extrude_scale::Value{ pitchWithMap
-                    ? std::array<float, 2> {{
-                        tile.id.pixelsToTileUnits(1, parameters.state.getZoom()),
-                        tile.id.pixelsToTileUnits(1, parameters.state.getZoom()) }}
-                    : parameters.pixelsToGLUnits },
-                uniforms::u_camera_to_center_distance::Value{ parameters.state.getCameraToCenterDistance() },
-                uniforms::u_pitch_with_map::Value{ pitchWithMap }
-            },
-            *bucket.vertexBuffer,
-            *bucket.indexBuffer,
-            bucket.segments,
-            bucket.paintPropertyBinders.at(getID()),
-            evaluated,
-            parameters.state.getZoom(),
-            getID()
-        );
+                *bucket.vertexBuffer,
+                *bucket.indexBuffer,
+                bucket.segments,
+                bucket.paintPropertyBinders.at(getID()),
+                evaluated,
+                parameters.state.getZoom(),
+                getID()
+            );
+        };
+
+        // As with the stencil buffer, circles are only clipped to their tiles in still images.
+        if (parameters.mapMode != MapMode::Continuous) {
+            parameters.drawClipped(tile, draw);
+        } else {
+            draw();
+        }
     }
 }
 
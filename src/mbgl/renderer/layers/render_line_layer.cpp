@@ -62,21 +62,23 @@ void RenderLineLayer::render(PaintParameters& parameters, RenderSource*) {
         LineBucket& bucket = *reinterpret_cast<LineBucket*>(tile.tile.getBucket(*baseImpl));
 
         auto draw = [&] (auto& program, auto&& uniformValues) {
-            program.get(evaluated).draw(
-                parameters.context,
-                gl::Triangles(),
-                parameters.depthModeForSublayer(0, gl::DepthMode::ReadOnly),
-                parameters.stencilModeForClipping(tile.clip),
-                parameters.colorModeForRenderPass(),
-                std::move(uniformValues),
-                *bucket.vertexBuffer,
-                *bucket.indexBuffer,
-                bucket.segments,
-                bucket.paintPropertyBinders.at(getID()),
-                evaluated,
-                parameters.state.getZoom(),
-                getID()
-            );
+            parameters.drawClipped(tile, [&] {
+                program.get(evaluated).draw(
+                    parameters.context,
+                    gl::Triangles(),
+                    parameters.depthModeForSublayer(0, gl::DepthMode::ReadOnly),
+                    parameters.stencilModeForClipping(tile.clip),
+                    parameters.colorModeForRenderPass(),
+                    uniformValues,
+                    *bucket.vertexBuffer,
+                    *bucket.indexBuffer,
+                    bucket.segments,
+                    bucket.paintPropertyBinders.at(getID()),
+                    evaluated,
+                    parameters.state.getZoom(),
+                    getID()
+                );
+            });
         };
 
         if (!evaluated.get<LineDasharray>().from.empty()) {
@@ -131,9 +131,13 @@ void RenderRasterLayer::render(PaintParameters& parameters, RenderSource* source
             if (!bucket.hasData())
                 continue;
 
+            // Tiles drawn at fractional zoom levels, or in place of a missing parent, are
+            // minified, and sample a level of their mipmap chain instead of shimmering.
+            const auto mipmap = bucket.hasMipmaps() ? gl::TextureMipMap::Yes : gl::TextureMipMap::No;
+
             assert(bucket.texture);
-            parameters.context.bindTexture(*bucket.texture, 0, gl::TextureFilter::Linear);
-            parameters.context.bindTexture(*bucket.texture, 1, gl::TextureFilter::Linear);
+            parameters.context.bindTexture(*bucket.texture, 0, gl::TextureFilter::Linear, mipmap);
+            parameters.context.bindTexture(*bucket.texture, 1, gl::TextureFilter::Linear, mipmap);
 
             if (bucket.vertexBuffer && bucket.indexBuffer && !bucket.segments.empty()) {
                 // Draw only the parts of the tile that aren't drawn by another tile in the layer.
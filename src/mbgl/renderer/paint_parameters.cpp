@@ -2,6 +2,11 @@
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/renderer/render_static_data.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
+#include <mbgl/algorithm/update_tile_masks.hpp>
+
+#include <algorithm>
 
 namespace mbgl {
 
@@ -69,6 +74,10 @@ gl::DepthMode PaintParameters::depthModeFor3D(gl::DepthMode::Mask mask) const {
 }
 
 gl::StencilMode PaintParameters::stencilModeForClipping(const ClipID& id) const {
+    if (tileMaskClipping) {
+        return gl::StencilMode::disabled();
+    }
+
     return gl::StencilMode {
         gl::StencilMode::Equal { static_cast<uint32_t>(id.mask.to_ulong()) },
         static_cast<int32_t>(id.reference.to_ulong()),
@@ -79,6 +88,29 @@ gl::StencilMode PaintParameters::stencilModeForClipping(const ClipID& id) const
     };
 }
 
+void PaintParameters::updateClipping(std::vector<std::reference_wrapper<RenderTile>> renderTiles) {
+    if (!tileMaskClipping) {
+        clipIDGenerator.update(std::move(renderTiles));
+        return;
+    }
+
+    // Like clip IDs, masks only account for the tiles drawn by layers that are clipped, and not
+    // for those held on to for symbols.
+    renderTiles.erase(std::remove_if(renderTiles.begin(), renderTiles.end(),
+                                     [](const RenderTile& tile) { return !tile.needsClipping; }),
+                      renderTiles.end());
+    algorithm::updateTileMasks(std::move(renderTiles));
+}
+
+void PaintParameters::enableScissor(const gl::value::Scissor::Type& rect) {
+    context.scissor = rect;
+    context.scissorTest = true;
+}
+
+void PaintParameters::disableScissor() {
+    context.scissorTest = false;
+}
+
 gl::ColorMode PaintParameters::colorModeForRenderPass() const {
     if (debugOptions & MapDebugOptions::Overdraw) {
         const float overdraw = 1.0f / 8.0f;
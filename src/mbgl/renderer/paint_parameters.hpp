@@ -2,6 +2,7 @@
 
 #include <mbgl/renderer/render_pass.hpp>
 #include <mbgl/renderer/render_light.hpp>
+#include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/mode.hpp>
 #include <mbgl/map/mode.hpp>
 #include <mbgl/gl/depth_mode.hpp>
@@ -11,6 +12,8 @@
 #include <mbgl/algorithm/generate_clip_ids.hpp>
 
 #include <array>
+#include <functional>
+#include <vector>
 
 namespace mbgl {
 
@@ -55,11 +58,34 @@ public:
     std::array<float, 2> pixelsToGLUnits;
     algorithm::ClipIDGenerator clipIDGenerator;
 
+    // Whether tiles are clipped to their tile masks with scissor rectangles, rather than to their
+    // clip IDs with the stencil buffer. Only possible while the map is neither rotated nor pitched.
+    bool tileMaskClipping = false;
+
     Programs& programs;
 
     gl::DepthMode depthModeForSublayer(uint8_t n, gl::DepthMode::Mask) const;
     gl::DepthMode depthModeFor3D(gl::DepthMode::Mask) const;
     gl::StencilMode stencilModeForClipping(const ClipID&) const;
+
+    // Computes the clip IDs or the tile masks of the tiles of a source.
+    void updateClipping(std::vector<std::reference_wrapper<RenderTile>>);
+
+    // Calls `draw` once when clipping with the stencil buffer. When clipping with tile masks, calls
+    // it once per scissor rectangle of the tile instead, which is never for a fully covered tile.
+    template <class Fn>
+    void drawClipped(const RenderTile& tile, Fn&& draw) {
+        if (!tileMaskClipping) {
+            draw();
+            return;
+        }
+        for (const auto& rect : tile.scissorRects) {
+            enableScissor(rect);
+            draw();
+        }
+        disableScissor();
+    }
+
     gl::ColorMode colorModeForRenderPass() const;
 
     mat4 matrixForTile(const UnwrappedTileID&, bool aligned = false) const;
@@ -74,6 +100,10 @@ public:
     const float depthEpsilon = 1.0f / (1 << 16);
     
     float symbolFadeChange;
+
+private:
+    void enableScissor(const gl::value::Scissor::Type&);
+    void disableScissor();
 };
 
 } // namespace mbgl
@@ -8,7 +8,13 @@
 #include <mbgl/renderer/possibly_evaluated_property_value.hpp>
 #include <mbgl/renderer/paint_property_statistics.hpp>
 
+#include <algorithm>
 #include <bitset>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace mbgl {
 
@@ -49,6 +55,105 @@ std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>
     return result;
 }
 
+/*
+   PaintAttributeBuffer<N> holds the attribute values of a data-driven paint property, N per
+   vertex, on the GPU. The values are evaluated as floats, but many of them are small integers:
+   colors are packed into pairs of 16-bit integers, and widths, radii and heights are often whole
+   numbers. When compacting is enabled, the values are uploaded in the narrowest integer type
+   that holds all of them exactly, and the attribute is bound with that type. OpenGL converts
+   unnormalized integer attributes to floats, so the shaders read the same values as before.
+*/
+template <std::size_t N>
+class PaintAttributeBuffer {
+public:
+    using Vertex = gl::detail::Vertex<gl::Attribute<float, N>>;
+
+    explicit PaintAttributeBuffer(bool compact_) : compact(compact_) {}
+
+    void upload(gl::Context& context, const std::vector<Vertex>& vertices) {
+        const gl::DataType newType = compact ? compactType(vertices) : gl::DataType::Float;
+        switch (newType) {
+        case gl::DataType::UnsignedByte: return upload<uint8_t>(context, newType, vertices);
+        case gl::DataType::Byte: return upload<int8_t>(context, newType, vertices);
+        case gl::DataType::UnsignedShort: return upload<uint16_t>(context, newType, vertices);
+        case gl::DataType::Short: return upload<int16_t>(context, newType, vertices);
+        default: return upload<float>(context, newType, vertices);
+        }
+    }
+
+    bool uploaded() const {
+        return bool(buffer);
+    }
+
+    gl::AttributeBinding binding(std::size_t attributeSize) const {
+        assert(buffer);
+        return gl::AttributeBinding {
+            type,
+            static_cast<uint8_t>(attributeSize),
+            0,
+            *buffer,
+            static_cast<uint32_t>(N * valueSize),
+            0,
+        };
+    }
+
+private:
+    static gl::DataType compactType(const std::vector<Vertex>& vertices) {
+        float min = 0;
+        float max = 0;
+        for (const auto& vertex : vertices) {
+            for (float v : vertex.a1) {
+                if (v != std::floor(v)) {
+                    return gl::DataType::Float;
+                }
+                min = std::min(min, v);
+                max = std::max(max, v);
+            }
+        }
+        if (min >= 0) {
+            return max <= std::numeric_limits<uint8_t>::max() ? gl::DataType::UnsignedByte
+                 : max <= std::numeric_limits<uint16_t>::max() ? gl::DataType::UnsignedShort
+                 : gl::DataType::Float;
+        }
+        return min >= std::numeric_limits<int8_t>::min() && max <= std::numeric_limits<int8_t>::max() ? gl::DataType::Byte
+             : min >= std::numeric_limits<int16_t>::min() && max <= std::numeric_limits<int16_t>::max() ? gl::DataType::Short
+             : gl::DataType::Float;
+    }
+
+    template <class U>
+    void upload(gl::Context& context, gl::DataType newType, const std::vector<Vertex>& vertices) {
+        static_assert(sizeof(Vertex) == N * sizeof(float), "unexpected vertex padding");
+        const std::size_t count = vertices.size();
+        std::vector<U> converted;
+        const void* data = vertices.data();
+        if (!std::is_same<U, float>::value) {
+            converted.reserve(count * N);
+            for (const auto& vertex : vertices) {
+                for (float v : vertex.a1) {
+                    converted.push_back(static_cast<U>(v));
+                }
+            }
+            data = converted.data();
+        }
+
+        // Values that no longer fit the type of the buffer need a new one.
+        if (buffer && newType == type && count == vertexCount) {
+            context.updateVertexBuffer(*buffer, data, count * N * sizeof(U));
+        } else {
+            buffer = context.createVertexBuffer(data, count * N * sizeof(U), gl::BufferUsage::StaticDraw);
+        }
+        type = newType;
+        valueSize = sizeof(U);
+        vertexCount = count;
+    }
+
+    const bool compact;
+    gl::DataType type = gl::DataType::Float;
+    std::size_t valueSize = sizeof(float);
+    std::size_t vertexCount = 0;
+    optional<gl::UniqueBuffer> buffer;
+};
+
 /*
    PaintPropertyBinder is an abstract class serving as the interface definition for
    the strategy used for constructing, uploading, and binding paint property data as
@@ -71,6 +176,14 @@ std::array<float, N*2> zoomInterpolatedAttributeValue(const std::array<float, N>
 
    Note that the shader source varies depending on whether we're using a uniform or
    attribute. Like GL JS, we dynamically compile shaders at runtime to accomodate this.
+
+   Function binders whose expression reads ["feature-state", ...] retain their vertex
+   vector after uploading it, so that the attribute values of individual features can be
+   patched in place and re-uploaded when their feature state changes.
+
+   Layers that share a bucket often use the same function for a property. Their binders
+   are shared, so that the attribute values are evaluated, stored and uploaded once.
+   Populating, updating and uploading a binder are idempotent, so each layer may do so.
 */
 template <class T, class A>
 class PaintPropertyBinder {
@@ -81,12 +194,17 @@ public:
     virtual ~PaintPropertyBinder() = default;
 
     virtual void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) = 0;
+    // Re-evaluates the vertices [start, end) of the given feature with its feature state. Returns
+    // false if the value of this property doesn't depend on feature state.
+    virtual bool updateVertexVector(const GeometryTileFeature& feature, const FeatureState& state, std::size_t start, std::size_t end) = 0;
     virtual void upload(gl::Context& context) = 0;
     virtual optional<AttributeBinding> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const = 0;
     virtual float interpolationFactor(float currentZoom) const = 0;
     virtual T uniformValue(const PossiblyEvaluatedPropertyValue<T>& currentValue) const = 0;
+    // Whether this binder holds the attribute values of the given function.
+    virtual bool binds(const PossiblyEvaluatedPropertyValue<T>& value) const = 0;
 
-    static std::unique_ptr<PaintPropertyBinder> create(const PossiblyEvaluatedPropertyValue<T>& value, float zoom, T defaultValue);
+    static std::unique_ptr<PaintPropertyBinder> create(const PossiblyEvaluatedPropertyValue<T>& value, float zoom, T defaultValue, bool compactAttributes = false);
 
     PaintPropertyStatistics<T> statistics;
 };
@@ -102,6 +220,9 @@ public:
     }
 
     void populateVertexVector(const GeometryTileFeature&, std::size_t) override {}
+    bool updateVertexVector(const GeometryTileFeature&, const FeatureState&, std::size_t, std::size_t) override {
+        return false;
+    }
     void upload(gl::Context&) override {}
 
     optional<AttributeBinding> attributeBinding(const PossiblyEvaluatedPropertyValue<T>&) const override {
@@ -116,6 +237,10 @@ public:
         return currentValue.constantOr(constant);
     }
 
+    bool binds(const PossiblyEvaluatedPropertyValue<T>&) const override {
+        return false;
+    }
+
 private:
     T constant;
 };
@@ -130,9 +255,11 @@ public:
     using Attribute = ZoomInterpolatedAttributeType<A>;
     using AttributeBinding = typename Attribute::Binding;
 
-    SourceFunctionPaintPropertyBinder(style::SourceFunction<T> function_, T defaultValue_)
+    SourceFunctionPaintPropertyBinder(style::SourceFunction<T> function_, T defaultValue_, bool compactAttributes)
         : function(std::move(function_)),
-          defaultValue(std::move(defaultValue_)) {
+          defaultValue(std::move(defaultValue_)),
+          isStateDependent(!style::expression::isFeatureStateConstant(function.getExpression())),
+          vertexBuffer(compactAttributes) {
     }
 
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) override {
@@ -144,15 +271,32 @@ public:
         }
     }
 
+    bool updateVertexVector(const GeometryTileFeature& feature, const FeatureState& state, std::size_t start, std::size_t end) override {
+        if (!isStateDependent) {
+            return false;
+        }
+        auto evaluated = function.evaluate(feature, state, defaultValue);
+        this->statistics.add(evaluated);
+        auto value = attributeValue(evaluated);
+        for (std::size_t i = start; i < end; ++i) {
+            vertexVector.at(i) = BaseVertex { value };
+        }
+        dirty = true;
+        return true;
+    }
+
     void upload(gl::Context& context) override {
-        vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+        if (!vertexBuffer.uploaded() || dirty) {
+            vertexBuffer.upload(context, vertexVector.vector());
+        }
+        dirty = false;
     }
 
     optional<AttributeBinding> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         if (currentValue.isConstant()) {
             return {};
         } else {
-            return Attribute::binding(*vertexBuffer, 0, BaseAttribute::Dimensions);
+            return vertexBuffer.binding(BaseAttribute::Dimensions);
         }
     }
 
@@ -169,11 +313,23 @@ public:
         }
     }
 
+    bool binds(const PossiblyEvaluatedPropertyValue<T>& value) const override {
+        return value.match(
+            [&] (const style::SourceFunction<T>& other) { return other == function; },
+            [&] (const auto&) { return false; });
+    }
+
+    const gl::VertexVector<BaseVertex>& getVertexVector() const {
+        return vertexVector;
+    }
+
 private:
     style::SourceFunction<T> function;
     T defaultValue;
+    const bool isStateDependent;
+    bool dirty = false;
     gl::VertexVector<BaseVertex> vertexVector;
-    optional<gl::VertexBuffer<BaseVertex>> vertexBuffer;
+    PaintAttributeBuffer<BaseAttribute::Dimensions> vertexBuffer;
 };
 
 template <class T, class A>
@@ -187,10 +343,12 @@ public:
     using AttributeBinding = typename Attribute::Binding;
     using Vertex = gl::detail::Vertex<Attribute>;
 
-    CompositeFunctionPaintPropertyBinder(style::CompositeFunction<T> function_, float zoom, T defaultValue_)
+    CompositeFunctionPaintPropertyBinder(style::CompositeFunction<T> function_, float zoom, T defaultValue_, bool compactAttributes)
         : function(std::move(function_)),
           defaultValue(std::move(defaultValue_)),
-          zoomRange({zoom, zoom + 1}) {
+          zoomRange({zoom, zoom + 1}),
+          isStateDependent(!style::expression::isFeatureStateConstant(function.getExpression())),
+          vertexBuffer(compactAttributes) {
     }
 
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) override {
@@ -205,15 +363,35 @@ public:
         }
     }
 
+    bool updateVertexVector(const GeometryTileFeature& feature, const FeatureState& state, std::size_t start, std::size_t end) override {
+        if (!isStateDependent) {
+            return false;
+        }
+        Range<T> range = function.evaluate(zoomRange, feature, state, defaultValue);
+        this->statistics.add(range.min);
+        this->statistics.add(range.max);
+        AttributeValue value = zoomInterpolatedAttributeValue(
+            attributeValue(range.min),
+            attributeValue(range.max));
+        for (std::size_t i = start; i < end; ++i) {
+            vertexVector.at(i) = Vertex { value };
+        }
+        dirty = true;
+        return true;
+    }
+
     void upload(gl::Context& context) override {
-        vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+        if (!vertexBuffer.uploaded() || dirty) {
+            vertexBuffer.upload(context, vertexVector.vector());
+        }
+        dirty = false;
     }
 
     optional<AttributeBinding> attributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const override {
         if (currentValue.isConstant()) {
             return {};
         } else {
-            return Attribute::binding(*vertexBuffer, 0);
+            return vertexBuffer.binding(Attribute::Dimensions);
         }
     }
 
@@ -234,26 +412,36 @@ public:
         }
     }
 
+    bool binds(const PossiblyEvaluatedPropertyValue<T>& value) const override {
+        return value.match(
+            [&] (const style::CompositeFunction<T>& other) {
+                return other == function && other.useIntegerZoom == function.useIntegerZoom;
+            },
+            [&] (const auto&) { return false; });
+    }
+
 private:
     style::CompositeFunction<T> function;
     T defaultValue;
     Range<float> zoomRange;
+    const bool isStateDependent;
+    bool dirty = false;
     gl::VertexVector<Vertex> vertexVector;
-    optional<gl::VertexBuffer<Vertex>> vertexBuffer;
+    PaintAttributeBuffer<Attribute::Dimensions> vertexBuffer;
 };
 
 template <class T, class A>
 std::unique_ptr<PaintPropertyBinder<T, A>>
-PaintPropertyBinder<T, A>::create(const PossiblyEvaluatedPropertyValue<T>& value, float zoom, T defaultValue) {
+PaintPropertyBinder<T, A>::create(const PossiblyEvaluatedPropertyValue<T>& value, float zoom, T defaultValue, bool compactAttributes) {
     return value.match(
         [&] (const T& constant) -> std::unique_ptr<PaintPropertyBinder<T, A>> {
             return std::make_unique<ConstantPaintPropertyBinder<T, A>>(constant);
         },
         [&] (const style::SourceFunction<T>& function) {
-            return std::make_unique<SourceFunctionPaintPropertyBinder<T, A>>(function, defaultValue);
+            return std::make_unique<SourceFunctionPaintPropertyBinder<T, A>>(function, defaultValue, compactAttributes);
         },
         [&] (const style::CompositeFunction<T>& function) {
-            return std::make_unique<CompositeFunctionPaintPropertyBinder<T, A>>(function, zoom, defaultValue);
+            return std::make_unique<CompositeFunctionPaintPropertyBinder<T, A>>(function, zoom, defaultValue, compactAttributes);
         }
     );
 }
@@ -283,12 +471,23 @@ public:
 
     using Binders = IndexedTuple<
         TypeList<Ps...>,
-        TypeList<std::unique_ptr<Binder<Ps>>...>>;
+        TypeList<std::shared_ptr<Binder<Ps>>...>>;
 
     template <class EvaluatedProperties>
-    PaintPropertyBinders(const EvaluatedProperties& properties, float z)
-        : binders(Binder<Ps>::create(properties.template get<Ps>(), z, Ps::defaultValue())...) {
+    PaintPropertyBinders(const EvaluatedProperties& properties, float z, bool compactAttributes = false)
+        : binders(Binder<Ps>::create(properties.template get<Ps>(), z, Ps::defaultValue(), compactAttributes)...) {
+        (void)z; // Workaround for https://gcc.gnu.org/bugzilla/show_bug.cgi?id=56958
+        (void)compactAttributes;
+    }
+
+    // Creates the binders of a layer that shares a bucket with the layers of `others`, a map of
+    // PaintPropertyBinders by layer ID, reusing their binders for the same functions.
+    template <class EvaluatedProperties, class Others>
+    PaintPropertyBinders(const EvaluatedProperties& properties, float z, bool compactAttributes, const Others& others)
+        : binders(shared<Ps>(properties.template get<Ps>(), z, compactAttributes, others)...) {
         (void)z; // Workaround for https://gcc.gnu.org/bugzilla/show_bug.cgi?id=56958
+        (void)compactAttributes;
+        (void)others;
     }
 
     PaintPropertyBinders(PaintPropertyBinders&&) = default;
@@ -300,6 +499,14 @@ public:
         });
     }
 
+    bool updateVertexVectors(const GeometryTileFeature& feature, const FeatureState& state, std::size_t start, std::size_t end) {
+        bool updated = false;
+        util::ignore({
+            (updated = binders.template get<Ps>()->updateVertexVector(feature, state, start, end) || updated, 0)...
+        });
+        return updated;
+    }
+
     void upload(gl::Context& context) {
         util::ignore({
             (binders.template get<Ps>()->upload(context), 0)...
@@ -340,6 +547,11 @@ public:
         return binders.template get<P>()->statistics;
     }
 
+    template <class P>
+    const Binder<P>& get() const {
+        return *binders.template get<P>();
+    }
+
 
     using Bitset = std::bitset<sizeof...(Ps)>;
 
@@ -365,6 +577,17 @@ public:
     }
 
 private:
+    template <class P, class Others>
+    static std::shared_ptr<Binder<P>> shared(const PossiblyEvaluatedPropertyValue<typename P::Type>& value, float z, bool compactAttributes, const Others& others) {
+        for (const auto& other : others) {
+            const auto& binder = other.second.binders.template get<P>();
+            if (binder->binds(value)) {
+                return binder;
+            }
+        }
+        return Binder<P>::create(value, z, P::defaultValue(), compactAttributes);
+    }
+
     Binders binders;
 };
 
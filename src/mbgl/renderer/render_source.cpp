@@ -63,4 +63,16 @@ bool RenderSource::isEnabled() const {
     return enabled;
 }
 
+void RenderSource::setFeatureState(const optional<std::string>& sourceLayerID,
+                                   const std::string& featureID,
+                                   const FeatureState& state) {
+    featureState.updateState(sourceLayerID, featureID, state);
+}
+
+void RenderSource::getFeatureState(FeatureState& state,
+                                   const optional<std::string>& sourceLayerID,
+                                   const std::string& featureID) const {
+    featureState.getState(state, sourceLayerID, featureID);
+}
+
 } // namespace mbgl
@@ -2,6 +2,7 @@
 
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile_observer.hpp>
+#include <mbgl/renderer/source_state.hpp>
 #include <mbgl/util/mat4.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/feature.hpp>
@@ -72,6 +73,13 @@ public:
 
     virtual void reduceMemoryUse() = 0;
 
+    void setFeatureState(const optional<std::string>& sourceLayerID,
+                         const std::string& featureID,
+                         const FeatureState&);
+    void getFeatureState(FeatureState& state,
+                         const optional<std::string>& sourceLayerID,
+                         const std::string& featureID) const;
+
     virtual void dumpDebugLogs() const = 0;
 
     void setObserver(RenderSourceObserver*);
@@ -84,6 +92,9 @@ protected:
 
     bool enabled = false;
 
+    // Applied to the source's tiles at the start of each frame by sources that support it.
+    SourceFeatureState featureState;
+
     void onTileChanged(Tile&) override;
     void onTileError(Tile&, std::exception_ptr) final;
 };
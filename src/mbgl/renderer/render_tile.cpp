@@ -6,6 +6,11 @@
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/renderer/renderer_backend.hpp>
+
+#include <cmath>
 
 namespace mbgl {
 
@@ -52,8 +57,9 @@ mat4 RenderTile::translatedClipMatrix(const std::array<float, 2>& translation,
     return translateVtxMatrix(nearClippedMatrix, translation, anchor, state, false);
 }
 
-void RenderTile::setMask(TileMask&& mask) {
-    tile.setMask(std::move(mask));
+void RenderTile::setMask(TileMask&& mask_) {
+    mask = mask_;
+    tile.setMask(std::move(mask_));
 }
 
 void RenderTile::startRender(PaintParameters& parameters) {
@@ -65,6 +71,44 @@ void RenderTile::startRender(PaintParameters& parameters) {
     parameters.state.matrixFor(nearClippedMatrix, id);
     matrix::multiply(matrix, parameters.projMatrix, matrix);
     matrix::multiply(nearClippedMatrix, parameters.nearClippedProjMatrix, nearClippedMatrix);
+
+    scissorRects.clear();
+    if (parameters.tileMaskClipping) {
+        // Edges are projected from the world rather than from this tile, so that the edge shared
+        // by two tiles rounds to the same pixel for both, and no pixel is drawn twice or never.
+        mat4 worldMatrix;
+        parameters.state.matrixFor(worldMatrix, UnwrappedTileID(0, CanonicalTileID(0, 0, 0)));
+        matrix::multiply(worldMatrix, parameters.projMatrix, worldMatrix);
+
+        const Size size = parameters.backend.getFramebufferSize();
+        auto toFramebuffer = [&] (double x, double y) {
+            vec4 point;
+            matrix::transformMat4(point, {{ x * util::EXTENT, y * util::EXTENT, 0, 1 }}, worldMatrix);
+            return std::array<double, 2> {{
+                (point[0] / point[3] + 1) / 2 * size.width,
+                (point[1] / point[3] + 1) / 2 * size.height
+            }};
+        };
+        auto toPixel = [] (double value, uint32_t limit) {
+            return static_cast<int32_t>(util::clamp(std::round(value), 0.0, double(limit)));
+        };
+
+        const double tiles = std::pow(2.0, id.canonical.z);
+        for (const auto& part : mask) {
+            const double parts = std::pow(2.0, part.z);
+            const double x = (id.wrap * tiles + id.canonical.x + part.x / parts) / tiles;
+            const double y = (id.canonical.y + part.y / parts) / tiles;
+            const auto a = toFramebuffer(x, y);
+            const auto b = toFramebuffer(x + 1 / (tiles * parts), y + 1 / (tiles * parts));
+            const int32_t x0 = toPixel(std::min(a[0], b[0]), size.width);
+            const int32_t x1 = toPixel(std::max(a[0], b[0]), size.width);
+            const int32_t y0 = toPixel(std::min(a[1], b[1]), size.height);
+            const int32_t y1 = toPixel(std::max(a[1], b[1]), size.height);
+            if (x1 > x0 && y1 > y0) {
+                scissorRects.push_back({ x0, y0, { uint32_t(x1 - x0), uint32_t(y1 - y0) } });
+            }
+        }
+    }
 }
 
 void RenderTile::finishRender(PaintParameters& parameters) {
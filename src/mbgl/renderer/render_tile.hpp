@@ -5,8 +5,10 @@
 #include <mbgl/util/clip_id.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/renderer/tile_mask.hpp>
+#include <mbgl/gl/value.hpp>
 
 #include <array>
+#include <vector>
 
 namespace mbgl {
 
@@ -30,6 +32,11 @@ public:
     bool used = false;
     bool needsClipping = false;
 
+    // The parts of the tile not covered by other tiles, and their framebuffer rectangles when
+    // tiles are clipped with tile masks rather than with the stencil buffer.
+    TileMask mask;
+    std::vector<gl::value::Scissor::Type> scissorRects;
+
     mat4 translatedMatrix(const std::array<float, 2>& translate,
                           style::TranslateAnchorType anchor,
                           const TransformState&) const;
@@ -90,6 +90,16 @@ std::vector<Feature> Renderer::querySourceFeatures(const std::string& sourceID,
     return impl->querySourceFeatures(sourceID, options);
 }
 
+void Renderer::setFeatureState(const std::string& sourceID, const optional<std::string>& sourceLayerID,
+                               const std::string& featureID, const FeatureState& state) {
+    impl->setFeatureState(sourceID, sourceLayerID, featureID, state);
+}
+
+void Renderer::getFeatureState(FeatureState& state, const std::string& sourceID, const optional<std::string>& sourceLayerID,
+                               const std::string& featureID) const {
+    impl->getFeatureState(state, sourceID, sourceLayerID, featureID);
+}
+
 void Renderer::dumpDebugLogs() {
     impl->dumDebugLogs();
 }
@@ -99,4 +109,28 @@ void Renderer::reduceMemoryUse() {
     impl->reduceMemoryUse();
 }
 
+void Renderer::setRasterTextureCompression(bool compression) {
+    impl->rasterTextureCompression = compression;
+}
+
+std::size_t Renderer::getRasterTextureBytes() const {
+    return impl->rasterTextureBytes;
+}
+
+void Renderer::setHillshadePrepareOnWorkers(bool onWorkers) {
+    impl->prepareHillshadeOnWorkers = onWorkers;
+}
+
+void Renderer::setCompactVertexAttributes(bool compact) {
+    impl->compactVertexAttributes = compact;
+}
+
+void Renderer::setTileMaskClipping(bool enabled) {
+    impl->tileMaskClipping = enabled;
+}
+
+void Renderer::setParallelTessellation(bool parallel) {
+    impl->parallelTessellation = parallel;
+}
+
 } // namespace mbgl
@@ -16,6 +16,7 @@
 #include <mbgl/renderer/layers/render_fill_extrusion_layer.hpp>
 #include <mbgl/renderer/layers/render_heatmap_layer.hpp>
 #include <mbgl/renderer/layers/render_hillshade_layer.hpp>
+#include <mbgl/renderer/sources/render_raster_source.hpp>
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/backend_scope.hpp>
@@ -29,6 +30,7 @@
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/compressed_image.hpp>
 
 namespace mbgl {
 
@@ -59,6 +61,9 @@ Renderer::Impl::Impl(RendererBackend& backend_,
     , imageImpls(makeMutable<std::vector<Immutable<style::Image::Impl>>>())
     , sourceImpls(makeMutable<std::vector<Immutable<style::Source::Impl>>>())
     , layerImpls(makeMutable<std::vector<Immutable<style::Layer::Impl>>>())
+    , imageJournal(makeMutable<style::CollectionJournal<style::Image::Impl>>())
+    , sourceJournal(makeMutable<style::CollectionJournal<style::Source::Impl>>())
+    , layerJournal(makeMutable<style::CollectionJournal<style::Layer::Impl>>())
     , renderLight(makeMutable<Light::Impl>())
     , placement(std::make_unique<Placement>(TransformState{}, MapMode::Static)) {
     glyphManager->setObserver(this);
@@ -106,6 +111,17 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         updateParameters.mode == MapMode::Continuous ? util::DEFAULT_TRANSITION_DURATION : Duration::zero()
     };
 
+    // Desktop GPUs decode BC1 natively, but often emulate ETC2.
+    optional<CompressedImageFormat> rasterCompression;
+    if (rasterTextureCompression) {
+        for (auto format : { CompressedImageFormat::BC1, CompressedImageFormat::ETC1 }) {
+            if (backend.getContext().supportsCompressedImageFormat(format)) {
+                rasterCompression = format;
+                break;
+            }
+        }
+    }
+
     const TileParameters tileParameters {
         updateParameters.pixelRatio,
         updateParameters.debugOptions,
@@ -116,7 +132,12 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         updateParameters.annotationManager,
         *imageManager,
         *glyphManager,
-        updateParameters.prefetchZoomDelta
+        updateParameters.prefetchZoomDelta,
+        rasterCompression,
+        prepareHillshadeOnWorkers,
+        backend.getContext().supportsUint32Indices ? gl::IndexType::UnsignedInt : gl::IndexType::UnsignedShort,
+        compactVertexAttributes,
+        parallelTessellation
     };
 
     glyphManager->setURL(updateParameters.glyphURL);
@@ -134,8 +155,10 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     }
 
 
-    const ImageDifference imageDiff = diffImages(imageImpls, updateParameters.images);
+    const ImageDifference imageDiff = diffImages(imageImpls, updateParameters.images,
+                                                 imageJournal, updateParameters.imageJournal);
     imageImpls = updateParameters.images;
+    imageJournal = updateParameters.imageJournal;
 
     // Remove removed images from sprite atlas.
     for (const auto& entry : imageDiff.removed) {
@@ -155,8 +178,11 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     imageManager->setLoaded(updateParameters.spriteLoaded);
 
 
-    const LayerDifference layerDiff = diffLayers(layerImpls, updateParameters.layers);
+    const bool layersChanged = layerImpls != updateParameters.layers;
+    const LayerDifference layerDiff = diffLayers(layerImpls, updateParameters.layers,
+                                                 layerJournal, updateParameters.layerJournal);
     layerImpls = updateParameters.layers;
+    layerJournal = updateParameters.layerJournal;
 
     // Remove render layers for removed layers.
     for (const auto& entry : layerDiff.removed) {
@@ -193,8 +219,10 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     }
 
 
-    const SourceDifference sourceDiff = diffSources(sourceImpls, updateParameters.sources);
+    const SourceDifference sourceDiff = diffSources(sourceImpls, updateParameters.sources,
+                                                    sourceJournal, updateParameters.sourceJournal);
     sourceImpls = updateParameters.sources;
+    sourceJournal = updateParameters.sourceJournal;
 
     // Remove render layers for removed sources.
     for (const auto& entry : sourceDiff.removed) {
@@ -210,30 +238,47 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
 
     const bool hasImageDiff = !(imageDiff.added.empty() && imageDiff.removed.empty() && imageDiff.changed.empty());
 
-    // Update all sources.
-    for (const auto& source : *sourceImpls) {
-        std::vector<Immutable<Layer::Impl>> filteredLayers;
-        bool needsRendering = false;
-        bool needsRelayout = false;
-
+    if (layersChanged) {
+        sourceLayers.clear();
         for (const auto& layer : *layerImpls) {
             if (layer->type == LayerType::Background ||
-                layer->type == LayerType::Custom ||
-                layer->source != source->id) {
+                layer->type == LayerType::Custom) {
                 continue;
             }
 
-            if (!needsRendering && getRenderLayer(layer->id)->needsRendering(zoomHistory.lastZoom)) {
-                needsRendering = true;
-            }
+            sourceLayers[layer->source].push_back(layer);
+        }
+    }
 
-            if (!needsRelayout && (hasImageDiff || hasLayoutDifference(layerDiff, layer->id))) {
-                needsRelayout = true;
-            }
+    // Collect the sources with layers whose layout changed. Paint-only changes don't require
+    // tiles to be laid out again.
+    std::unordered_set<std::string> relayoutSources;
+    for (const auto& entry : layerDiff.added) {
+        relayoutSources.insert(entry.second->source);
+    }
+    for (const auto& entry : layerDiff.changed) {
+        if (hasLayoutDifference(layerDiff, entry.first)) {
+            relayoutSources.insert(entry.second.after->source);
+        }
+    }
+
+    static const std::vector<Immutable<Layer::Impl>> noLayers;
 
-            filteredLayers.push_back(layer);
+    // Update all sources.
+    for (const auto& source : *sourceImpls) {
+        const auto it = sourceLayers.find(source->id);
+        const std::vector<Immutable<Layer::Impl>>& filteredLayers = it != sourceLayers.end() ? it->second : noLayers;
+
+        bool needsRendering = false;
+        for (const auto& layer : filteredLayers) {
+            if (getRenderLayer(layer->id)->needsRendering(zoomHistory.lastZoom)) {
+                needsRendering = true;
+                break;
+            }
         }
 
+        const bool needsRelayout = !filteredLayers.empty() && (hasImageDiff || relayoutSources.count(source->id));
+
         renderSources.at(source->id)->update(source,
                                              filteredLayers,
                                              needsRendering,
@@ -259,6 +304,11 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         *lineAtlas
     };
 
+    // Scissor rectangles are axis-aligned, so they only match tiles that are neither rotated nor
+    // pitched.
+    parameters.tileMaskClipping = tileMaskClipping &&
+        parameters.state.getAngle() == 0 && parameters.state.getPitch() == 0;
+
     bool loaded = updateParameters.styleLoaded && isLoaded();
     if (updateParameters.mode != MapMode::Continuous && !loaded) {
         return;
@@ -482,7 +532,8 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
     }
 
     // - CLIPPING MASKS ----------------------------------------------------------------------------
-    // Draws the clipping masks to the stencil buffer.
+    // Draws the clipping masks to the stencil buffer. There are none when tiles are clipped with
+    // tile masks.
     {
         MBGL_DEBUG_GROUP(parameters.context, "clipping masks");
 
@@ -584,6 +635,13 @@ void Renderer::Impl::render(const UpdateParameters& updateParameters) {
         }
     }
 
+    rasterTextureBytes = 0;
+    for (const auto& entry : renderSources) {
+        if (entry.second->isEnabled() && entry.second->is<RenderRasterSource>()) {
+            rasterTextureBytes += entry.second->as<RenderRasterSource>()->getTextureBytes();
+        }
+    }
+
     // - DEBUG PASS --------------------------------------------------------------------------------
     // Renders debug overlays.
     {
@@ -726,6 +784,21 @@ std::vector<Feature> Renderer::Impl::querySourceFeatures(const std::string& sour
     return source->querySourceFeatures(options);
 }
 
+void Renderer::Impl::setFeatureState(const std::string& sourceID, const optional<std::string>& sourceLayerID,
+                                     const std::string& featureID, const FeatureState& state) {
+    if (RenderSource* renderSource = getRenderSource(sourceID)) {
+        renderSource->setFeatureState(sourceLayerID, featureID, state);
+        observer->onInvalidate();
+    }
+}
+
+void Renderer::Impl::getFeatureState(FeatureState& state, const std::string& sourceID, const optional<std::string>& sourceLayerID,
+                                     const std::string& featureID) const {
+    if (const RenderSource* renderSource = getRenderSource(sourceID)) {
+        renderSource->getFeatureState(state, sourceLayerID, featureID);
+    }
+}
+
 void Renderer::Impl::reduceMemoryUse() {
     assert(BackendScope::exists());
     for (const auto& entry : renderSources) {
@@ -7,6 +7,7 @@
 #include <mbgl/style/image.hpp>
 #include <mbgl/style/source.hpp>
 #include <mbgl/style/layer.hpp>
+#include <mbgl/style/collection.hpp>
 #include <mbgl/map/transform_state.hpp>
 #include <mbgl/map/zoom_history.hpp>
 #include <mbgl/text/cross_tile_symbol_index.hpp>
@@ -16,6 +17,8 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -53,6 +56,11 @@ public:
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&) const;
     std::vector<Feature> queryShapeAnnotations(const ScreenLineString&) const;
 
+    void setFeatureState(const std::string& sourceID, const optional<std::string>& sourceLayerID,
+                         const std::string& featureID, const FeatureState&);
+    void getFeatureState(FeatureState&, const std::string& sourceID, const optional<std::string>& sourceLayerID,
+                         const std::string& featureID) const;
+
     void reduceMemoryUse();
     void dumDebugLogs();
 
@@ -108,6 +116,13 @@ private:
     Immutable<std::vector<Immutable<style::Source::Impl>>> sourceImpls;
     Immutable<std::vector<Immutable<style::Layer::Impl>>> layerImpls;
 
+    Immutable<style::CollectionJournal<style::Image::Impl>> imageJournal;
+    Immutable<style::CollectionJournal<style::Source::Impl>> sourceJournal;
+    Immutable<style::CollectionJournal<style::Layer::Impl>> layerJournal;
+
+    // Layers of `layerImpls` grouped by source, rebuilt only when `layerImpls` changes.
+    std::unordered_map<std::string, std::vector<Immutable<style::Layer::Impl>>> sourceLayers;
+
     std::unordered_map<std::string, std::unique_ptr<RenderSource>> renderSources;
     std::unordered_map<std::string, std::unique_ptr<RenderLayer>> renderLayers;
     RenderLight renderLight;
@@ -117,6 +132,14 @@ private:
 
     bool contextLost = false;
     bool fadingTiles = false;
+
+    bool rasterTextureCompression = false;
+    std::size_t rasterTextureBytes = 0;
+
+    bool prepareHillshadeOnWorkers = false;
+    bool compactVertexAttributes = false;
+    bool tileMaskClipping = false;
+    bool parallelTessellation = false;
 };
 
 } // namespace mbgl
@@ -0,0 +1,64 @@
+#include <mbgl/renderer/source_state.hpp>
+#include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/tile/tile.hpp>
+
+namespace mbgl {
+
+void SourceFeatureState::updateState(const optional<std::string>& sourceLayerID, const std::string& featureID, const FeatureState& newState) {
+    FeatureState& changes = stateChanges[sourceLayerID ? *sourceLayerID : std::string()][featureID];
+    for (const auto& property : newState) {
+        changes[property.first] = property.second;
+    }
+}
+
+void SourceFeatureState::getState(FeatureState& result, const optional<std::string>& sourceLayerID, const std::string& featureID) const {
+    const std::string sourceLayer = sourceLayerID ? *sourceLayerID : std::string();
+
+    auto merge = [&] (const LayerFeatureStates& states) {
+        auto layerStates = states.find(sourceLayer);
+        if (layerStates == states.end()) {
+            return;
+        }
+        auto featureState = layerStates->second.find(featureID);
+        if (featureState == layerStates->second.end()) {
+            return;
+        }
+        for (const auto& property : featureState->second) {
+            result[property.first] = property.second;
+        }
+    };
+
+    merge(currentStates);
+    merge(stateChanges);
+}
+
+void SourceFeatureState::coalesceChanges(std::vector<RenderTile>& tiles) {
+    // Buckets are updated with the complete state of each changed feature.
+    LayerFeatureStates changes;
+    if (!stateChanges.empty()) {
+        for (const auto& layerStates : stateChanges) {
+            for (const auto& featureState : layerStates.second) {
+                FeatureState& state = currentStates[layerStates.first][featureState.first];
+                for (const auto& property : featureState.second) {
+                    state[property.first] = property.second;
+                }
+                changes[layerStates.first].emplace(featureState.first, state);
+            }
+        }
+        stateChanges.clear();
+        version++;
+    }
+
+    for (RenderTile& renderTile : tiles) {
+        Tile& tile = renderTile.tile;
+        const uint64_t tileVersion = tile.getFeatureStateVersion();
+        if (tileVersion == version) {
+            continue;
+        }
+
+        const bool upToDate = !changes.empty() && tileVersion + 1 == version;
+        tile.setFeatureState(upToDate ? changes : currentStates, version);
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class RenderTile;
+
+// Feature states of a single source. Changes are buffered until the next frame, when they are
+// merged into the current states and applied to the source's tiles in one go.
+class SourceFeatureState {
+public:
+    void updateState(const optional<std::string>& sourceLayerID, const std::string& featureID, const FeatureState& newState);
+    void getState(FeatureState& result, const optional<std::string>& sourceLayerID, const std::string& featureID) const;
+
+    void coalesceChanges(std::vector<RenderTile>& tiles);
+
+private:
+    LayerFeatureStates currentStates;
+    LayerFeatureStates stateChanges;
+
+    // Incremented whenever changes are coalesced. Tiles that didn't see the previous version
+    // receive all current states instead of just the latest changes.
+    uint64_t version = 0;
+};
+
+} // namespace mbgl
@@ -3,9 +3,9 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/util/constants.hpp>
 
-#include <mbgl/algorithm/generate_clip_ids.hpp>
-#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
+#include <cmath>
 
 namespace mbgl {
 
@@ -20,6 +20,40 @@ const style::GeoJSONSource::Impl& RenderGeoJSONSource::impl() const {
     return static_cast<const style::GeoJSONSource::Impl&>(*baseImpl);
 }
 
+// Whether the given tile, expanded by its buffer, overlaps any of the given bounds. Tiles at the
+// antimeridian also contain wrapped copies of features on the other side of the world.
+static bool intersects(const CanonicalTileID& tileID, double buffer, const std::vector<LatLngBounds>& bounds) {
+    const double worldSize = std::pow(2.0, tileID.z);
+    auto latitude = [&] (double y) {
+        // Features beyond the latitude limit of the projection are clamped to the edge tiles.
+        if (y <= 0) {
+            return 90.0;
+        } else if (y >= worldSize) {
+            return -90.0;
+        }
+        return util::RAD2DEG * std::atan(std::sinh(M_PI * (1 - 2 * y / worldSize)));
+    };
+    auto longitude = [&] (double x) {
+        return x / worldSize * util::DEGREES_MAX - util::LONGITUDE_MAX;
+    };
+
+    const LatLngBounds buffered = LatLngBounds::hull(
+        { latitude(tileID.y + 1 + buffer), longitude(tileID.x - buffer) },
+        { latitude(tileID.y - buffer), longitude(tileID.x + 1 + buffer) });
+
+    for (const auto& changed : bounds) {
+        for (const double shift : { 0.0, -360.0, 360.0 }) {
+            const LatLngBounds shifted = LatLngBounds::hull(
+                { changed.south(), changed.west() + shift },
+                { changed.north(), changed.east() + shift });
+            if (buffered.intersects(shifted)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 bool RenderGeoJSONSource::isLoaded() const {
     return tilePyramid.isLoaded();
 }
@@ -33,18 +67,31 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
 
     enabled = needsRendering;
 
-    GeoJSONData* data_ = impl().getData();
+    std::shared_ptr<GeoJSONData> data_ = impl().getData();
 
     if (data_ != data) {
+        // Data derived from the current data through incremental updates records the bounds of
+        // the changed features, so that only tiles that overlap them need to be reloaded.
+        optional<std::vector<LatLngBounds>> changed;
+        if (data && data_) {
+            changed = data_->changedSince(*data);
+        }
+
         data = data_;
         tilePyramid.cache.clear();
 
         if (data) {
             const uint8_t maxZ = impl().getZoomRange().max;
+            const double buffer = impl().getTileBuffer();
             for (const auto& pair : tilePyramid.tiles) {
-                if (pair.first.canonical.z <= maxZ) {
-                    static_cast<GeoJSONTile*>(pair.second.get())->updateData(data->getTile(pair.first.canonical));
+                const CanonicalTileID& tileID = pair.first.canonical;
+                if (tileID.z > maxZ) {
+                    continue;
+                }
+                if (changed && !intersects(tileID, buffer, *changed)) {
+                    continue;
                 }
+                static_cast<GeoJSONTile*>(pair.second.get())->updateData(data);
             }
         }
     }
@@ -64,12 +111,13 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
                        impl().getZoomRange(),
                        optional<LatLngBounds>{},
                        [&] (const OverscaledTileID& tileID) {
-                           return std::make_unique<GeoJSONTile>(tileID, impl().id, parameters, data->getTile(tileID.canonical));
+                           return std::make_unique<GeoJSONTile>(tileID, impl().id, parameters, data);
                        });
 }
 
 void RenderGeoJSONSource::startRender(PaintParameters& parameters) {
-    parameters.clipIDGenerator.update(tilePyramid.getRenderTiles());
+    parameters.updateClipping(tilePyramid.getRenderTiles());
+    featureState.coalesceChanges(tilePyramid.renderTiles);
     tilePyramid.startRender(parameters);
 }
 
@@ -5,6 +5,7 @@
 #include <mbgl/geometry/dem_data.hpp>
 #include <mbgl/renderer/buckets/hillshade_bucket.hpp>
 #include <iostream>
+#include <array>
 
 namespace mbgl {
 
@@ -62,67 +63,59 @@ void RenderRasterDEMSource::update(Immutable<style::Source::Impl> baseImpl_,
                        });
 }
 
+namespace {
+
+struct DEMNeighbor {
+    DEMTileNeighbors mask;
+    // The border of the neighbor facing this tile.
+    DEMTileNeighbors opposite;
+    int8_t dx;
+    int8_t dy;
+};
+
+const std::array<DEMNeighbor, 8> demNeighbors {{
+    { DEMTileNeighbors::Left, DEMTileNeighbors::Right, -1, 0 },
+    { DEMTileNeighbors::Right, DEMTileNeighbors::Left, 1, 0 },
+    { DEMTileNeighbors::TopLeft, DEMTileNeighbors::BottomRight, -1, -1 },
+    { DEMTileNeighbors::TopCenter, DEMTileNeighbors::BottomCenter, 0, -1 },
+    { DEMTileNeighbors::TopRight, DEMTileNeighbors::BottomLeft, 1, -1 },
+    { DEMTileNeighbors::BottomLeft, DEMTileNeighbors::TopRight, -1, 1 },
+    { DEMTileNeighbors::BottomCenter, DEMTileNeighbors::TopCenter, 0, 1 },
+    { DEMTileNeighbors::BottomRight, DEMTileNeighbors::TopLeft, 1, 1 },
+}};
+
+} // namespace
+
+// Each tile's bitmask records which of its borders have been backfilled, so that every border is
+// copied once per loaded pair of tiles, and only the copied pixels are uploaded again.
 void RenderRasterDEMSource::onTileChanged(Tile& tile){
     RasterDEMTile& demtile = static_cast<RasterDEMTile&>(tile);
 
-    std::map<DEMTileNeighbors, DEMTileNeighbors> opposites = {
-        { DEMTileNeighbors::Left, DEMTileNeighbors::Right },
-        { DEMTileNeighbors::Right, DEMTileNeighbors::Left },
-        { DEMTileNeighbors::TopLeft, DEMTileNeighbors::BottomRight },
-        { DEMTileNeighbors::TopCenter, DEMTileNeighbors::BottomCenter },
-        { DEMTileNeighbors::TopRight, DEMTileNeighbors::BottomLeft },
-        { DEMTileNeighbors::BottomRight,  DEMTileNeighbors::TopLeft },
-        { DEMTileNeighbors::BottomCenter, DEMTileNeighbors:: TopCenter },
-        { DEMTileNeighbors::BottomLeft, DEMTileNeighbors::TopRight }
-    };
-
     if (tile.isRenderable() && demtile.neighboringTiles != DEMTileNeighbors::Complete) {
         const CanonicalTileID canonical = tile.id.canonical;
-        const uint32_t dim = std::pow(2, canonical.z);
-        const uint32_t px = (canonical.x - 1 + dim) % dim;
-        const int pxw = canonical.x == 0 ? tile.id.wrap - 1 : tile.id.wrap;
-        const uint32_t nx = (canonical.x + 1 + dim) % dim;
-        const int nxw = (canonical.x + 1 == dim) ? tile.id.wrap + 1 : tile.id.wrap;
-
-        auto getNeighbor = [&] (DEMTileNeighbors mask){
-            if (mask == DEMTileNeighbors::Left){
-                return OverscaledTileID(tile.id.overscaledZ, pxw, canonical.z, px, canonical.y);
-            } else if (mask == DEMTileNeighbors::Right){
-                return OverscaledTileID(tile.id.overscaledZ, nxw, canonical.z, nx, canonical.y);
-            } else if (mask == DEMTileNeighbors::TopLeft){
-                return OverscaledTileID(tile.id.overscaledZ, pxw, canonical.z, px, canonical.y - 1);
-            } else if (mask == DEMTileNeighbors::TopCenter){
-                return OverscaledTileID(tile.id.overscaledZ, tile.id.wrap, canonical.z, canonical.x, canonical.y - 1);
-            } else if (mask == DEMTileNeighbors::TopRight){
-                return OverscaledTileID(tile.id.overscaledZ, nxw, canonical.z, nx, canonical.y - 1);
-            } else if (mask == DEMTileNeighbors::BottomLeft){
-                return OverscaledTileID(tile.id.overscaledZ, pxw, canonical.z, px, canonical.y + 1);
-            } else if (mask == DEMTileNeighbors::BottomCenter){
-                return OverscaledTileID(tile.id.overscaledZ, tile.id.wrap, canonical.z, canonical.x, canonical.y + 1);
-            } else if (mask == DEMTileNeighbors::BottomRight){
-                return OverscaledTileID(tile.id.overscaledZ, nxw, canonical.z, nx, canonical.y + 1);
-            } else{
-                throw std::runtime_error("mask is not a valid tile neighbor");
-            }
-        };
+        const int32_t dim = 1 << canonical.z;
 
-        for (uint8_t i = 0; i < 8; i++) {
-            DEMTileNeighbors mask = DEMTileNeighbors(std::pow(2,i));
+        for (const auto& neighbor : demNeighbors) {
             // only backfill if this neighbor has not been previously backfilled
-            if ((demtile.neighboringTiles & mask) != mask) {
-                OverscaledTileID neighborid = getNeighbor(mask);
-                Tile* renderableNeighbor = tilePyramid.getTile(neighborid);
-                if (renderableNeighbor != nullptr && renderableNeighbor->isRenderable()) {
-                    RasterDEMTile& borderTile = static_cast<RasterDEMTile&>(*renderableNeighbor);
-                    demtile.backfillBorder(borderTile, mask);
-
-                    // if the border tile has not been backfilled by a previous instance of the main
-                    // tile, backfill its corresponding neighbor as well.
-                    const DEMTileNeighbors& borderMask = opposites[mask];
-                    if ((borderTile.neighboringTiles & borderMask) != borderMask){
-                        borderTile.backfillBorder(demtile, borderMask);
-                     }
-                }
+            if ((demtile.neighboringTiles & neighbor.mask) == neighbor.mask) {
+                continue;
+            }
+
+            // Neighbors across the antimeridian are in the adjacent world copy. Tiles at the top
+            // and bottom of the world have their missing neighbors marked as backfilled.
+            const int32_t x = int32_t(canonical.x) + neighbor.dx;
+            const int16_t wrap = tile.id.wrap + (x < 0 ? -1 : x >= dim ? 1 : 0);
+            const OverscaledTileID neighborID(tile.id.overscaledZ, wrap, canonical.z,
+                                              (x + dim) % dim, int32_t(canonical.y) + neighbor.dy);
+
+            Tile* renderableNeighbor = tilePyramid.getTile(neighborID);
+            if (renderableNeighbor != nullptr && renderableNeighbor->isRenderable()) {
+                RasterDEMTile& borderTile = static_cast<RasterDEMTile&>(*renderableNeighbor);
+                demtile.backfillBorder(borderTile, neighbor.mask);
+
+                // This tile's border was either never backfilled, or its data was replaced, so
+                // the border tile needs this tile's current data as well.
+                borderTile.backfillBorder(demtile, neighbor.opposite);
             }
         }
     }
@@ -1,5 +1,6 @@
 #include <mbgl/renderer/sources/render_raster_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/tile/raster_tile.hpp>
 #include <mbgl/algorithm/update_tile_masks.hpp>
 
@@ -72,6 +73,16 @@ std::vector<std::reference_wrapper<RenderTile>> RenderRasterSource::getRenderTil
     return tilePyramid.getRenderTiles();
 }
 
+std::size_t RenderRasterSource::getTextureBytes() {
+    std::size_t bytes = 0;
+    for (const RenderTile& tile : tilePyramid.getRenderTiles()) {
+        if (const RasterBucket* bucket = static_cast<RasterTile&>(tile.tile).getBucket()) {
+            bytes += bucket->textureBytes();
+        }
+    }
+    return bytes;
+}
+
 std::unordered_map<std::string, std::vector<Feature>>
 RenderRasterSource::queryRenderedFeatures(const ScreenLineString&,
                                           const TransformState&,
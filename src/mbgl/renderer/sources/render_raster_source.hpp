@@ -36,6 +36,9 @@ public:
     void reduceMemoryUse() final;
     void dumpDebugLogs() const final;
 
+    // The texture memory of the tiles drawn in the current frame.
+    std::size_t getTextureBytes();
+
 private:
     const style::RasterSource::Impl& impl() const;
 
@@ -3,9 +3,6 @@
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/tile/vector_tile.hpp>
 
-#include <mbgl/algorithm/generate_clip_ids.hpp>
-#include <mbgl/algorithm/generate_clip_ids_impl.hpp>
-
 namespace mbgl {
 
 using namespace style;
@@ -33,9 +30,11 @@ void RenderVectorSource::update(Immutable<style::Source::Impl> baseImpl_,
     enabled = needsRendering;
 
     optional<Tileset> _tileset = impl().getTileset();
+    const float _simplificationTolerance = impl().getSimplificationTolerance();
 
-    if (tileset != _tileset) {
+    if (tileset != _tileset || simplificationTolerance != _simplificationTolerance) {
         tileset = _tileset;
+        simplificationTolerance = _simplificationTolerance;
 
         // TODO: this removes existing buckets, and will cause flickering.
         // Should instead refresh tile data in place.
@@ -58,12 +57,13 @@ void RenderVectorSource::update(Immutable<style::Source::Impl> baseImpl_,
                        tileset->zoomRange,
                        tileset->bounds,
                        [&] (const OverscaledTileID& tileID) {
-                           return std::make_unique<VectorTile>(tileID, impl().id, parameters, *tileset);
+                           return std::make_unique<VectorTile>(tileID, impl().id, parameters, *tileset, simplificationTolerance);
                        });
 }
 
 void RenderVectorSource::startRender(PaintParameters& parameters) {
-    parameters.clipIDGenerator.update(tilePyramid.getRenderTiles());
+    parameters.updateClipping(tilePyramid.getRenderTiles());
+    featureState.coalesceChanges(tilePyramid.renderTiles);
     tilePyramid.startRender(parameters);
 }
 
@@ -41,6 +41,7 @@ private:
 
     TilePyramid tilePyramid;
     optional<Tileset> tileset;
+    float simplificationTolerance = 0;
 };
 
 template <>
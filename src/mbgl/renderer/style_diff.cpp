@@ -44,27 +44,114 @@ StyleDifference<T> diff(const Immutable<std::vector<T>>& a,
     return result;
 }
 
+template <class T, class Journal, class Eq>
+StyleDifference<T> diff(const Immutable<std::vector<T>>& a,
+                        const Immutable<std::vector<T>>& b,
+                        const Journal& aJournal,
+                        const Journal& bJournal,
+                        const Eq& eq) {
+    if (a == b) {
+        return {};
+    }
+
+    if (!bJournal->covers(aJournal->collection, aJournal->version)) {
+        return diff(a, b, eq);
+    }
+
+    class Entry {
+    public:
+        optional<T> before;
+        optional<T> after;
+        bool removed;
+    };
+
+    // Collapse the recorded mutations since version `a` into a single net change per element.
+    std::unordered_map<std::string, Entry> entries;
+
+    const auto& journal = bJournal->entries;
+    const auto count = static_cast<std::ptrdiff_t>(bJournal->version - aJournal->version);
+    for (auto it = journal.end() - count; it != journal.end(); ++it) {
+        auto result = entries.emplace(it->id, Entry { it->before, it->after, !it->after });
+        if (!result.second) {
+            result.first->second.after = it->after;
+            result.first->second.removed |= !it->after;
+        }
+    }
+
+    StyleDifference<T> result;
+
+    for (auto& entry : entries) {
+        const std::string& id = entry.first;
+        auto& before = entry.second.before;
+        auto& after = entry.second.after;
+
+        // Elements that were removed and added again are reported as such, matching
+        // the result of the full diff for an element that moved.
+        if (before && after && !entry.second.removed && eq(*before, *after)) {
+            if (before->get() != after->get()) {
+                result.changed.emplace(id, StyleChange<T> { std::move(*before), std::move(*after) });
+            }
+        } else {
+            if (before) {
+                result.removed.emplace(id, std::move(*before));
+            }
+            if (after) {
+                result.added.emplace(id, std::move(*after));
+            }
+        }
+    }
+
+    return result;
+}
+
+static bool imageEq(const ImmutableImage& lhs, const ImmutableImage& rhs) {
+    return lhs->id == rhs->id;
+}
+
 ImageDifference diffImages(const Immutable<std::vector<ImmutableImage>>& a,
                            const Immutable<std::vector<ImmutableImage>>& b) {
-    return diff(a, b, [] (const ImmutableImage& lhs, const ImmutableImage& rhs) {
-        return lhs->id == rhs->id;
-    });
+    return diff(a, b, imageEq);
+}
+
+ImageDifference diffImages(const Immutable<std::vector<ImmutableImage>>& a,
+                           const Immutable<std::vector<ImmutableImage>>& b,
+                           const ImageJournal& aJournal,
+                           const ImageJournal& bJournal) {
+    return diff(a, b, aJournal, bJournal, imageEq);
+}
+
+static bool sourceEq(const ImmutableSource& lhs, const ImmutableSource& rhs) {
+    return std::tie(lhs->id, lhs->type)
+        == std::tie(rhs->id, rhs->type);
 }
 
 SourceDifference diffSources(const Immutable<std::vector<ImmutableSource>>& a,
                              const Immutable<std::vector<ImmutableSource>>& b) {
-    return diff(a, b, [] (const ImmutableSource& lhs, const ImmutableSource& rhs) {
-        return std::tie(lhs->id, lhs->type)
-            == std::tie(rhs->id, rhs->type);
-    });
+    return diff(a, b, sourceEq);
+}
+
+SourceDifference diffSources(const Immutable<std::vector<ImmutableSource>>& a,
+                             const Immutable<std::vector<ImmutableSource>>& b,
+                             const SourceJournal& aJournal,
+                             const SourceJournal& bJournal) {
+    return diff(a, b, aJournal, bJournal, sourceEq);
+}
+
+static bool layerEq(const ImmutableLayer& lhs, const ImmutableLayer& rhs) {
+    return std::tie(lhs->id, lhs->type)
+        == std::tie(rhs->id, rhs->type);
 }
 
 LayerDifference diffLayers(const Immutable<std::vector<ImmutableLayer>>& a,
                            const Immutable<std::vector<ImmutableLayer>>& b) {
-    return diff(a, b, [] (const ImmutableLayer& lhs, const ImmutableLayer& rhs) {
-        return std::tie(lhs->id, lhs->type)
-            == std::tie(rhs->id, rhs->type);
-    });
+    return diff(a, b, layerEq);
+}
+
+LayerDifference diffLayers(const Immutable<std::vector<ImmutableLayer>>& a,
+                           const Immutable<std::vector<ImmutableLayer>>& b,
+                           const LayerJournal& aJournal,
+                           const LayerJournal& bJournal) {
+    return diff(a, b, aJournal, bJournal, layerEq);
 }
 
 bool hasLayoutDifference(const LayerDifference& layerDiff, const std::string& layerID) {
@@ -3,6 +3,7 @@
 #include <mbgl/style/image_impl.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/style/collection.hpp>
 #include <mbgl/util/immutable.hpp>
 #include <mbgl/util/variant.hpp>
 
@@ -25,24 +26,46 @@ public:
     std::unordered_map<std::string, StyleChange<T>> changed;
 };
 
+// The journal-taking overloads diff only the elements recorded in the second journal since the
+// version described by the first one, and fall back to a full diff when the second journal does
+// not reach back that far (or belongs to a different collection).
+
 using ImmutableImage = Immutable<style::Image::Impl>;
 using ImageDifference = StyleDifference<ImmutableImage>;
+using ImageJournal = Immutable<style::CollectionJournal<style::Image::Impl>>;
 
 ImageDifference diffImages(const Immutable<std::vector<ImmutableImage>>&,
                            const Immutable<std::vector<ImmutableImage>>&);
 
+ImageDifference diffImages(const Immutable<std::vector<ImmutableImage>>&,
+                           const Immutable<std::vector<ImmutableImage>>&,
+                           const ImageJournal&,
+                           const ImageJournal&);
+
 using ImmutableSource = Immutable<style::Source::Impl>;
 using SourceDifference = StyleDifference<ImmutableSource>;
+using SourceJournal = Immutable<style::CollectionJournal<style::Source::Impl>>;
 
 SourceDifference diffSources(const Immutable<std::vector<ImmutableSource>>&,
                              const Immutable<std::vector<ImmutableSource>>&);
 
+SourceDifference diffSources(const Immutable<std::vector<ImmutableSource>>&,
+                             const Immutable<std::vector<ImmutableSource>>&,
+                             const SourceJournal&,
+                             const SourceJournal&);
+
 using ImmutableLayer = Immutable<style::Layer::Impl>;
 using LayerDifference = StyleDifference<ImmutableLayer>;
+using LayerJournal = Immutable<style::CollectionJournal<style::Layer::Impl>>;
 
 LayerDifference diffLayers(const Immutable<std::vector<ImmutableLayer>>&,
                            const Immutable<std::vector<ImmutableLayer>>&);
 
+LayerDifference diffLayers(const Immutable<std::vector<ImmutableLayer>>&,
+                           const Immutable<std::vector<ImmutableLayer>>&,
+                           const LayerJournal&,
+                           const LayerJournal&);
+
 bool hasLayoutDifference(const LayerDifference&, const std::string& layerID);
 
 } // namespace mbgl
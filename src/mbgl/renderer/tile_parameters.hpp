@@ -1,6 +1,8 @@
 #pragma once
 
+#include <mbgl/gl/types.hpp>
 #include <mbgl/map/mode.hpp>
+#include <mbgl/util/optional.hpp>
 
 namespace mbgl {
 
@@ -10,6 +12,7 @@ class FileSource;
 class AnnotationManager;
 class ImageManager;
 class GlyphManager;
+enum class CompressedImageFormat : uint8_t;
 
 class TileParameters {
 public:
@@ -23,6 +26,11 @@ public:
     ImageManager& imageManager;
     GlyphManager& glyphManager;
     const uint8_t prefetchZoomDelta;
+    const optional<CompressedImageFormat> rasterTextureCompression = {};
+    const bool prepareHillshadeOnWorkers = false;
+    const gl::IndexType indexType = gl::IndexType::UnsignedShort;
+    const bool compactVertexAttributes = false;
+    const bool parallelTessellation = false;
 };
 
 } // namespace mbgl
@@ -6,6 +6,7 @@
 #include <mbgl/style/image.hpp>
 #include <mbgl/style/source.hpp>
 #include <mbgl/style/layer.hpp>
+#include <mbgl/style/collection.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/immutable.hpp>
 
@@ -32,6 +33,11 @@ public:
     const Immutable<std::vector<Immutable<style::Source::Impl>>> sources;
     const Immutable<std::vector<Immutable<style::Layer::Impl>>> layers;
 
+    // Recent mutations of the collections above, used for incremental diffing.
+    const Immutable<style::CollectionJournal<style::Image::Impl>> imageJournal;
+    const Immutable<style::CollectionJournal<style::Source::Impl>> sourceJournal;
+    const Immutable<style::CollectionJournal<style::Layer::Impl>> layerJournal;
+
     AnnotationManager& annotationManager;
 
     const uint8_t prefetchZoomDelta;
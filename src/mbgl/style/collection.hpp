@@ -3,12 +3,50 @@
 #include <mbgl/util/immutable.hpp>
 #include <mbgl/util/optional.hpp>
 
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace mbgl {
 namespace style {
 
+/*
+    A bounded record of the most recent mutations of a Collection. Each entry holds the
+    element's impl before and after a single mutation; `before` is absent for additions and
+    `after` is absent for removals.
+
+    Snapshots of the journal are handed to the renderer along with the impls. As long as the
+    journal still reaches back to the version the renderer last saw, the renderer can diff only
+    the touched elements instead of the complete collection.
+*/
+template <class Impl>
+class CollectionJournal {
+public:
+    class Entry {
+    public:
+        std::string id;
+        optional<Immutable<Impl>> before;
+        optional<Immutable<Impl>> after;
+    };
+
+    // Identifies the collection instance. A collection gets a fresh identifier when cleared,
+    // so that journals from before and after the reset are never mixed.
+    uint64_t collection = 0;
+
+    // Version of the collection after the last entry was recorded. `entries[i]` moved the
+    // collection from version `version - entries.size() + i` to the following one.
+    uint64_t version = 0;
+
+    std::vector<Entry> entries;
+
+    // Returns true if this journal records every mutation since the given version of the given
+    // collection.
+    bool covers(uint64_t collection_, uint64_t since) const {
+        return collection == collection_ && since <= version && version - since <= entries.size();
+    }
+};
+
 /*
     Manages an ordered collection of elements and their `Immutable<Impl>`s. The latter is
     itself stored in an Immutable container. Using immutability at the collection level
@@ -27,6 +65,7 @@ public:
     using Impl = typename T::Impl;
     using WrapperVector = std::vector<std::unique_ptr<T>>;
     using ImmutableVector = Immutable<std::vector<Immutable<Impl>>>;
+    using Journal = CollectionJournal<Impl>;
 
     Collection();
 
@@ -35,6 +74,7 @@ public:
 
     std::vector<T*> getWrappers() const;
     ImmutableVector getImpls() const { return impls; }
+    Immutable<Journal> getJournal() const { return journal; }
 
     auto begin() const { return wrappers.begin(); }
     auto end() const { return wrappers.end(); }
@@ -51,14 +91,41 @@ public:
 
 private:
     std::size_t index(const std::string&) const;
+    void record(const std::string&, optional<Immutable<Impl>> before, optional<Immutable<Impl>> after);
+
+    static Immutable<Journal> makeJournal();
+
+    // Older entries are dropped beyond this size; the renderer then falls back to a full diff.
+    static constexpr std::size_t maxJournalSize = 128;
 
     WrapperVector wrappers;
     ImmutableVector impls;
+    Immutable<Journal> journal;
 };
 
 template <class T>
 Collection<T>::Collection()
-    : impls(makeMutable<std::vector<Immutable<Impl>>>()) {
+    : impls(makeMutable<std::vector<Immutable<Impl>>>()),
+      journal(makeJournal()) {
+}
+
+template <class T>
+Immutable<typename Collection<T>::Journal> Collection<T>::makeJournal() {
+    static std::atomic<uint64_t> nextCollection { 1 };
+    auto result = makeMutable<Journal>();
+    result->collection = nextCollection++;
+    return std::move(result);
+}
+
+template <class T>
+void Collection<T>::record(const std::string& id, optional<Immutable<Impl>> before, optional<Immutable<Impl>> after) {
+    mutate(journal, [&] (auto& journal_) {
+        if (journal_.entries.size() == maxJournalSize) {
+            journal_.entries.erase(journal_.entries.begin());
+        }
+        journal_.entries.push_back({ id, std::move(before), std::move(after) });
+        journal_.version++;
+    });
 }
 
 template <class T>
@@ -98,6 +165,7 @@ void Collection<T>::clear() {
     });
 
     wrappers.clear();
+    journal = makeJournal();
 }
 
 template <class T>
@@ -108,6 +176,8 @@ T* Collection<T>::add(std::unique_ptr<T> wrapper, const optional<std::string>& b
         impls_.emplace(impls_.begin() + i, wrapper->baseImpl);
     });
 
+    record(wrapper->getID(), {}, wrapper->baseImpl);
+
     return wrappers.emplace(wrappers.begin() + i, std::move(wrapper))->get();
 }
 
@@ -125,6 +195,8 @@ std::unique_ptr<T> Collection<T>::remove(const std::string& id) {
         impls_.erase(impls_.begin() + i);
     });
 
+    record(id, source->baseImpl, {});
+
     wrappers.erase(wrappers.begin() + i);
 
     return source;
@@ -132,9 +204,17 @@ std::unique_ptr<T> Collection<T>::remove(const std::string& id) {
 
 template <class T>
 void Collection<T>::update(const T& wrapper) {
+    optional<Immutable<Impl>> before;
+
     mutate(impls, [&] (auto& impls_) {
-        impls_.at(this->index(wrapper.getID())) = wrapper.baseImpl;
+        auto& impl = impls_.at(this->index(wrapper.getID()));
+        before = impl;
+        impl = wrapper.baseImpl;
     });
+
+    if (before && *before != wrapper.baseImpl) {
+        record(wrapper.getID(), std::move(before), wrapper.baseImpl);
+    }
 }
 
 } // namespace style
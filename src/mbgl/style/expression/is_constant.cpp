@@ -15,7 +15,8 @@ bool isFeatureConstant(const Expression& expression) {
         } else if (
             name == "properties" ||
             name == "geometry-type" ||
-            name == "id"
+            name == "id" ||
+            name == "feature-state"
         ) {
             return false;
         }
@@ -34,6 +35,10 @@ bool isZoomConstant(const Expression& e) {
     return isGlobalPropertyConstant(e, std::array<std::string, 1>{{"zoom"}});
 }
 
+bool isFeatureStateConstant(const Expression& e) {
+    return isGlobalPropertyConstant(e, std::array<std::string, 1>{{"feature-state"}});
+}
+
 
 } // namespace expression
 } // namespace style
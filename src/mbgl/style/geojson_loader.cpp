@@ -0,0 +1,50 @@
+#include <mbgl/style/geojson_loader.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
+#include <mbgl/style/conversion/json.hpp>
+#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/util/logging.hpp>
+
+namespace mbgl {
+namespace style {
+
+GeoJSONLoader::GeoJSONLoader(ActorRef<GeoJSONSource> source_,
+                             GeoJSONOptions options_,
+                             std::shared_ptr<GeoJSONData> data_)
+    : source(std::move(source_)),
+      options(std::move(options_)),
+      data(std::move(data_)) {
+}
+
+void GeoJSONLoader::setGeoJSON(const GeoJSON& geoJSON, uint64_t correlationID) {
+    setData(GeoJSONData::create(geoJSON, options), correlationID);
+}
+
+void GeoJSONLoader::parseGeoJSON(std::shared_ptr<const std::string> json, uint64_t correlationID) {
+    conversion::Error error;
+    optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*json, error);
+    if (!geoJSON) {
+        Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
+                   error.message.c_str());
+        // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
+        // tiles to load.
+        setData(GeoJSONData::create(GeoJSON{ FeatureCollection{} }, options), correlationID);
+    } else {
+        setData(GeoJSONData::create(*geoJSON, options), correlationID);
+    }
+}
+
+void GeoJSONLoader::updateGeoJSON(const GeoJSONDiff& diff, uint64_t correlationID) {
+    if (data) {
+        setData(data->update(diff), correlationID);
+    } else {
+        setData(GeoJSONData::create(GeoJSON{ diff.add }, options), correlationID);
+    }
+}
+
+void GeoJSONLoader::setData(std::shared_ptr<GeoJSONData> data_, uint64_t correlationID) {
+    data = std::move(data_);
+    source.invoke(&GeoJSONSource::onLoad, data, correlationID);
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+namespace style {
+
+class GeoJSONData;
+
+// Parses and indexes the data of a GeoJSONSource on a background thread, and sends the indexed
+// data back to the source. Requests are processed in the order they are sent.
+class GeoJSONLoader : private util::noncopyable {
+public:
+    GeoJSONLoader(ActorRef<GeoJSONSource>, GeoJSONOptions, std::shared_ptr<GeoJSONData>);
+
+    void setGeoJSON(const GeoJSON&, uint64_t correlationID);
+    void parseGeoJSON(std::shared_ptr<const std::string>, uint64_t correlationID);
+    void updateGeoJSON(const GeoJSONDiff&, uint64_t correlationID);
+
+private:
+    void setData(std::shared_ptr<GeoJSONData>, uint64_t correlationID);
+
+    ActorRef<GeoJSONSource> source;
+    const GeoJSONOptions options;
+
+    // The latest data sent to the source, which updates are applied to.
+    std::shared_ptr<GeoJSONData> data;
+};
+
+} // namespace style
+} // namespace mbgl
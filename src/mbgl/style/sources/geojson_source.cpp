@@ -1,10 +1,11 @@
 #include <mbgl/style/sources/geojson_source.hpp>
 #include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/style/source_observer.hpp>
-#include <mbgl/style/conversion/json.hpp>
-#include <mbgl/style/conversion/geojson.hpp>
+#include <mbgl/style/geojson_loader.hpp>
 #include <mbgl/storage/file_source.hpp>
-#include <mbgl/util/logging.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/shared_thread_pool.hpp>
 
 namespace mbgl {
 namespace style {
@@ -13,7 +14,11 @@ GeoJSONSource::GeoJSONSource(const std::string& id, const GeoJSONOptions& option
     : Source(makeMutable<Impl>(std::move(id), options)) {
 }
 
-GeoJSONSource::~GeoJSONSource() = default;
+GeoJSONSource::~GeoJSONSource() {
+    if (mailbox) {
+        mailbox->close();
+    }
+}
 
 const GeoJSONSource::Impl& GeoJSONSource::impl() const {
     return static_cast<const Impl&>(*baseImpl);
@@ -32,8 +37,51 @@ void GeoJSONSource::setURL(const std::string& url_) {
 
 void GeoJSONSource::setGeoJSON(const mapbox::geojson::geojson& geoJSON) {
     req.reset();
-    baseImpl = makeMutable<Impl>(impl(), geoJSON);
-    observer->onSourceChanged(*this);
+    if (auto loader_ = getLoader()) {
+        loaded = false;
+        loader_->invoke(&GeoJSONLoader::setGeoJSON, geoJSON, ++correlationID);
+    } else {
+        onLoad(GeoJSONData::create(geoJSON, impl().getOptions()), ++correlationID);
+    }
+}
+
+void GeoJSONSource::updateGeoJSON(const GeoJSONDiff& diff) {
+    req.reset();
+    if (auto loader_ = getLoader()) {
+        loaded = false;
+        loader_->invoke(&GeoJSONLoader::updateGeoJSON, diff, ++correlationID);
+    } else if (auto data = impl().getData()) {
+        onLoad(data->update(diff), ++correlationID);
+    } else {
+        onLoad(GeoJSONData::create(GeoJSON{ diff.add }, impl().getOptions()), ++correlationID);
+    }
+}
+
+// Without a scheduler on this thread to receive the results, data is indexed synchronously.
+Actor<GeoJSONLoader>* GeoJSONSource::getLoader() {
+    if (!loader && Scheduler::GetCurrent()) {
+        threadPool = sharedThreadPool();
+        mailbox = std::make_shared<Mailbox>(*Scheduler::GetCurrent());
+        loader = std::make_unique<Actor<GeoJSONLoader>>(*threadPool,
+                                                        ActorRef<GeoJSONSource>(*this, mailbox),
+                                                        impl().getOptions(),
+                                                        impl().getData());
+    }
+    return loader.get();
+}
+
+void GeoJSONSource::onLoad(std::shared_ptr<GeoJSONData> data, uint64_t correlationID_) {
+    loadedCorrelationID = correlationID_;
+    baseImpl = makeMutable<Impl>(impl(), std::move(data));
+
+    // Intermediate results are rendered, but the source only becomes loaded once the data of
+    // the latest request has arrived.
+    if (loadedCorrelationID == correlationID && !loaded) {
+        loaded = true;
+        observer->onSourceLoaded(*this);
+    } else {
+        observer->onSourceChanged(*this);
+    }
 }
 
 optional<std::string> GeoJSONSource::getURL() const {
@@ -42,7 +90,7 @@ optional<std::string> GeoJSONSource::getURL() const {
 
 void GeoJSONSource::loadDescription(FileSource& fileSource) {
     if (!url) {
-        loaded = true;
+        loaded = loadedCorrelationID == correlationID;
         return;
     }
 
@@ -60,20 +108,9 @@ void GeoJSONSource::loadDescription(FileSource& fileSource) {
             observer->onSourceError(
                 *this, std::make_exception_ptr(std::runtime_error("unexpectedly empty GeoJSON")));
         } else {
-            conversion::Error error;
-            optional<GeoJSON> geoJSON = conversion::convertJSON<GeoJSON>(*res.data, error);
-            if (!geoJSON) {
-                Log::Error(Event::ParseStyle, "Failed to parse GeoJSON data: %s",
-                           error.message.c_str());
-                // Create an empty GeoJSON VT object to make sure we're not infinitely waiting for
-                // tiles to load.
-                baseImpl = makeMutable<Impl>(impl(), GeoJSON{ FeatureCollection{} });
-            } else {
-                baseImpl = makeMutable<Impl>(impl(), *geoJSON);
-            }
-
-            loaded = true;
-            observer->onSourceLoaded(*this);
+            // Responses are delivered on the run loop, so the loader is always available here.
+            loaded = false;
+            getLoader()->invoke(&GeoJSONLoader::parseGeoJSON, res.data, ++correlationID);
         }
     });
 }
@@ -1,52 +1,394 @@
 #include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/math.hpp>
 #include <mbgl/util/string.hpp>
 
 #include <mapbox/geojsonvt.hpp>
+#include <mapbox/geometry/envelope.hpp>
 #include <supercluster.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
 
 namespace mbgl {
 namespace style {
 
+// Number of updates whose changed bounds are retained for invalidating tiles.
+static constexpr std::size_t maxRecordedChanges = 16;
+
+// Beyond this number of changed features per update, changes are recorded as a single bounds.
+static constexpr std::size_t maxRecordedBounds = 256;
+
+optional<std::vector<LatLngBounds>> GeoJSONData::changedSince(const GeoJSONData& previous) const {
+    if (lineage == 0 || lineage != previous.lineage || version < previous.version) {
+        return {};
+    }
+
+    std::vector<LatLngBounds> result;
+    uint64_t covered = version;
+    for (auto it = changes.rbegin(); it != changes.rend() && it->version > previous.version; ++it) {
+        result.insert(result.end(), it->bounds.begin(), it->bounds.end());
+        covered = it->version - 1;
+    }
+
+    if (covered != previous.version) {
+        return {};
+    }
+    return result;
+}
+
+void GeoJSONData::recordChange(const GeoJSONData& previous, std::vector<LatLngBounds> bounds) {
+    static std::atomic<uint64_t> nextLineage { 1 };
+
+    lineage = previous.lineage ? previous.lineage : nextLineage++;
+    version = previous.version + 1;
+    changes = previous.changes;
+
+    if (bounds.size() > maxRecordedBounds) {
+        LatLngBounds hull = LatLngBounds::empty();
+        for (const auto& b : bounds) {
+            hull.extend(b);
+        }
+        bounds = { hull };
+    }
+
+    changes.push_back({ version, std::move(bounds) });
+    if (changes.size() > maxRecordedChanges) {
+        changes.erase(changes.begin());
+    }
+}
+
+static FeatureCollection toFeatureCollection(const GeoJSON& geoJSON) {
+    return geoJSON.match(
+        [] (const mapbox::geometry::geometry<double>& geometry) {
+            return FeatureCollection { Feature { geometry } };
+        },
+        [] (const Feature& feature) {
+            return FeatureCollection { feature };
+        },
+        [] (const FeatureCollection& features) {
+            return features;
+        });
+}
+
+static optional<LatLngBounds> featureBounds(const Feature& feature) {
+    const auto box = mapbox::geometry::envelope(feature.geometry);
+    if (box.min.x > box.max.x || box.min.y > box.max.y) {
+        return {};
+    }
+    return LatLngBounds::hull(
+        { util::clamp(box.min.y, -util::LATITUDE_MAX, util::LATITUDE_MAX), box.min.x },
+        { util::clamp(box.max.y, -util::LATITUDE_MAX, util::LATITUDE_MAX), box.max.x });
+}
+
+// Features along with an index of their IDs. Updates copy the features and apply the changes
+// in place, so that unchanged features keep their order.
+class IndexedFeatures {
+public:
+    IndexedFeatures(FeatureCollection features_)
+        : features(std::move(features_)) {
+        for (std::size_t i = 0; i < features.size(); i++) {
+            if (features[i].id) {
+                ids.emplace(featureIDtoString(*features[i].id), i);
+            }
+        }
+    }
+
+    // Collects the bounds of removed features and of both the old and new geometries of
+    // changed features. If `origins` is given, it receives the index each resulting feature had
+    // in this collection, or `added` for features that weren't in it.
+    FeatureCollection update(const std::vector<const Feature*>& added,
+                             const std::vector<std::string>& removed,
+                             std::vector<LatLngBounds>& bounds,
+                             std::vector<std::size_t>* origins = nullptr) const {
+        FeatureCollection result = features;
+        std::vector<bool> erased(result.size(), false);
+        std::vector<std::size_t> origin(result.size());
+        std::iota(origin.begin(), origin.end(), 0);
+
+        auto addBounds = [&] (const Feature& feature) {
+            if (auto featureBounds_ = featureBounds(feature)) {
+                bounds.push_back(*featureBounds_);
+            }
+        };
+
+        for (const auto& id : removed) {
+            auto it = ids.find(id);
+            if (it != ids.end() && !erased[it->second]) {
+                addBounds(result[it->second]);
+                erased[it->second] = true;
+            }
+        }
+
+        std::unordered_map<std::string, std::size_t> appended;
+        for (const Feature* feature : added) {
+            std::string id = featureIDtoString(*feature->id);
+            addBounds(*feature);
+
+            auto it = ids.find(id);
+            if (it != ids.end() && !erased[it->second]) {
+                addBounds(result[it->second]);
+                result[it->second] = *feature;
+                continue;
+            }
+
+            auto appendedIt = appended.find(id);
+            if (appendedIt != appended.end()) {
+                result[appendedIt->second] = *feature;
+            } else {
+                appended.emplace(std::move(id), result.size());
+                result.push_back(*feature);
+                erased.push_back(false);
+                origin.push_back(appendedOrigin);
+            }
+        }
+
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < result.size(); i++) {
+            if (!erased[i]) {
+                if (kept != i) {
+                    result[kept] = std::move(result[i]);
+                    origin[kept] = origin[i];
+                }
+                kept++;
+            }
+        }
+        result.resize(kept);
+
+        if (origins) {
+            origin.resize(kept);
+            *origins = std::move(origin);
+        }
+
+        return result;
+    }
+
+    static constexpr std::size_t appendedOrigin = std::numeric_limits<std::size_t>::max();
+
+    const FeatureCollection features;
+
+private:
+    std::unordered_map<std::string, std::size_t> ids;
+};
+
+constexpr std::size_t IndexedFeatures::appendedOrigin;
+
+static void splitDiff(const GeoJSONDiff& diff,
+                      std::vector<const Feature*>& added,
+                      std::vector<std::string>& removed) {
+    for (const auto& feature : diff.add) {
+        if (feature.id) {
+            added.push_back(&feature);
+        }
+    }
+    for (const auto& id : diff.remove) {
+        removed.push_back(featureIDtoString(id));
+    }
+}
+
+// Features are split into partitions by the hash of their ID, each with its own geojson-vt index.
+// Updating features copies and re-indexes only the partitions that hold them, and the index of a
+// partition is built lazily when one of its tiles is first requested. Each feature keeps its
+// position in the data set, and tiles merge the features of all partitions in that order, so
+// that fills overlap and symbols are placed as if there were a single index.
 class GeoJSONVTData : public GeoJSONData {
 public:
     GeoJSONVTData(const GeoJSON& geoJSON,
-                  const mapbox::geojsonvt::Options& options)
-        : impl(geoJSON, options) {}
+                  const mapbox::geojsonvt::Options& options_)
+        : options(options_) {
+        FeatureCollection features = toFeatureCollection(geoJSON);
+        nextPosition = features.size();
+
+        const std::size_t count = util::clamp<std::size_t>(features.size() / featuresPerPartition, 1, maxPartitions);
+
+        std::vector<FeatureCollection> partitioned(count);
+        std::vector<std::vector<uint64_t>> positions(count);
+        for (std::size_t i = 0; i < features.size(); i++) {
+            const std::size_t partition = features[i].id
+                ? partitionIndex(featureIDtoString(*features[i].id), count)
+                : i % count;
+            partitioned[partition].push_back(std::move(features[i]));
+            positions[partition].push_back(i);
+        }
+
+        for (std::size_t i = 0; i < count; i++) {
+            partitions.push_back(std::make_shared<Partition>(std::move(partitioned[i]), std::move(positions[i])));
+        }
+    }
 
     mapbox::geometry::feature_collection<int16_t> getTile(const CanonicalTileID& tileID) final {
-        return impl.getTile(tileID.z, tileID.x, tileID.y).features;
+        mapbox::geometry::feature_collection<int16_t> features;
+        std::vector<uint64_t> positions;
+        for (const auto& partition : partitions) {
+            partition->getTile(tileID, options, features, positions);
+        }
+
+        if (partitions.size() == 1) {
+            return features;
+        }
+
+        std::vector<std::size_t> order(features.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&] (std::size_t a, std::size_t b) {
+            return positions[a] < positions[b];
+        });
+
+        mapbox::geometry::feature_collection<int16_t> result;
+        result.reserve(features.size());
+        for (std::size_t i : order) {
+            result.push_back(std::move(features[i]));
+        }
+        return result;
+    }
+
+    std::unique_ptr<GeoJSONData> update(const GeoJSONDiff& diff) const final {
+        std::vector<const Feature*> added;
+        std::vector<std::string> removed;
+        splitDiff(diff, added, removed);
+
+        const std::size_t count = partitions.size();
+        std::vector<std::vector<const Feature*>> partitionAdded(count);
+        std::vector<std::vector<std::string>> partitionRemoved(count);
+
+        for (const Feature* feature : added) {
+            partitionAdded[partitionIndex(featureIDtoString(*feature->id), count)].push_back(feature);
+        }
+        for (auto& id : removed) {
+            const std::size_t partition = partitionIndex(id, count);
+            partitionRemoved[partition].push_back(std::move(id));
+        }
+
+        auto result = std::make_unique<GeoJSONVTData>(*this);
+        std::vector<LatLngBounds> bounds;
+        for (std::size_t i = 0; i < count; i++) {
+            if (!partitionAdded[i].empty() || !partitionRemoved[i].empty()) {
+                result->partitions[i] = partitions[i]->update(
+                    partitionAdded[i], partitionRemoved[i], bounds, result->nextPosition);
+            }
+        }
+
+        result->recordChange(*this, std::move(bounds));
+        return std::move(result);
     }
 
 private:
-    mapbox::geojsonvt::GeoJSONVT impl;
+    static constexpr std::size_t featuresPerPartition = 4096;
+    static constexpr std::size_t maxPartitions = 64;
+
+    static std::size_t partitionIndex(const std::string& id, std::size_t count) {
+        return std::hash<std::string>()(id) % count;
+    }
+
+    class Partition : public IndexedFeatures {
+    public:
+        Partition(FeatureCollection features_, std::vector<uint64_t> positions_)
+            : IndexedFeatures(std::move(features_)),
+              positions(std::move(positions_)) {
+            assert(positions.size() == features.size());
+        }
+
+        // Replaced features keep their position, and added ones are positioned after all others.
+        std::shared_ptr<Partition> update(const std::vector<const Feature*>& added,
+                                          const std::vector<std::string>& removed,
+                                          std::vector<LatLngBounds>& bounds,
+                                          uint64_t& nextPosition) const {
+            std::vector<std::size_t> origins;
+            FeatureCollection result = IndexedFeatures::update(added, removed, bounds, &origins);
+
+            std::vector<uint64_t> resultPositions;
+            resultPositions.reserve(origins.size());
+            for (std::size_t origin : origins) {
+                resultPositions.push_back(origin == appendedOrigin ? nextPosition++ : positions[origin]);
+            }
+
+            return std::make_shared<Partition>(std::move(result), std::move(resultPositions));
+        }
+
+        // Appends the features of the tile to `tile`, and their positions to `tilePositions`.
+        void getTile(const CanonicalTileID& tileID,
+                     const mapbox::geojsonvt::Options& options,
+                     mapbox::geometry::feature_collection<int16_t>& tile,
+                     std::vector<uint64_t>& tilePositions) {
+            mapbox::geometry::feature_collection<int16_t> indexed;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!index) {
+                    index = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(numberedFeatures(), options);
+                }
+                indexed = index->getTile(tileID.z, tileID.x, tileID.y).features;
+            }
+
+            for (auto& feature : indexed) {
+                const auto i = feature.id->get<uint64_t>();
+                feature.id = features[i].id;
+                tilePositions.push_back(positions[i]);
+                tile.push_back(std::move(feature));
+            }
+        }
+
+    private:
+        // Tile features don't refer back to the features they were cut from, so features are
+        // indexed with their index in the partition as their ID, which maps them back.
+        FeatureCollection numberedFeatures() const {
+            FeatureCollection numbered = features;
+            for (std::size_t i = 0; i < numbered.size(); i++) {
+                numbered[i].id = uint64_t(i);
+            }
+            return numbered;
+        }
+
+        const std::vector<uint64_t> positions;
+
+        std::mutex mutex;
+        std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> index;
+    };
+
+    mapbox::geojsonvt::Options options;
+    std::vector<std::shared_ptr<Partition>> partitions;
+    uint64_t nextPosition = 0;
 };
 
+// Supercluster can't be updated incrementally, so updates cluster all features again. Its tiles
+// are reloaded in full.
 class SuperclusterData : public GeoJSONData {
 public:
-    SuperclusterData(const mapbox::geometry::feature_collection<double>& features,
-                     const mapbox::supercluster::Options& options)
-        : impl(features, options) {}
+    SuperclusterData(const mapbox::geometry::feature_collection<double>& features_,
+                     const mapbox::supercluster::Options& options_)
+        : features(features_),
+          options(options_),
+          impl(features_, options_) {}
 
     mapbox::geometry::feature_collection<int16_t> getTile(const CanonicalTileID& tileID) final {
+        std::lock_guard<std::mutex> lock(mutex);
         return impl.getTile(tileID.z, tileID.x, tileID.y);
     }
 
+    std::unique_ptr<GeoJSONData> update(const GeoJSONDiff& diff) const final {
+        std::vector<const Feature*> added;
+        std::vector<std::string> removed;
+        splitDiff(diff, added, removed);
+
+        std::vector<LatLngBounds> bounds;
+        return std::make_unique<SuperclusterData>(features.update(added, removed, bounds), options);
+    }
+
 private:
+    const IndexedFeatures features;
+    const mapbox::supercluster::Options options;
+
+    std::mutex mutex;
     mapbox::supercluster::Supercluster impl;
 };
 
-GeoJSONSource::Impl::Impl(std::string id_, GeoJSONOptions options_)
-    : Source::Impl(SourceType::GeoJSON, std::move(id_)),
-      options(std::move(options_)) {
-}
-
-GeoJSONSource::Impl::Impl(const Impl& other, const GeoJSON& geoJSON)
-    : Source::Impl(other),
-      options(other.options) {
+std::shared_ptr<GeoJSONData> GeoJSONData::create(const GeoJSON& geoJSON, const GeoJSONOptions& options) {
     double scale = util::EXTENT / util::tileSize;
 
     if (options.cluster
@@ -56,7 +398,7 @@ GeoJSONSource::Impl::Impl(const Impl& other, const GeoJSON& geoJSON)
         clusterOptions.maxZoom = options.clusterMaxZoom;
         clusterOptions.extent = util::EXTENT;
         clusterOptions.radius = ::round(scale * options.clusterRadius);
-        data = std::make_unique<SuperclusterData>(
+        return std::make_shared<SuperclusterData>(
             geoJSON.get<mapbox::geometry::feature_collection<double>>(), clusterOptions);
     } else {
         mapbox::geojsonvt::Options vtOptions;
@@ -64,18 +406,37 @@ GeoJSONSource::Impl::Impl(const Impl& other, const GeoJSON& geoJSON)
         vtOptions.extent = util::EXTENT;
         vtOptions.buffer = ::round(scale * options.buffer);
         vtOptions.tolerance = scale * options.tolerance;
-        data = std::make_unique<GeoJSONVTData>(geoJSON, vtOptions);
+        return std::make_shared<GeoJSONVTData>(geoJSON, vtOptions);
     }
 }
 
+GeoJSONSource::Impl::Impl(std::string id_, GeoJSONOptions options_)
+    : Source::Impl(SourceType::GeoJSON, std::move(id_)),
+      options(std::move(options_)) {
+}
+
+GeoJSONSource::Impl::Impl(const Impl& other, std::shared_ptr<GeoJSONData> data_)
+    : Source::Impl(other),
+      options(other.options),
+      data(std::move(data_)) {
+}
+
 GeoJSONSource::Impl::~Impl() = default;
 
+const GeoJSONOptions& GeoJSONSource::Impl::getOptions() const {
+    return options;
+}
+
 Range<uint8_t> GeoJSONSource::Impl::getZoomRange() const {
     return { options.minzoom, options.maxzoom };
 }
 
-GeoJSONData* GeoJSONSource::Impl::getData() const {
-    return data.get();
+std::shared_ptr<GeoJSONData> GeoJSONSource::Impl::getData() const {
+    return data;
+}
+
+double GeoJSONSource::Impl::getTileBuffer() const {
+    return double(options.buffer) / util::tileSize;
 }
 
 optional<std::string> GeoJSONSource::Impl::getAttribution() const {
@@ -2,8 +2,12 @@
 
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/range.hpp>
 
+#include <memory>
+#include <vector>
+
 namespace mbgl {
 
 class AsyncRequest;
@@ -11,26 +15,58 @@ class CanonicalTileID;
 
 namespace style {
 
+// Tiled GeoJSON data. Tiles are cut on the worker threads that lay them out, so implementations
+// must allow getTile() to be called concurrently.
 class GeoJSONData {
 public:
+    // Indexes the given data. This can take a long time for large data sets, so it should be
+    // called on a background thread.
+    static std::shared_ptr<GeoJSONData> create(const GeoJSON&, const GeoJSONOptions&);
+
     virtual ~GeoJSONData() = default;
     virtual mapbox::geometry::feature_collection<int16_t> getTile(const CanonicalTileID&) = 0;
+
+    // Returns a copy of this data with the given changes applied, sharing as much of the tiling
+    // index as possible.
+    virtual std::unique_ptr<GeoJSONData> update(const GeoJSONDiff&) const = 0;
+
+    // Returns the bounds of all features changed since the given data, if this data was derived
+    // from it through update() and the changes are still recorded.
+    optional<std::vector<LatLngBounds>> changedSince(const GeoJSONData&) const;
+
+protected:
+    class Change {
+    public:
+        uint64_t version;
+        std::vector<LatLngBounds> bounds;
+    };
+
+    void recordChange(const GeoJSONData& previous, std::vector<LatLngBounds> bounds);
+
+    // Data derived from the same setGeoJSON() call shares a lineage.
+    uint64_t lineage = 0;
+    uint64_t version = 0;
+    std::vector<Change> changes;
 };
 
 class GeoJSONSource::Impl : public Source::Impl {
 public:
     Impl(std::string id, GeoJSONOptions);
-    Impl(const GeoJSONSource::Impl&, const GeoJSON&);
+    Impl(const GeoJSONSource::Impl&, std::shared_ptr<GeoJSONData>);
     ~Impl() final;
 
+    const GeoJSONOptions& getOptions() const;
     Range<uint8_t> getZoomRange() const;
-    GeoJSONData* getData() const;
+    std::shared_ptr<GeoJSONData> getData() const;
+
+    // Size of the buffer around each tile, as a fraction of the tile size.
+    double getTileBuffer() const;
 
     optional<std::string> getAttribution() const final;
 
 private:
     GeoJSONOptions options;
-    std::unique_ptr<GeoJSONData> data;
+    std::shared_ptr<GeoJSONData> data;
 };
 
 } // namespace style
@@ -33,6 +33,19 @@ optional<std::string> VectorSource::getURL() const {
     return urlOrTileset.get<std::string>();
 }
 
+void VectorSource::setSimplificationTolerance(float pixels) {
+    if (pixels == impl().getSimplificationTolerance()) {
+        return;
+    }
+
+    baseImpl = makeMutable<Impl>(impl(), pixels);
+    observer->onSourceChanged(*this);
+}
+
+float VectorSource::getSimplificationTolerance() const {
+    return impl().getSimplificationTolerance();
+}
+
 void VectorSource::loadDescription(FileSource& fileSource) {
     if (urlOrTileset.is<Tileset>()) {
         baseImpl = makeMutable<Impl>(impl(), urlOrTileset.get<Tileset>());
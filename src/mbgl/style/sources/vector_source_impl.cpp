@@ -9,13 +9,24 @@ VectorSource::Impl::Impl(std::string id_)
 
 VectorSource::Impl::Impl(const Impl& other, Tileset tileset_)
     : Source::Impl(other),
-      tileset(std::move(tileset_)) {
+      tileset(std::move(tileset_)),
+      simplificationTolerance(other.simplificationTolerance) {
+}
+
+VectorSource::Impl::Impl(const Impl& other, float simplificationTolerance_)
+    : Source::Impl(other),
+      tileset(other.tileset),
+      simplificationTolerance(simplificationTolerance_) {
 }
 
 optional<Tileset> VectorSource::Impl::getTileset() const {
     return tileset;
 }
 
+float VectorSource::Impl::getSimplificationTolerance() const {
+    return simplificationTolerance;
+}
+
 optional<std::string> VectorSource::Impl::getAttribution() const {
     if (!tileset) {
         return {};
@@ -358,5 +358,17 @@ Immutable<std::vector<Immutable<Layer::Impl>>> Style::Impl::getLayerImpls() cons
     return layers.getImpls();
 }
 
+Immutable<CollectionJournal<Image::Impl>> Style::Impl::getImageJournal() const {
+    return images.getJournal();
+}
+
+Immutable<CollectionJournal<Source::Impl>> Style::Impl::getSourceJournal() const {
+    return sources.getJournal();
+}
+
+Immutable<CollectionJournal<Layer::Impl>> Style::Impl::getLayerJournal() const {
+    return layers.getJournal();
+}
+
 } // namespace style
 } // namespace mbgl
@@ -89,6 +89,10 @@ public:
     Immutable<std::vector<Immutable<Source::Impl>>> getSourceImpls() const;
     Immutable<std::vector<Immutable<Layer::Impl>>> getLayerImpls() const;
 
+    Immutable<CollectionJournal<Image::Impl>> getImageJournal() const;
+    Immutable<CollectionJournal<Source::Impl>> getSourceJournal() const;
+    Immutable<CollectionJournal<Layer::Impl>> getLayerJournal() const;
+
     void dumpDebugLogs() const;
 
     bool mutated = false;
@@ -3,6 +3,7 @@
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
 
 namespace mbgl {
 
@@ -14,9 +15,24 @@ GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
     updateData(std::move(features));
 }
 
+GeoJSONTile::GeoJSONTile(const OverscaledTileID& overscaledTileID,
+                         std::string sourceID_,
+                         const TileParameters& parameters,
+                         std::shared_ptr<style::GeoJSONData> data)
+    : GeometryTile(overscaledTileID, sourceID_, parameters) {
+    updateData(std::move(data));
+}
+
 void GeoJSONTile::updateData(mapbox::geometry::feature_collection<int16_t> features) {
     setData(std::make_unique<GeoJSONTileData>(std::move(features)));
 }
+
+void GeoJSONTile::updateData(std::shared_ptr<style::GeoJSONData> data) {
+    const CanonicalTileID tileID = id.canonical;
+    setData(std::make_unique<GeoJSONTileData>(std::function<GeoJSONTileData::Features ()>([data, tileID] {
+        return data->getTile(tileID);
+    })));
+}
     
 void GeoJSONTile::querySourceFeatures(
     std::vector<Feature>& result,
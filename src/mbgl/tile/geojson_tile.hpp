@@ -7,6 +7,10 @@ namespace mbgl {
 
 class TileParameters;
 
+namespace style {
+class GeoJSONData;
+} // namespace style
+
 class GeoJSONTile : public GeometryTile {
 public:
     GeoJSONTile(const OverscaledTileID&,
@@ -14,7 +18,15 @@ public:
                 const TileParameters&,
                 mapbox::geometry::feature_collection<int16_t>);
 
+    GeoJSONTile(const OverscaledTileID&,
+                std::string sourceID,
+                const TileParameters&,
+                std::shared_ptr<style::GeoJSONData>);
+
     void updateData(mapbox::geometry::feature_collection<int16_t>);
+
+    // Cuts the tile from the given data on the worker thread.
+    void updateData(std::shared_ptr<style::GeoJSONData>);
     
     void querySourceFeatures(
         std::vector<Feature>& result,
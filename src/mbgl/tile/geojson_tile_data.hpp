@@ -1,5 +1,8 @@
 #include <mbgl/tile/geometry_tile_data.hpp>
 
+#include <functional>
+#include <mutex>
+
 namespace mbgl {
 
 // Implements a simple in-memory Tile type that holds GeoJSON values. A GeoJSON tile can only have
@@ -69,26 +72,61 @@ private:
 
 class GeoJSONTileData : public GeometryTileData {
 public:
-    GeoJSONTileData(mapbox::geometry::feature_collection<int16_t> features_)
-        : features(std::make_shared<mapbox::geometry::feature_collection<int16_t>>(
-              std::move(features_))) {
+    using Features = mapbox::geometry::feature_collection<int16_t>;
+
+    GeoJSONTileData(Features features_)
+        : features(std::make_shared<Lazy>(std::make_shared<Features>(std::move(features_)))) {
     }
 
-    GeoJSONTileData(std::shared_ptr<const mapbox::geometry::feature_collection<int16_t>> features_)
-        : features(std::move(features_)) {
+    GeoJSONTileData(std::shared_ptr<const Features> features_)
+        : features(std::make_shared<Lazy>(std::move(features_))) {
+    }
+
+    // Features are cut by the given function when a layer is first requested, which normally
+    // happens on the worker thread laying out the tile. Clones share the result.
+    GeoJSONTileData(std::function<Features ()> load)
+        : features(std::make_shared<Lazy>(std::move(load))) {
     }
 
     std::unique_ptr<GeometryTileData> clone() const override {
-        return std::make_unique<GeoJSONTileData>(features);
+        return std::unique_ptr<GeometryTileData>(new GeoJSONTileData(features));
     }
 
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string&) const override {
-        return std::make_unique<GeoJSONTileLayer>(features);
+        return std::make_unique<GeoJSONTileLayer>(features->get());
     }
 
-
 private:
-    std::shared_ptr<const mapbox::geometry::feature_collection<int16_t>> features;
+    class Lazy {
+    public:
+        Lazy(std::shared_ptr<const Features> features_)
+            : features(std::move(features_)) {
+            std::call_once(once, [] {});
+        }
+
+        Lazy(std::function<Features ()> load_)
+            : load(std::move(load_)) {
+        }
+
+        std::shared_ptr<const Features> get() {
+            std::call_once(once, [&] {
+                features = std::make_shared<Features>(load());
+                load = nullptr;
+            });
+            return features;
+        }
+
+    private:
+        std::once_flag once;
+        std::function<Features ()> load;
+        std::shared_ptr<const Features> features;
+    };
+
+    GeoJSONTileData(std::shared_ptr<Lazy> features_)
+        : features(std::move(features_)) {
+    }
+
+    std::shared_ptr<Lazy> features;
 };
 
 } // namespace mbgl
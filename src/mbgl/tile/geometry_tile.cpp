@@ -21,6 +21,7 @@
 #include <mbgl/actor/scheduler.hpp>
 
 #include <iostream>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -44,7 +45,8 @@ using namespace style;
 
 GeometryTile::GeometryTile(const OverscaledTileID& id_,
                            std::string sourceID_,
-                           const TileParameters& parameters)
+                           const TileParameters& parameters,
+                           float simplificationTolerance)
     : Tile(id_),
       sourceID(std::move(sourceID_)),
       mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
@@ -55,6 +57,10 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
              obsolete,
              parameters.mode,
              parameters.pixelRatio,
+             parameters.indexType,
+             parameters.compactVertexAttributes,
+             parameters.parallelTessellation ? &parameters.workerScheduler : nullptr,
+             simplificationTolerance,
              parameters.debugOptions & MapDebugOptions::Collision),
       glyphManager(parameters.glyphManager),
       imageManager(parameters.imageManager),
@@ -124,6 +130,39 @@ void GeometryTile::setShowCollisionBoxes(const bool showCollisionBoxes_) {
     }
 }
 
+void GeometryTile::setFeatureState(const LayerFeatureStates& states, const uint64_t version) {
+    featureStateVersion = version;
+
+    // Buckets correspond to the most recent layout, which may not have been committed yet.
+    const GeometryTileData* tileData = pendingData ? pendingData.get() : data.get();
+    if (!tileData || states.empty()) {
+        return;
+    }
+
+    // Buckets are shared between all layers of a layout group.
+    std::unordered_set<const Bucket*> updated;
+    for (auto& entry : nonSymbolBuckets) {
+        Bucket& bucket = *entry.second;
+        if (bucket.featureVertexRanges.empty() || !updated.insert(&bucket).second) {
+            continue;
+        }
+
+        auto layerStates = states.find(bucket.sourceLayer);
+        if (layerStates == states.end()) {
+            continue;
+        }
+
+        auto layer = tileData->getLayer(bucket.sourceLayer);
+        if (layer) {
+            bucket.updateFeatureState(*layer, layerStates->second);
+        }
+    }
+}
+
+uint64_t GeometryTile::getFeatureStateVersion() const {
+    return featureStateVersion;
+}
+
 void GeometryTile::onLayout(LayoutResult result, const uint64_t resultCorrelationID) {
     // Don't mark ourselves loaded or renderable until the first successful placement
     // TODO: Ideally we'd render this tile without symbols as long as this tile wasn't
@@ -132,6 +171,7 @@ void GeometryTile::onLayout(LayoutResult result, const uint64_t resultCorrelatio
     nonSymbolBuckets = std::move(result.nonSymbolBuckets);
     pendingFeatureIndex = std::move(result.featureIndex);
     pendingData = std::move(result.tileData);
+    featureStateVersion = 0;
     observer->onTileChanged(*this);
 }
 
@@ -152,6 +192,25 @@ void GeometryTile::onPlacement(PlacementResult result, const uint64_t resultCorr
     observer->onTileChanged(*this);
 }
 
+void GeometryTile::onPaintPropertiesUpdated(PaintPropertiesResult result, const uint64_t resultCorrelationID) {
+    if (resultCorrelationID == correlationID && !result.placementPending) {
+        pending = false;
+    }
+
+    for (auto& entry : result.buckets) {
+        auto it = nonSymbolBuckets.find(entry.first);
+        if (it != nonSymbolBuckets.end()) {
+            it->second->updatePaintPropertyBinders(*entry.second);
+        }
+    }
+
+    if (!result.buckets.empty()) {
+        featureStateVersion = 0;
+    }
+
+    observer->onTileChanged(*this);
+}
+
 void GeometryTile::onError(std::exception_ptr err, const uint64_t resultCorrelationID) {
     loaded = true;
     if (resultCorrelationID == correlationID) {
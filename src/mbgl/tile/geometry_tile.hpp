@@ -27,7 +27,8 @@ class GeometryTile : public Tile, public GlyphRequestor, ImageRequestor {
 public:
     GeometryTile(const OverscaledTileID&,
                  std::string sourceID,
-                 const TileParameters&);
+                 const TileParameters&,
+                 float simplificationTolerance = 0);
 
     ~GeometryTile() override;
 
@@ -36,6 +37,8 @@ public:
 
     void setLayers(const std::vector<Immutable<style::Layer::Impl>>&) override;
     void setShowCollisionBoxes(const bool showCollisionBoxes) override;
+    void setFeatureState(const LayerFeatureStates&, uint64_t version) override;
+    uint64_t getFeatureStateVersion() const override;
 
     void onGlyphsAvailable(GlyphMap) override;
     void onImagesAvailable(ImageMap, uint64_t imageCorrelationID) override;
@@ -93,6 +96,20 @@ public:
     };
     void onPlacement(PlacementResult, uint64_t correlationID);
 
+    class PaintPropertiesResult {
+    public:
+        // Buckets holding only the new paint property binders, keyed by the ID of the
+        // bucket's leader layer.
+        std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
+        bool placementPending;
+
+        PaintPropertiesResult(std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets_,
+                              bool placementPending_)
+            : buckets(std::move(buckets_)),
+              placementPending(placementPending_) {}
+    };
+    void onPaintPropertiesUpdated(PaintPropertiesResult, uint64_t correlationID);
+
     void onError(std::exception_ptr, uint64_t correlationID);
     
     bool holdForFade() const override;
@@ -134,6 +151,9 @@ private:
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
 
+    // Version of the source's feature states applied to nonSymbolBuckets.
+    uint64_t featureStateVersion = 0;
+
     const MapMode mode;
     
     bool showCollisionBoxes;
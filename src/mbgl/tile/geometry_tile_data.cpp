@@ -51,6 +51,119 @@ GeometryCollection fixupPolygons(const GeometryCollection& rings) {
     return toGeometryCollection(std::move(multipolygon));
 }
 
+static double sqSegmentDistance(const GeometryCoordinate& p, const GeometryCoordinate& a, const GeometryCoordinate& b) {
+    double x = a.x;
+    double y = a.y;
+    double dx = b.x - x;
+    double dy = b.y - y;
+
+    if (dx != 0 || dy != 0) {
+        const double t = ((p.x - x) * dx + (p.y - y) * dy) / (dx * dx + dy * dy);
+        if (t > 1) {
+            x = b.x;
+            y = b.y;
+        } else if (t > 0) {
+            x += dx * t;
+            y += dy * t;
+        }
+    }
+
+    dx = p.x - x;
+    dy = p.y - y;
+    return dx * dx + dy * dy;
+}
+
+static GeometryCoordinates simplifyLine(const GeometryCoordinates& line, double sqTolerance) {
+    if (line.size() <= 2) {
+        return line;
+    }
+
+    std::vector<bool> keep(line.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+
+    std::vector<std::pair<std::size_t, std::size_t>> ranges { { 0, line.size() - 1 } };
+    while (!ranges.empty()) {
+        const auto range = ranges.back();
+        ranges.pop_back();
+
+        double maxDistance = sqTolerance;
+        std::size_t index = 0;
+        for (std::size_t i = range.first + 1; i < range.second; i++) {
+            const double distance = sqSegmentDistance(line[i], line[range.first], line[range.second]);
+            if (distance > maxDistance) {
+                index = i;
+                maxDistance = distance;
+            }
+        }
+
+        if (index) {
+            keep[index] = true;
+            ranges.emplace_back(range.first, index);
+            ranges.emplace_back(index, range.second);
+        }
+    }
+
+    GeometryCoordinates result;
+    for (std::size_t i = 0; i < line.size(); i++) {
+        if (keep[i]) {
+            result.push_back(line[i]);
+        }
+    }
+    return result;
+}
+
+GeometryCollection simplifyGeometries(const GeometryCollection& geometries, FeatureType type, double tolerance) {
+    const double sqTolerance = tolerance * tolerance;
+    GeometryCollection result;
+    result.reserve(geometries.size());
+
+    if (type == FeatureType::LineString) {
+        for (const auto& line : geometries) {
+            result.push_back(simplifyLine(line, sqTolerance));
+        }
+        return result;
+    }
+
+    if (type != FeatureType::Polygon) {
+        return geometries;
+    }
+
+    // Rings are classified like classifyRings() does, so that the holes of a dropped outer
+    // ring don't end up in the polygon before it.
+    int8_t ccw = 0;
+    bool dropHoles = false;
+
+    for (const auto& ring : geometries) {
+        const double area = signedArea(ring);
+        if (area == 0)
+            continue;
+
+        const int8_t winding = area < 0 ? -1 : 1;
+        if (ccw == 0)
+            ccw = winding;
+
+        const bool outer = winding == ccw;
+        if (!outer && dropHoles)
+            continue;
+
+        GeometryCoordinates simplified = simplifyLine(ring, sqTolerance);
+        const double simplifiedArea = signedArea(simplified);
+        if (simplifiedArea == 0 || (simplifiedArea < 0 ? -1 : 1) != winding) {
+            if (outer)
+                dropHoles = true;
+            continue;
+        }
+
+        if (outer)
+            dropHoles = false;
+
+        result.push_back(std::move(simplified));
+    }
+
+    return result;
+}
+
 std::vector<GeometryCollection> classifyRings(const GeometryCollection& rings) {
     std::vector<GeometryCollection> polygons;
 
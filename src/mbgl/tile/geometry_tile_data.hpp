@@ -82,6 +82,11 @@ Feature convertFeature(const GeometryTileFeature&, const CanonicalTileID&);
 // The result is guaranteed to have correctly wound, strictly simple rings.
 GeometryCollection fixupPolygons(const GeometryCollection&);
 
+// Simplifies lines and polygon rings with the Douglas-Peucker algorithm, dropping the points that
+// are within `tolerance` tile units of the simplified geometry. Rings that collapse or flip their
+// winding are dropped, along with the holes of a dropped outer ring.
+GeometryCollection simplifyGeometries(const GeometryCollection&, FeatureType, double tolerance);
+
 struct ToGeometryCollection {
     GeometryCollection operator()(const mapbox::geometry::point<int16_t>& geom) const {
         return { { geom } };
@@ -7,6 +7,8 @@
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
+#include <mbgl/renderer/layers/render_fill_layer.hpp>
+#include <mbgl/renderer/layers/render_line_layer.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/util/logging.hpp>
@@ -27,6 +29,10 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_,
                                        const float pixelRatio_,
+                                       const gl::IndexType indexType_,
+                                       const bool compactVertexAttributes_,
+                                       Scheduler* tessellationScheduler_,
+                                       const float simplificationTolerance_,
                                        const bool showCollisionBoxes_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
@@ -35,6 +41,10 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
       obsolete(obsolete_),
       mode(mode_),
       pixelRatio(pixelRatio_),
+      indexType(indexType_),
+      compactVertexAttributes(compactVertexAttributes_),
+      tessellationScheduler(tessellationScheduler_),
+      simplificationTolerance(simplificationTolerance_),
       showCollisionBoxes(showCollisionBoxes_) {
 }
 
@@ -88,6 +98,7 @@ GeometryTileWorker::~GeometryTileWorker() = default;
 void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_, uint64_t correlationID_) {
     try {
         data = std::move(data_);
+        dataChanged = true;
         correlationID = correlationID_;
 
         switch (state) {
@@ -284,6 +295,13 @@ void GeometryTileWorker::redoLayout() {
         return;
     }
 
+    // Create render layers and group by layout
+    std::vector<std::unique_ptr<RenderLayer>> renderLayers = toRenderLayers(*layers, id.overscaledZ);
+
+    if (updatePaintProperties(renderLayers)) {
+        return;
+    }
+
     std::vector<std::string> symbolOrder;
     for (auto it = layers->rbegin(); it != layers->rend(); it++) {
         if ((*it)->type == LayerType::Symbol) {
@@ -294,15 +312,23 @@ void GeometryTileWorker::redoLayout() {
     std::unordered_map<std::string, std::unique_ptr<SymbolLayout>> symbolLayoutMap;
     std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
     auto featureIndex = std::make_unique<FeatureIndex>();
-    BucketParameters parameters { id, mode, pixelRatio };
+    BucketParameters parameters { id, mode, pixelRatio, indexType, compactVertexAttributes, tessellationScheduler };
 
     GlyphDependencies glyphDependencies;
     ImageDependencies imageDependencies;
 
-    // Create render layers and group by layout
-    std::vector<std::unique_ptr<RenderLayer>> renderLayers = toRenderLayers(*layers, id.overscaledZ);
     std::vector<std::vector<const RenderLayer*>> groups = groupByLayout(renderLayers);
 
+    std::unordered_map<std::string, std::vector<std::pair<std::size_t, std::size_t>>> features;
+    bool paintUpdatesSupported = true;
+
+    // The simplification tolerance in tile units at the zoom level the tile is laid out for. The
+    // tile is shown up to half a zoom level above it, where the tolerance covers ~1.4x as many
+    // pixels. Overzoomed tiles magnify the geometry of their canonical tile, so they keep more.
+    const double tolerance = simplificationTolerance > 0
+        ? id.toUnwrapped().pixelsToTileUnits(simplificationTolerance / pixelRatio, id.overscaledZ)
+        : 0;
+
     for (auto& group : groups) {
         if (obsolete) {
             return;
@@ -335,6 +361,10 @@ void GeometryTileWorker::redoLayout() {
             const Filter& filter = leader.baseImpl->filter;
             const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
             std::shared_ptr<Bucket> bucket = leader.createBucket(parameters, group);
+            const bool recordFeatures = bucket->supportsPaintPropertyUpdates();
+            const bool simplify = tolerance > 0 && (leader.is<RenderFillLayer>() || leader.is<RenderLineLayer>());
+            std::vector<std::pair<std::size_t, std::size_t>> bucketFeatures;
+            bucket->sourceLayer = sourceLayerID;
 
             for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
                 std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
@@ -342,15 +372,41 @@ void GeometryTileWorker::redoLayout() {
                 if (!filter(expression::EvaluationContext { static_cast<float>(this->id.overscaledZ), feature.get() }))
                     continue;
 
+                const std::size_t start = bucket->getVertexCount();
                 GeometryCollection geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries);
+                if (simplify) {
+                    GeometryCollection simplified = simplifyGeometries(geometries, feature->getType(), tolerance);
+                    if (!simplified.empty()) {
+                        bucket->addFeature(*feature, simplified);
+                    }
+                } else {
+                    bucket->addFeature(*feature, geometries);
+                }
                 featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
+
+                if (recordFeatures) {
+                    const std::size_t end = bucket->getVertexCount();
+                    bucketFeatures.emplace_back(i, end);
+
+                    optional<FeatureIdentifier> featureID = feature->getID();
+                    if (featureID && end > start) {
+                        bucket->featureVertexRanges[featureIDtoString(*featureID)].push_back({ i, start, end });
+                    }
+                }
             }
 
+            bucket->finishFeatures();
+
             if (!bucket->hasData()) {
                 continue;
             }
 
+            if (recordFeatures) {
+                features.emplace(leader.getID(), std::move(bucketFeatures));
+            } else {
+                paintUpdatesSupported = false;
+            }
+
             for (const auto& layer : group) {
                 buckets.emplace(layer->getID(), bucket);
             }
@@ -374,9 +430,91 @@ void GeometryTileWorker::redoLayout() {
         *data ? (*data)->clone() : nullptr,
     }, correlationID);
 
+    dataChanged = false;
+    laidOutLayers = *layers;
+    laidOutLayoutKeys.clear();
+    for (const auto& layer : renderLayers) {
+        laidOutLayoutKeys.push_back(layoutKey(*layer));
+    }
+    laidOutFeatures = std::move(features);
+    paintPropertyUpdatesSupported = paintUpdatesSupported;
+
     attemptPlacement();
 }
 
+// Data-driven paint properties are the only layer properties that affect non-symbol buckets
+// without affecting their layout. If nothing but those changed since the last layout, rebuild
+// just the paint property binders of the affected buckets from the features recorded during
+// that layout. Returns false if a full layout is required.
+bool GeometryTileWorker::updatePaintProperties(const std::vector<std::unique_ptr<RenderLayer>>& renderLayers) {
+    if (dataChanged || !paintPropertyUpdatesSupported || !*data || renderLayers.size() != laidOutLayers.size()) {
+        return false;
+    }
+
+    bool changed = false;
+
+    for (std::size_t i = 0; i < renderLayers.size(); i++) {
+        const RenderLayer& layer = *renderLayers[i];
+        const Immutable<Layer::Impl>& laidOut = laidOutLayers[i];
+
+        if (layer.baseImpl == laidOut) {
+            continue;
+        }
+
+        // Symbol paint properties are evaluated during symbol layout.
+        if (layer.getID() != laidOut->id ||
+            layer.is<RenderSymbolLayer>() ||
+            layoutKey(layer) != laidOutLayoutKeys[i]) {
+            return false;
+        }
+
+        changed = true;
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
+    BucketParameters parameters { id, mode, pixelRatio, indexType, compactVertexAttributes, tessellationScheduler };
+
+    if (changed) {
+        for (auto& group : groupByLayout(renderLayers)) {
+            const RenderLayer& leader = *group.at(0);
+
+            auto it = laidOutFeatures.find(leader.getID());
+            if (it == laidOutFeatures.end()) {
+                continue; // Symbol layer, or no bucket was created for this group.
+            }
+
+            auto geometryLayer = (*data)->getLayer(leader.baseImpl->sourceLayer);
+            if (!geometryLayer) {
+                continue;
+            }
+
+            std::shared_ptr<Bucket> bucket = leader.createBucket(parameters, group);
+
+            for (const auto& feature : it->second) {
+                if (obsolete) {
+                    return true;
+                }
+
+                bucket->populatePaintPropertyBinders(*geometryLayer->getFeature(feature.first), feature.second);
+            }
+
+            buckets.emplace(leader.getID(), std::move(bucket));
+        }
+    }
+
+    laidOutLayers = *layers;
+
+    // If placement for the last layout is still outstanding, it completes the tile instead.
+    const bool placementPending = symbolLayoutsNeedPreparation || hasPendingSymbolDependencies();
+
+    parent.invoke(&GeometryTile::onPaintPropertiesUpdated, GeometryTile::PaintPropertiesResult {
+        std::move(buckets),
+        placementPending,
+    }, correlationID);
+
+    return true;
+}
+
 bool GeometryTileWorker::hasPendingSymbolDependencies() const {
     for (auto& glyphDependency : pendingGlyphDependencies) {
         if (!glyphDependency.second.empty()) {
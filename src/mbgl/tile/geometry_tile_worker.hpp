@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/gl/types.hpp>
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/style/image_impl.hpp>
@@ -11,12 +12,18 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 
 class GeometryTile;
 class GeometryTileData;
 class SymbolLayout;
+class Scheduler;
+class RenderLayer;
 
 namespace style {
 class Layer;
@@ -31,6 +38,10 @@ public:
                        const std::atomic<bool>&,
                        const MapMode,
                        const float pixelRatio,
+                       const gl::IndexType,
+                       const bool compactVertexAttributes,
+                       Scheduler* tessellationScheduler,
+                       const float simplificationTolerance,
                        const bool showCollisionBoxes_);
     ~GeometryTileWorker();
 
@@ -44,6 +55,7 @@ public:
 private:
     void coalesced();
     void redoLayout();
+    bool updatePaintProperties(const std::vector<std::unique_ptr<RenderLayer>>&);
     void attemptPlacement();
     
     void coalesce();
@@ -62,6 +74,10 @@ private:
     const std::atomic<bool>& obsolete;
     const MapMode mode;
     const float pixelRatio;
+    const gl::IndexType indexType;
+    const bool compactVertexAttributes;
+    Scheduler* const tessellationScheduler;
+    const float simplificationTolerance;
 
     enum State {
         Idle,
@@ -78,6 +94,14 @@ private:
     optional<std::vector<Immutable<style::Layer::Impl>>> layers;
     optional<std::unique_ptr<const GeometryTileData>> data;
 
+    // State of the last completed layout, used to detect paint-only layer changes and update
+    // the paint attributes of the resulting buckets without laying them out again.
+    bool dataChanged = true;
+    std::vector<Immutable<style::Layer::Impl>> laidOutLayers;
+    std::vector<std::string> laidOutLayoutKeys;
+    std::unordered_map<std::string, std::vector<std::pair<std::size_t, std::size_t>>> laidOutFeatures;
+    bool paintPropertyUpdatesSupported = false;
+
     bool symbolLayoutsNeedPreparation = false;
     std::vector<std::unique_ptr<SymbolLayout>> symbolLayouts;
     GlyphDependencies pendingGlyphDependencies;
@@ -19,9 +19,18 @@ RasterDEMTile::RasterDEMTile(const OverscaledTileID& id_,
       loader(*this, id_, parameters, tileset),
       mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
       worker(parameters.workerScheduler,
-             ActorRef<RasterDEMTile>(*this, mailbox)) {
+             ActorRef<RasterDEMTile>(*this, mailbox),
+             parameters.prepareHillshadeOnWorkers,
+             id_.canonical.z,
+             tileset.zoomRange.max) {
 
     encoding = tileset.encoding;
+    resetNeighboringTiles();
+}
+
+void RasterDEMTile::resetNeighboringTiles() {
+    neighboringTiles = DEMTileNeighbors::Empty;
+
     if ( id.canonical.y == 0 ){
         // this tile doesn't have upper neighboring tiles so marked those as backfilled
         neighboringTiles = neighboringTiles | DEMTileNeighbors::NoUpper;
@@ -53,6 +62,8 @@ void RasterDEMTile::setData(std::shared_ptr<const std::string> data) {
 
 void RasterDEMTile::onParsed(std::unique_ptr<HillshadeBucket> result, const uint64_t resultCorrelationID) {
     bucket = std::move(result);
+    // A new bucket's border hasn't been backfilled yet, even if the previous one's was.
+    resetNeighboringTiles();
     loaded = true;
     if (resultCorrelationID == correlationID) {
         pending = false;
@@ -100,15 +111,9 @@ void RasterDEMTile::backfillBorder(const RasterDEMTile& borderTile, const DEMTil
     }
     const HillshadeBucket* borderBucket = borderTile.getBucket();
     if (borderBucket) {
-        const DEMData& borderDEM = borderBucket->getDEMData();
-        DEMData& tileDEM = bucket->getDEMData();
-
-        tileDEM.backfillBorder(borderDEM, dx, dy);
+        bucket->backfillBorder(*borderBucket, dx, dy);
         // update the bitmask to indicate that this tiles have been backfilled by flipping the relevant bit
         this->neighboringTiles = this->neighboringTiles | mask;
-        // mark HillshadeBucket.prepared as false so it runs through the prepare render pass
-        // with the new texture data we just backfilled
-        bucket->setPrepared(false);
     }
 }
 
@@ -88,6 +88,10 @@ public:
     void onError(std::exception_ptr, uint64_t correlationID);
 
 private:
+    // Marks the borders of tiles at the top or bottom of the world, which have no neighbors, as
+    // backfilled, and all others as not.
+    void resetNeighboringTiles();
+
     TileLoader<RasterDEMTile> loader;
 
     std::shared_ptr<Mailbox> mailbox;
@@ -2,12 +2,17 @@
 #include <mbgl/tile/raster_dem_tile.hpp>
 #include <mbgl/renderer/buckets/hillshade_bucket.hpp>
 #include <mbgl/actor/actor.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/premultiply.hpp>
 
 namespace mbgl {
 
-RasterDEMTileWorker::RasterDEMTileWorker(ActorRef<RasterDEMTileWorker>, ActorRef<RasterDEMTile> parent_)
-    : parent(std::move(parent_)) {
+RasterDEMTileWorker::RasterDEMTileWorker(ActorRef<RasterDEMTileWorker>, ActorRef<RasterDEMTile> parent_,
+                                         bool prepareHillshade_, uint8_t zoom_, uint8_t maxzoom_)
+    : parent(std::move(parent_)),
+      prepareHillshade(prepareHillshade_),
+      zoom(zoom_),
+      maxzoom(maxzoom_) {
 }
 
 void RasterDEMTileWorker::parse(std::shared_ptr<const std::string> data, uint64_t correlationID, Tileset::DEMEncoding encoding) {
@@ -17,7 +22,12 @@ void RasterDEMTileWorker::parse(std::shared_ptr<const std::string> data, uint64_
     }
 
     try {
+        data = util::inflateIfCompressed(std::move(data));
         auto bucket = std::make_unique<HillshadeBucket>(decodeImage(*data), encoding);
+        if (prepareHillshade) {
+            // Edges are prepared again once the border is backfilled from neighboring tiles.
+            bucket->prepare(zoom, maxzoom);
+        }
         parent.invoke(&RasterDEMTile::onParsed, std::move(bucket), correlationID);
     } catch (...) {
         parent.invoke(&RasterDEMTile::onError, std::current_exception(), correlationID);
@@ -12,12 +12,18 @@ class RasterDEMTile;
 
 class RasterDEMTileWorker {
 public:
-    RasterDEMTileWorker(ActorRef<RasterDEMTileWorker>, ActorRef<RasterDEMTile>);
+    // With `prepareHillshade`, the slopes of the tile at `zoom` of a source with tiles up to
+    // `maxzoom` are computed on the worker, instead of in the hillshade_prepare render pass.
+    RasterDEMTileWorker(ActorRef<RasterDEMTileWorker>, ActorRef<RasterDEMTile>,
+                        bool prepareHillshade = false, uint8_t zoom = 0, uint8_t maxzoom = 0);
 
     void parse(std::shared_ptr<const std::string> data, uint64_t correlationID, Tileset::DEMEncoding encoding);
 
 private:
     ActorRef<RasterDEMTile> parent;
+    const bool prepareHillshade;
+    const uint8_t zoom;
+    const uint8_t maxzoom;
 };
 
 } // namespace mbgl
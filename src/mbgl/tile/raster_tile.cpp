@@ -19,7 +19,8 @@ RasterTile::RasterTile(const OverscaledTileID& id_,
       loader(*this, id_, parameters, tileset),
       mailbox(std::make_shared<Mailbox>(*Scheduler::GetCurrent())),
       worker(parameters.workerScheduler,
-             ActorRef<RasterTile>(*this, mailbox)) {
+             ActorRef<RasterTile>(*this, mailbox),
+             parameters.rasterTextureCompression) {
 }
 
 RasterTile::~RasterTile() = default;
@@ -68,6 +69,10 @@ Bucket* RasterTile::getBucket(const style::Layer::Impl&) const {
     return bucket.get();
 }
 
+RasterBucket* RasterTile::getBucket() const {
+    return bucket.get();
+}
+
 void RasterTile::setMask(TileMask&& mask) {
     if (bucket) {
         bucket->setMask(std::move(mask));
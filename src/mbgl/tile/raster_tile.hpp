@@ -30,6 +30,7 @@ public:
 
     void upload(gl::Context&) override;
     Bucket* getBucket(const style::Layer::Impl&) const override;
+    RasterBucket* getBucket() const;
 
     void setMask(TileMask&&) override;
 
@@ -2,12 +2,16 @@
 #include <mbgl/tile/raster_tile.hpp>
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/actor/actor.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/mipmap.hpp>
 #include <mbgl/util/premultiply.hpp>
 
 namespace mbgl {
 
-RasterTileWorker::RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile> parent_)
-    : parent(std::move(parent_)) {
+RasterTileWorker::RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile> parent_,
+                                   optional<CompressedImageFormat> compression_)
+    : parent(std::move(parent_)),
+      compression(std::move(compression_)) {
 }
 
 void RasterTileWorker::parse(std::shared_ptr<const std::string> data, uint64_t correlationID) {
@@ -17,7 +21,28 @@ void RasterTileWorker::parse(std::shared_ptr<const std::string> data, uint64_t c
     }
 
     try {
-        auto bucket = std::make_unique<RasterBucket>(decodeImage(*data));
+        data = util::inflateIfCompressed(std::move(data));
+        PremultipliedImage image = decodeImage(*data);
+        std::vector<PremultipliedImage> mipmaps = util::mipmaps(image);
+
+        // Opaque tiles are encoded in a block compressed texture format, if enabled. Others
+        // stay RGBA. Mipmaps of opaque images are opaque too.
+        optional<CompressedImage> compressed;
+        if (compression) {
+            compressed = util::compress(image, *compression);
+        }
+
+        std::unique_ptr<RasterBucket> bucket;
+        if (compressed) {
+            std::vector<CompressedImage> compressedMipmaps;
+            compressedMipmaps.reserve(mipmaps.size());
+            for (const auto& level : mipmaps) {
+                compressedMipmaps.push_back(std::move(*util::compress(level, *compression)));
+            }
+            bucket = std::make_unique<RasterBucket>(std::move(*compressed), std::move(compressedMipmaps));
+        } else {
+            bucket = std::make_unique<RasterBucket>(std::move(image), std::move(mipmaps));
+        }
         parent.invoke(&RasterTile::onParsed, std::move(bucket), correlationID);
     } catch (...) {
         parent.invoke(&RasterTile::onError, std::current_exception(), correlationID);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/compressed_image.hpp>
+#include <mbgl/util/optional.hpp>
 
 #include <memory>
 #include <string>
@@ -11,12 +13,13 @@ class RasterTile;
 
 class RasterTileWorker {
 public:
-    RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile>);
+    RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile>, optional<CompressedImageFormat>);
 
     void parse(std::shared_ptr<const std::string> data, uint64_t correlationID);
 
 private:
     ActorRef<RasterTile> parent;
+    const optional<CompressedImageFormat> compression;
 };
 
 } // namespace mbgl
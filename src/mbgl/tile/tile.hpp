@@ -52,6 +52,14 @@ public:
     virtual void setLayers(const std::vector<Immutable<style::Layer::Impl>>&) {}
     virtual void setMask(TileMask&&) {}
 
+    // Applies feature states to the tile's buckets and records the version of the source's
+    // feature states they correspond to. Tiles report version 0 when they hold buckets that
+    // don't reflect any feature state yet.
+    virtual void setFeatureState(const LayerFeatureStates&, uint64_t /* version */) {}
+    virtual uint64_t getFeatureStateVersion() const {
+        return 0;
+    }
+
     virtual void queryRenderedFeatures(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
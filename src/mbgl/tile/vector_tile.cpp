@@ -8,8 +8,9 @@ namespace mbgl {
 VectorTile::VectorTile(const OverscaledTileID& id_,
                        std::string sourceID_,
                        const TileParameters& parameters,
-                       const Tileset& tileset)
-    : GeometryTile(id_, sourceID_, parameters), loader(*this, id_, parameters, tileset) {
+                       const Tileset& tileset,
+                       float simplificationTolerance)
+    : GeometryTile(id_, sourceID_, parameters, simplificationTolerance), loader(*this, id_, parameters, tileset) {
 }
 
 void VectorTile::setNecessity(TileNecessity necessity) {
@@ -13,7 +13,8 @@ public:
     VectorTile(const OverscaledTileID&,
                std::string sourceID,
                const TileParameters&,
-               const Tileset&);
+               const Tileset&,
+               float simplificationTolerance = 0);
 
     void setNecessity(TileNecessity) final;
     void setMetadata(optional<Timestamp> modified, optional<Timestamp> expires);
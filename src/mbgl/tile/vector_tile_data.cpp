@@ -1,4 +1,5 @@
 #include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/constants.hpp>
 
 namespace mbgl {
@@ -71,7 +72,7 @@ std::unique_ptr<GeometryTileLayer> VectorTileData::getLayer(const std::string& n
     if (!parsed) {
         // We're parsing this lazily so that we can construct VectorTileData objects on the main
         // thread without incurring the overhead of parsing immediately.
-        layers = mapbox::vector_tile::buffer(*data).getLayers();
+        layers = mapbox::vector_tile::buffer(inflated()).getLayers();
         parsed = true;
     }
 
@@ -83,7 +84,12 @@ std::unique_ptr<GeometryTileLayer> VectorTileData::getLayer(const std::string& n
 }
 
 std::vector<std::string> VectorTileData::layerNames() const {
-    return mapbox::vector_tile::buffer(*data).layerNames();
+    return mapbox::vector_tile::buffer(inflated()).layerNames();
+}
+
+const std::string& VectorTileData::inflated() const {
+    data = util::inflateIfCompressed(std::move(data));
+    return *data;
 }
 
 } // namespace mbgl
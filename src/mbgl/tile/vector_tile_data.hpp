@@ -46,7 +46,9 @@ public:
     std::vector<std::string> layerNames() const;
 
 private:
-    std::shared_ptr<const std::string> data;
+    const std::string& inflated() const;
+
+    mutable std::shared_ptr<const std::string> data;
     mutable bool parsed = false;
     mutable std::map<std::string, const protozero::data_view> layers;
 };
@@ -0,0 +1,386 @@
+#include <mbgl/util/compressed_image.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+using RGB = std::array<int32_t, 3>;
+
+// The pixels of a 4x4 block, row by row. Blocks reaching past the edge of the image repeat its
+// last row and column.
+using Block = std::array<RGB, 16>;
+
+Block readBlock(const PremultipliedImage& image, uint32_t blockX, uint32_t blockY) {
+    Block block;
+    for (uint32_t y = 0; y < 4; y++) {
+        const uint32_t sy = std::min(blockY * 4 + y, image.size.height - 1);
+        for (uint32_t x = 0; x < 4; x++) {
+            const uint32_t sx = std::min(blockX * 4 + x, image.size.width - 1);
+            const uint8_t* pixel = image.data.get() + sy * image.stride() + sx * 4;
+            block[y * 4 + x] = {{ pixel[0], pixel[1], pixel[2] }};
+        }
+    }
+    return block;
+}
+
+int32_t distance(const RGB& a, const RGB& b) {
+    const int32_t dr = a[0] - b[0];
+    const int32_t dg = a[1] - b[1];
+    const int32_t db = a[2] - b[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+// BC1
+
+uint16_t packRGB565(const std::array<float, 3>& color) {
+    auto quantize = [](float value, int32_t max) {
+        return static_cast<uint16_t>(std::max(0, std::min(max, int32_t(std::lround(value * max / 255.0f)))));
+    };
+    return quantize(color[0], 31) << 11 | quantize(color[1], 63) << 5 | quantize(color[2], 31);
+}
+
+RGB unpackRGB565(uint16_t color) {
+    const int32_t r = color >> 11;
+    const int32_t g = (color >> 5) & 0x3F;
+    const int32_t b = color & 0x1F;
+    return {{ r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2 }};
+}
+
+// Picks the closest of the four palette colors for each pixel, and returns the total error.
+int32_t fitBC1(const Block& block, uint16_t color0, uint16_t color1, uint32_t& indices) {
+    const RGB c0 = unpackRGB565(color0);
+    const RGB c1 = unpackRGB565(color1);
+    std::array<RGB, 4> palette {{ c0, c1, {}, {} }};
+    for (std::size_t i = 0; i < 3; i++) {
+        palette[2][i] = (2 * c0[i] + c1[i]) / 3;
+        palette[3][i] = (c0[i] + 2 * c1[i]) / 3;
+    }
+
+    int32_t error = 0;
+    indices = 0;
+    for (std::size_t p = 0; p < 16; p++) {
+        uint32_t best = 0;
+        int32_t bestError = std::numeric_limits<int32_t>::max();
+        for (uint32_t i = 0; i < 4; i++) {
+            const int32_t e = distance(block[p], palette[i]);
+            if (e < bestError) {
+                best = i;
+                bestError = e;
+            }
+        }
+        indices |= best << (2 * p);
+        error += bestError;
+    }
+    return error;
+}
+
+// Orders the endpoints for the four color mode, and fits the pixels to them.
+int32_t encodeBC1Endpoints(const Block& block, uint16_t a, uint16_t b, uint8_t* dst) {
+    uint16_t color0 = std::max(a, b);
+    uint16_t color1 = std::min(a, b);
+    uint32_t indices = 0;
+    int32_t error = 0;
+
+    if (color0 == color1) {
+        // Both endpoints are the same, which would select the three color mode. All pixels use
+        // the first endpoint, which is the only color of the palette.
+        for (const RGB& pixel : block) {
+            error += distance(pixel, unpackRGB565(color0));
+        }
+    } else {
+        error = fitBC1(block, color0, color1, indices);
+    }
+
+    dst[0] = color0 & 0xFF;
+    dst[1] = color0 >> 8;
+    dst[2] = color1 & 0xFF;
+    dst[3] = color1 >> 8;
+    dst[4] = indices & 0xFF;
+    dst[5] = (indices >> 8) & 0xFF;
+    dst[6] = (indices >> 16) & 0xFF;
+    dst[7] = indices >> 24;
+    return error;
+}
+
+void encodeBC1(const Block& block, uint8_t* dst) {
+    // Fit a line through the colors of the block along their principal axis.
+    std::array<float, 3> mean {{ 0, 0, 0 }};
+    for (const RGB& pixel : block) {
+        for (std::size_t i = 0; i < 3; i++) {
+            mean[i] += pixel[i] / 16.0f;
+        }
+    }
+
+    std::array<float, 6> covariance {{ 0, 0, 0, 0, 0, 0 }};
+    for (const RGB& pixel : block) {
+        const float r = pixel[0] - mean[0];
+        const float g = pixel[1] - mean[1];
+        const float b = pixel[2] - mean[2];
+        covariance[0] += r * r;
+        covariance[1] += r * g;
+        covariance[2] += r * b;
+        covariance[3] += g * g;
+        covariance[4] += g * b;
+        covariance[5] += b * b;
+    }
+
+    std::array<float, 3> axis {{ 1, 1, 1 }};
+    for (int iteration = 0; iteration < 4; iteration++) {
+        const std::array<float, 3> next {{
+            covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+            covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+            covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+        }};
+        const float length = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+        if (length < 1e-6f) {
+            break;
+        }
+        axis = {{ next[0] / length, next[1] / length, next[2] / length }};
+    }
+
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = std::numeric_limits<float>::lowest();
+    for (const RGB& pixel : block) {
+        const float projection = (pixel[0] - mean[0]) * axis[0] +
+                                 (pixel[1] - mean[1]) * axis[1] +
+                                 (pixel[2] - mean[2]) * axis[2];
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+
+    // Inset the endpoints slightly, since the extremes are rarely worth representing exactly.
+    const float axisLength = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    const float inset = (maxProjection - minProjection) / 16.0f;
+    std::array<float, 3> start, end;
+    for (std::size_t i = 0; i < 3; i++) {
+        const float scale = axisLength > 0 ? axis[i] / axisLength : 0;
+        start[i] = mean[i] + (minProjection + inset) * scale;
+        end[i] = mean[i] + (maxProjection - inset) * scale;
+    }
+
+    const int32_t error = encodeBC1Endpoints(block, packRGB565(start), packRGB565(end), dst);
+
+    // Refine the endpoints once with a least squares fit to the chosen palette entries.
+    const uint32_t indices = dst[4] | dst[5] << 8 | dst[6] << 16 | uint32_t(dst[7]) << 24;
+    const std::array<float, 4> weights {{ 1.0f, 0.0f, 2.0f / 3, 1.0f / 3 }};
+    float aa = 0, ab = 0, bb = 0;
+    std::array<float, 3> ax {{ 0, 0, 0 }}, bx {{ 0, 0, 0 }};
+    for (std::size_t p = 0; p < 16; p++) {
+        const float w = weights[(indices >> (2 * p)) & 3];
+        aa += w * w;
+        ab += w * (1 - w);
+        bb += (1 - w) * (1 - w);
+        for (std::size_t i = 0; i < 3; i++) {
+            ax[i] += w * block[p][i];
+            bx[i] += (1 - w) * block[p][i];
+        }
+    }
+
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f) {
+        return;
+    }
+
+    std::array<float, 3> color0, color1;
+    for (std::size_t i = 0; i < 3; i++) {
+        color0[i] = (ax[i] * bb - bx[i] * ab) / determinant;
+        color1[i] = (bx[i] * aa - ax[i] * ab) / determinant;
+    }
+
+    uint8_t refined[8];
+    if (encodeBC1Endpoints(block, packRGB565(color0), packRGB565(color1), refined) < error) {
+        std::copy(refined, refined + 8, dst);
+    }
+}
+
+// ETC1
+
+// The intensity modifiers of each table, for the small and the large modifier.
+const int32_t etc1Modifiers[8][2] = {
+    { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+};
+
+// The modifier each index selects: bit 0 picks the large modifier, bit 1 negates it.
+int32_t etc1Modifier(uint32_t table, uint32_t index) {
+    const int32_t modifier = etc1Modifiers[table][index & 1];
+    return index & 2 ? -modifier : modifier;
+}
+
+struct SubblockFit {
+    int32_t error = std::numeric_limits<int32_t>::max();
+    uint32_t table = 0;
+    std::array<uint32_t, 8> indices;
+};
+
+// Finds the table and per pixel modifiers that best fit the pixels of a subblock to its base
+// color. Since the modifier is added to all channels, the error of modifier m for a pixel that
+// differs from the base color by d is |d|² - 2m(dr + dg + db) + 3m². Clamping the modified color
+// to the valid range only ever moves it closer to the pixel, so this is an upper bound.
+SubblockFit fitSubblock(const std::array<RGB, 8>& pixels, const RGB& base) {
+    std::array<int32_t, 8> sum;
+    int32_t squares = 0;
+    for (std::size_t p = 0; p < 8; p++) {
+        const RGB d {{ pixels[p][0] - base[0], pixels[p][1] - base[1], pixels[p][2] - base[2] }};
+        sum[p] = d[0] + d[1] + d[2];
+        squares += d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    }
+
+    SubblockFit best;
+    for (uint32_t table = 0; table < 8; table++) {
+        SubblockFit fit;
+        fit.error = squares;
+        fit.table = table;
+        // The error is smallest for the modifier closest to (dr + dg + db) / 3.
+        const int32_t threshold = 3 * (etc1Modifiers[table][0] + etc1Modifiers[table][1]);
+        for (std::size_t p = 0; p < 8; p++) {
+            const int32_t twice = 2 * sum[p];
+            const uint32_t index = twice >= 0 ? (twice > threshold ? 1 : 0) : (twice < -threshold ? 3 : 2);
+            const int32_t modifier = etc1Modifier(table, index);
+            fit.indices[p] = index;
+            fit.error += 3 * modifier * modifier - 2 * modifier * sum[p];
+        }
+        if (fit.error < best.error) {
+            best = fit;
+        }
+    }
+    return best;
+}
+
+// Returns the position of the pixels of each subblock in the block. Without flipping, the
+// subblocks are the left and right 2x4 pixels, with flipping the top and bottom 4x2 pixels.
+std::array<std::size_t, 8> subblockPixels(bool flip, std::size_t subblock) {
+    std::array<std::size_t, 8> positions;
+    for (std::size_t i = 0; i < 8; i++) {
+        const std::size_t x = flip ? i % 4 : subblock * 2 + i % 2;
+        const std::size_t y = flip ? subblock * 2 + i / 4 : i / 2;
+        positions[i] = y * 4 + x;
+    }
+    return positions;
+}
+
+void encodeETC1(const Block& block, uint8_t* dst) {
+    int32_t bestError = std::numeric_limits<int32_t>::max();
+    uint32_t bestHigh = 0;
+    uint32_t bestLow = 0;
+
+    for (const bool flip : { false, true }) {
+        std::array<std::array<std::size_t, 8>, 2> positions {{ subblockPixels(flip, 0), subblockPixels(flip, 1) }};
+        std::array<std::array<RGB, 8>, 2> pixels;
+        std::array<std::array<float, 3>, 2> average {{ {{ 0, 0, 0 }}, {{ 0, 0, 0 }} }};
+        for (std::size_t s = 0; s < 2; s++) {
+            for (std::size_t p = 0; p < 8; p++) {
+                pixels[s][p] = block[positions[s][p]];
+                for (std::size_t i = 0; i < 3; i++) {
+                    average[s][i] += pixels[s][p][i] / 8.0f;
+                }
+            }
+        }
+
+        for (const bool differential : { true, false }) {
+            // Differential mode stores the first base color in 5 bits per channel, and the
+            // second as a 3 bit offset to it. Individual mode stores both in 4 bits per channel.
+            const int32_t max = differential ? 31 : 15;
+            std::array<RGB, 2> quantized;
+            std::array<RGB, 2> base;
+            for (std::size_t s = 0; s < 2; s++) {
+                for (std::size_t i = 0; i < 3; i++) {
+                    const int32_t q = std::max(0, std::min(max, int32_t(std::lround(average[s][i] * max / 255.0f))));
+                    quantized[s][i] = q;
+                    base[s][i] = differential ? (q << 3 | q >> 2) : (q << 4 | q);
+                }
+            }
+
+            if (differential) {
+                bool representable = true;
+                for (std::size_t i = 0; i < 3; i++) {
+                    const int32_t delta = quantized[1][i] - quantized[0][i];
+                    representable = representable && delta >= -4 && delta <= 3;
+                }
+                if (!representable) {
+                    continue;
+                }
+            }
+
+            const SubblockFit fit0 = fitSubblock(pixels[0], base[0]);
+            const SubblockFit fit1 = fitSubblock(pixels[1], base[1]);
+            const int32_t error = fit0.error + fit1.error;
+            if (error >= bestError) {
+                continue;
+            }
+
+            uint32_t high = 0;
+            if (differential) {
+                for (std::size_t i = 0; i < 3; i++) {
+                    const uint32_t delta = (quantized[1][i] - quantized[0][i]) & 7;
+                    high |= (uint32_t(quantized[0][i]) << 3 | delta) << (24 - 8 * i);
+                }
+            } else {
+                for (std::size_t i = 0; i < 3; i++) {
+                    high |= (uint32_t(quantized[0][i]) << 4 | uint32_t(quantized[1][i])) << (24 - 8 * i);
+                }
+            }
+            high |= fit0.table << 5 | fit1.table << 2 | uint32_t(differential) << 1 | uint32_t(flip);
+
+            // Pixel indices are stored column by column, with their high bits first.
+            uint32_t low = 0;
+            for (std::size_t s = 0; s < 2; s++) {
+                const SubblockFit& fit = s == 0 ? fit0 : fit1;
+                for (std::size_t p = 0; p < 8; p++) {
+                    const std::size_t x = positions[s][p] % 4;
+                    const std::size_t y = positions[s][p] / 4;
+                    const std::size_t bit = x * 4 + y;
+                    low |= (fit.indices[p] >> 1) << (16 + bit) | (fit.indices[p] & 1) << bit;
+                }
+            }
+
+            bestError = error;
+            bestHigh = high;
+            bestLow = low;
+        }
+    }
+
+    for (std::size_t i = 0; i < 4; i++) {
+        dst[i] = bestHigh >> (24 - 8 * i);
+        dst[4 + i] = bestLow >> (24 - 8 * i);
+    }
+}
+
+} // namespace
+
+optional<CompressedImage> compress(const PremultipliedImage& image, CompressedImageFormat format) {
+    if (!image.valid()) {
+        return {};
+    }
+
+    const uint8_t* pixels = image.data.get();
+    for (std::size_t i = 3; i < image.bytes(); i += 4) {
+        if (pixels[i] != 0xFF) {
+            return {};
+        }
+    }
+
+    CompressedImage result(image.size, format);
+    uint8_t* dst = result.data.get();
+    for (uint32_t y = 0; y < result.blocksHigh(); y++) {
+        for (uint32_t x = 0; x < result.blocksWide(); x++) {
+            const Block block = readBlock(image, x, y);
+            if (format == CompressedImageFormat::BC1) {
+                encodeBC1(block, dst);
+            } else {
+                encodeETC1(block, dst);
+            }
+            dst += 8;
+        }
+    }
+
+    return { std::move(result) };
+}
+
+} // namespace util
+} // namespace mbgl
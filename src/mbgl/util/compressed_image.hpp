@@ -0,0 +1,42 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <cstdint>
+#include <memory>
+
+namespace mbgl {
+
+// Block compressed formats for opaque images. Both store each block of 4x4 pixels in 8 bytes, an
+// eighth of the size of RGBA.
+enum class CompressedImageFormat : uint8_t {
+    BC1,  // S3TC DXT1
+    ETC1, // Also a valid ETC2 RGB8 image.
+};
+
+class CompressedImage {
+public:
+    CompressedImage(Size size_, CompressedImageFormat format_)
+        : size(std::move(size_)),
+          format(format_),
+          data(new uint8_t[bytes()]) {}
+
+    std::size_t blocksWide() const { return (size.width + 3) / 4; }
+    std::size_t blocksHigh() const { return (size.height + 3) / 4; }
+    std::size_t bytes() const { return blocksWide() * blocksHigh() * 8; }
+
+    Size size;
+    CompressedImageFormat format;
+    std::unique_ptr<uint8_t[]> data;
+};
+
+namespace util {
+
+// Encodes an image into a block compressed format. Returns nothing when the image has translucent
+// pixels, which neither format can store.
+optional<CompressedImage> compress(const PremultipliedImage&, CompressedImageFormat);
+
+} // namespace util
+} // namespace mbgl
@@ -8,7 +8,9 @@
 
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <vector>
 
 // Check zlib library version.
 const static bool zlibVersionCheck __attribute__((unused)) = []() {
@@ -31,12 +33,12 @@ namespace util {
 // cause a link error.
 #undef compress
 
-std::string compress(const std::string &raw) {
+std::string compress(const std::string &raw, int level) {
     z_stream deflate_stream;
     memset(&deflate_stream, 0, sizeof(deflate_stream));
 
     // TODO: reuse z_streams
-    if (deflateInit(&deflate_stream, Z_DEFAULT_COMPRESSION) != Z_OK) {
+    if (deflateInit(&deflate_stream, level) != Z_OK) {
         throw std::runtime_error("failed to initialize deflate");
     }
 
@@ -71,7 +73,8 @@ std::string decompress(const std::string &raw) {
     memset(&inflate_stream, 0, sizeof(inflate_stream));
 
     // TODO: reuse z_streams
-    if (inflateInit(&inflate_stream) != Z_OK) {
+    // Detects whether the data is a zlib or gzip stream.
+    if (inflateInit2(&inflate_stream, 32 + MAX_WBITS) != Z_OK) {
         throw std::runtime_error("failed to initialize inflate");
     }
 
@@ -100,5 +103,260 @@ std::string decompress(const std::string &raw) {
 
     return result;
 }
+
+bool isCompressed(const std::string& raw) {
+    if (raw.size() < 2) {
+        return false;
+    }
+    const auto first = uint8_t(raw[0]);
+    const auto second = uint8_t(raw[1]);
+    // The gzip magic number, or a zlib header with the deflate method and a valid check sum.
+    return (first == 0x1F && second == 0x8B) ||
+           ((first & 0x0F) == 8 && (first >> 4) <= 7 && (first << 8 | second) % 31 == 0);
+}
+
+std::shared_ptr<const std::string> inflateIfCompressed(std::shared_ptr<const std::string> data) {
+    if (data && isCompressed(*data)) {
+        return std::make_shared<const std::string>(decompress(*data));
+    }
+    return data;
+}
+
+namespace {
+
+namespace lz4 {
+
+// Matches are at least four bytes long, and the last match has to start twelve bytes and end
+// five bytes before the end of the block.
+constexpr std::size_t minMatch = 4;
+constexpr std::size_t matchStartLimit = 12;
+constexpr std::size_t lastLiterals = 5;
+constexpr std::size_t maxOffset = 65535;
+constexpr uint32_t hashBits = 12;
+
+uint32_t read32(const uint8_t* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint32_t hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - hashBits);
+}
+
+// Writes the part of a literal or match length that doesn't fit in the four bits of the token.
+uint8_t* writeLength(uint8_t* out, std::size_t length) {
+    for (; length >= 255; length -= 255) {
+        *out++ = 255;
+    }
+    *out++ = uint8_t(length);
+    return out;
+}
+
+uint8_t* writeSequence(uint8_t* out, const uint8_t* literals, std::size_t literalLength) {
+    uint8_t* token = out++;
+    if (literalLength >= 15) {
+        *token = 15 << 4;
+        out = writeLength(out, literalLength - 15);
+    } else {
+        *token = uint8_t(literalLength << 4);
+    }
+    memcpy(out, literals, literalLength);
+    return out + literalLength;
+}
+
+std::string compress(const std::string& raw) {
+    if (raw.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("data too large for LZ4");
+    }
+
+    const auto* const begin = reinterpret_cast<const uint8_t*>(raw.data());
+    const auto* const end = begin + raw.size();
+
+    // Four bytes for the size, and the worst case of incompressible data.
+    std::string result(4 + raw.size() + raw.size() / 255 + 16, '\0');
+    auto* out = reinterpret_cast<uint8_t*>(&result[0]);
+    for (std::size_t i = 0; i < 4; i++) {
+        *out++ = uint8_t(raw.size() >> (8 * i));
+    }
+
+    const uint8_t* anchor = begin;
+    if (raw.size() > matchStartLimit) {
+        // Positions of the last occurence of each hashed four byte sequence.
+        std::vector<uint32_t> table(1 << hashBits, 0);
+        const uint8_t* const matchStartEnd = end - matchStartLimit;
+        const uint8_t* const matchEnd = end - lastLiterals;
+
+        const uint8_t* in = begin;
+        // Skips ahead faster the longer no match is found, so incompressible data like raster
+        // tiles doesn't take long.
+        std::size_t misses = 0;
+        while (in < matchStartEnd) {
+            const uint32_t sequence = read32(in);
+            uint32_t& entry = table[hash(sequence)];
+            const uint8_t* ref = begin + entry;
+            entry = uint32_t(in - begin);
+
+            if (ref >= in || std::size_t(in - ref) > maxOffset || read32(ref) != sequence) {
+                in += 1 + (misses++ >> 6);
+                continue;
+            }
+            misses = 0;
+
+            // Extend the match backwards over the pending literals, then forwards.
+            while (in > anchor && ref > begin && in[-1] == ref[-1]) {
+                in--;
+                ref--;
+            }
+            const uint8_t* matchIn = in + minMatch;
+            const uint8_t* matchRef = ref + minMatch;
+            while (matchIn < matchEnd && *matchIn == *matchRef) {
+                matchIn++;
+                matchRef++;
+            }
+
+            uint8_t* token = out;
+            out = writeSequence(out, anchor, std::size_t(in - anchor));
+            const std::size_t offset = std::size_t(in - ref);
+            *out++ = uint8_t(offset);
+            *out++ = uint8_t(offset >> 8);
+            const std::size_t matchLength = std::size_t(matchIn - in) - minMatch;
+            if (matchLength >= 15) {
+                *token |= 15;
+                out = writeLength(out, matchLength - 15);
+            } else {
+                *token |= uint8_t(matchLength);
+            }
+
+            in = anchor = matchIn;
+        }
+    }
+
+    out = writeSequence(out, anchor, std::size_t(end - anchor));
+    result.resize(std::size_t(out - reinterpret_cast<uint8_t*>(&result[0])));
+    return result;
+}
+
+std::string decompress(const std::string& raw) {
+    const auto* in = reinterpret_cast<const uint8_t*>(raw.data());
+    const auto* const inEnd = in + raw.size();
+    if (raw.size() < 5) {
+        throw std::runtime_error("LZ4 data too short");
+    }
+
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < 4; i++) {
+        size |= std::size_t(*in++) << (8 * i);
+    }
+    // No byte of LZ4 data expands to more than 255 bytes, so corrupt data can't make us allocate
+    // much more than its own size.
+    if (size > (raw.size() - 4) * 255) {
+        throw std::runtime_error("corrupt LZ4 data");
+    }
+
+    std::string result(size, '\0');
+    auto* const outBegin = reinterpret_cast<uint8_t*>(&result[0]);
+    auto* out = outBegin;
+    auto* const outEnd = out + size;
+
+    const auto readLength = [&](std::size_t length) {
+        if (length == 15) {
+            uint8_t byte;
+            do {
+                if (in == inEnd) {
+                    throw std::runtime_error("corrupt LZ4 data");
+                }
+                byte = *in++;
+                length += byte;
+            } while (byte == 255);
+        }
+        return length;
+    };
+
+    while (true) {
+        const uint8_t token = *in++;
+
+        const std::size_t literalLength = readLength(token >> 4);
+        if (literalLength <= 16 && inEnd - in >= 16 && outEnd - out >= 16) {
+            // Copying a fixed size is a lot faster for the short runs that are most common.
+            memcpy(out, in, 16);
+        } else if (literalLength <= std::size_t(inEnd - in) && literalLength <= std::size_t(outEnd - out)) {
+            memcpy(out, in, literalLength);
+        } else {
+            throw std::runtime_error("corrupt LZ4 data");
+        }
+        in += literalLength;
+        out += literalLength;
+
+        // The last sequence consists of literals only.
+        if (in == inEnd) {
+            break;
+        }
+
+        if (inEnd - in < 3) {
+            throw std::runtime_error("corrupt LZ4 data");
+        }
+        const std::size_t offset = std::size_t(in[0]) | std::size_t(in[1]) << 8;
+        in += 2;
+        const std::size_t matchLength = readLength(token & 15) + minMatch;
+        if (offset == 0 || offset > std::size_t(out - outBegin) || matchLength > std::size_t(outEnd - out)) {
+            throw std::runtime_error("corrupt LZ4 data");
+        }
+
+        // The match may overlap the bytes it produces, which repeats the last `offset` bytes.
+        const uint8_t* ref = out - offset;
+        uint8_t* const matchOutEnd = out + matchLength;
+        if (offset >= 8 && outEnd - matchOutEnd >= 8) {
+            // Chunks no longer than the offset only read bytes that were written before. The
+            // last chunk may overshoot the match; the next sequence overwrites those bytes.
+            for (; out < matchOutEnd; out += 8, ref += 8) {
+                memcpy(out, ref, 8);
+            }
+            out = matchOutEnd;
+        } else {
+            for (; out < matchOutEnd; out++, ref++) {
+                *out = *ref;
+            }
+        }
+        if (in == inEnd) {
+            throw std::runtime_error("corrupt LZ4 data");
+        }
+    }
+
+    if (out != outEnd) {
+        throw std::runtime_error("corrupt LZ4 data");
+    }
+
+    return result;
+}
+
+} // namespace lz4
+
+} // namespace
+
+std::string compress(const std::string& raw, CompressionCodec codec) {
+    switch (codec) {
+    case CompressionCodec::None:
+        return raw;
+    case CompressionCodec::Zlib:
+        return compress(raw);
+    case CompressionCodec::LZ4:
+        return lz4::compress(raw);
+    }
+    throw std::runtime_error("unknown compression codec");
+}
+
+std::string decompress(const std::string& raw, CompressionCodec codec) {
+    switch (codec) {
+    case CompressionCodec::None:
+        return raw;
+    case CompressionCodec::Zlib:
+        return decompress(raw);
+    case CompressionCodec::LZ4:
+        return lz4::decompress(raw);
+    }
+    throw std::runtime_error("unknown compression codec");
+}
+
 } // namespace util
 } // namespace mbgl
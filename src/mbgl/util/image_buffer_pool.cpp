@@ -0,0 +1,147 @@
+#include <mbgl/util/image_buffer_pool.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+// Rounds up to one of four size classes between consecutive powers of two.
+std::size_t sizeClass(std::size_t bytes) {
+    std::size_t power = 1;
+    while (power <= bytes / 2) {
+        power *= 2;
+    }
+    const std::size_t step = std::max<std::size_t>(power / 4, 1);
+    return (bytes + step - 1) / step * step;
+}
+
+} // namespace
+
+class ImageBufferPool::Impl {
+public:
+    Impl(std::size_t maxRetainedBytes_) : maxRetainedBytes(maxRetainedBytes_) {}
+
+    ~Impl() {
+        assert(stats.bytesInUse == 0);
+        clear();
+    }
+
+    void clear() {
+        for (auto& entry : buffers) {
+            for (uint8_t* buffer : entry.second) {
+                delete[] buffer;
+            }
+        }
+        buffers.clear();
+        stats.bytesRetained = 0;
+    }
+
+    // Frees retained buffers until at most `maxRetainedBytes` are retained.
+    void trim() {
+        for (auto it = buffers.begin(); it != buffers.end() && stats.bytesRetained > maxRetainedBytes;) {
+            while (!it->second.empty() && stats.bytesRetained > maxRetainedBytes) {
+                delete[] it->second.back();
+                it->second.pop_back();
+                stats.bytesRetained -= it->first;
+            }
+            it = it->second.empty() ? buffers.erase(it) : std::next(it);
+        }
+    }
+
+    std::mutex mutex;
+    std::size_t maxRetainedBytes;
+    std::unordered_map<std::size_t, std::vector<uint8_t*>> buffers;
+    Stats stats;
+};
+
+void ImageBufferDeleter::operator()(uint8_t* buffer) const {
+    if (pool) {
+        pool->release(buffer, capacity);
+    } else {
+        delete[] buffer;
+    }
+}
+
+ImageBufferPool::ImageBufferPool(std::size_t maxRetainedBytes)
+    : impl(std::make_unique<Impl>(maxRetainedBytes)) {}
+
+ImageBufferPool::~ImageBufferPool() = default;
+
+ImageBufferPool& ImageBufferPool::getDefault() {
+    // Never destroyed, so that images destroyed during static destruction can still return
+    // their buffers.
+    static auto* pool = new ImageBufferPool();
+    return *pool;
+}
+
+ImageBuffer ImageBufferPool::acquire(std::size_t bytes) {
+    if (bytes < minPooledBytes) {
+        return ImageBuffer(new uint8_t[bytes]);
+    }
+
+    const std::size_t capacity = sizeClass(bytes);
+    uint8_t* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        Stats& stats = impl->stats;
+        stats.acquired++;
+        stats.bytesInUse += capacity;
+
+        auto it = impl->buffers.find(capacity);
+        if (it != impl->buffers.end() && !it->second.empty()) {
+            buffer = it->second.back();
+            it->second.pop_back();
+            stats.bytesRetained -= capacity;
+            stats.reused++;
+        } else {
+            stats.peakBytes = std::max(stats.peakBytes, stats.bytesInUse + stats.bytesRetained);
+        }
+    }
+
+    if (!buffer) {
+        buffer = new uint8_t[capacity];
+    }
+
+    return ImageBuffer(buffer, ImageBufferDeleter(*this, capacity));
+}
+
+void ImageBufferPool::release(uint8_t* buffer, std::size_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        Stats& stats = impl->stats;
+        stats.bytesInUse -= capacity;
+        if (stats.bytesRetained + capacity <= impl->maxRetainedBytes) {
+            stats.bytesRetained += capacity;
+            impl->buffers[capacity].push_back(buffer);
+            return;
+        }
+    }
+
+    delete[] buffer;
+}
+
+void ImageBufferPool::setMaxRetainedBytes(std::size_t maxRetainedBytes) {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->maxRetainedBytes = maxRetainedBytes;
+    impl->trim();
+}
+
+void ImageBufferPool::clear() {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->clear();
+}
+
+ImageBufferPool::Stats ImageBufferPool::getStats() const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->stats;
+}
+
+} // namespace util
+} // namespace mbgl
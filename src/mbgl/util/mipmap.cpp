@@ -0,0 +1,35 @@
+#include <mbgl/util/mipmap.hpp>
+#include <mbgl/util/pixel_kernels.hpp>
+
+namespace mbgl {
+namespace util {
+
+std::vector<PremultipliedImage> mipmaps(const PremultipliedImage& image) {
+    const uint32_t size = image.size.width;
+    if (!image.valid() || size != image.size.height || (size & (size - 1)) != 0) {
+        return {};
+    }
+
+    std::vector<PremultipliedImage> levels;
+    // Each level is downsampled from the one before, so they must not move.
+    uint32_t count = 0;
+    while ((size >> count) > 1) {
+        count++;
+    }
+    levels.reserve(count);
+
+    const PremultipliedImage* src = &image;
+    for (uint32_t levelSize = size / 2; levelSize > 0; levelSize /= 2) {
+        PremultipliedImage level({ levelSize, levelSize }, ImageBufferPool::getDefault());
+        for (uint32_t y = 0; y < levelSize; y++) {
+            const uint8_t* row = src->data.get() + 2 * y * src->stride();
+            downsample(row, row + src->stride(), level.data.get() + y * level.stride(), levelSize);
+        }
+        levels.push_back(std::move(level));
+        src = &levels.back();
+    }
+    return levels;
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+// Generates the mipmap chain of a square image with a power of two size, from half its size down
+// to a single pixel, with a box filter. Returns nothing for images of other sizes, which can't be
+// mipmapped in OpenGL ES 2.
+std::vector<PremultipliedImage> mipmaps(const PremultipliedImage&);
+
+} // namespace util
+} // namespace mbgl
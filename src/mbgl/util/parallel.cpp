@@ -0,0 +1,120 @@
+#include <mbgl/util/parallel.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/actor/message.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+// Shared by the calling thread and the helpers, which may only start after the calling thread
+// returned. `fn` lives on the stack of the calling thread, so a helper only calls it when it joined
+// before the calling thread finished.
+class ParallelFor {
+public:
+    ParallelFor(std::size_t count_, const std::function<void (std::size_t)>& fn_)
+        : count(count_), fn(fn_) {
+    }
+
+    // Makes calls until none are left.
+    void work() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = count;
+            }
+        }
+    }
+
+    void help() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (finished) {
+                return;
+            }
+            helping++;
+        }
+
+        work();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        helping--;
+        if (helping == 0) {
+            cv.notify_one();
+        }
+    }
+
+    void finish() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return helping == 0; });
+        finished = true;
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    const std::size_t count;
+    const std::function<void (std::size_t)>& fn;
+    std::atomic<std::size_t> next { 0 };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t helping = 0;
+    bool finished = false;
+    std::exception_ptr error;
+};
+
+class HelpMessage : public Message {
+public:
+    HelpMessage(std::shared_ptr<ParallelFor> state_) : state(std::move(state_)) {}
+
+    void operator()() override {
+        state->help();
+    }
+
+private:
+    const std::shared_ptr<ParallelFor> state;
+};
+
+} // namespace
+
+void parallelFor(Scheduler& scheduler, std::size_t count, std::size_t helpers,
+                 const std::function<void (std::size_t)>& fn) {
+    auto state = std::make_shared<ParallelFor>(count, fn);
+
+    // The scheduler only holds weak references to mailboxes, so helpers that didn't start before
+    // this returns are dropped.
+    std::vector<std::shared_ptr<Mailbox>> mailboxes;
+    helpers = std::min(helpers, count > 0 ? count - 1 : 0);
+    for (std::size_t i = 0; i < helpers; i++) {
+        mailboxes.push_back(std::make_shared<Mailbox>(scheduler));
+        mailboxes.back()->push(std::make_unique<HelpMessage>(state));
+    }
+
+    state->work();
+    state->finish();
+}
+
+std::size_t helpersFor(std::size_t work, std::size_t minWork) {
+    const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::min(threads, std::max<std::size_t>(1, work / minWork)) - 1;
+}
+
+} // namespace util
+} // namespace mbgl
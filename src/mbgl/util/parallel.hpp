@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace util {
+
+// Calls `fn` once with each index in [0, count), on the calling thread and on up to `helpers`
+// threads of `scheduler` at the same time, and returns once all calls have returned. The calling
+// thread takes part and never waits for the scheduler to start a helper, so this doesn't block
+// when all of its threads are busy: the calling thread then makes all calls itself. The first
+// exception thrown by `fn` is rethrown, after the calls in progress have returned.
+void parallelFor(Scheduler& scheduler, std::size_t count, std::size_t helpers,
+                 const std::function<void (std::size_t)>& fn);
+
+// The number of helpers worth starting for `work` units of work, when each thread should get at
+// least `minWork` of them, limited by the number of hardware threads.
+std::size_t helpersFor(std::size_t work, std::size_t minWork);
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,699 @@
+#include <mbgl/util/pixel_kernels.hpp>
+#include <mbgl/math/clamp.hpp>
+
+#include <cassert>
+#include <initializer_list>
+
+#if defined(__SSE2__)
+#define MBGL_PIXEL_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX2 kernels are compiled with a target attribute, so that the rest of the library doesn't
+// require AVX2, and are only called when the CPU supports it.
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MBGL_PIXEL_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MBGL_PIXEL_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace mbgl {
+namespace util {
+
+// Each vectorized kernel processes as many whole vectors of pixels as fit in `count`, and returns
+// the number of pixels it processed. The remainder is processed by the scalar kernel.
+//
+// Premultiplication computes (c * a + 127) / 255, which equals (t + (t >> 8)) >> 8 with
+// t = c * a + 128 for all 8-bit c and a. Unpremultiplication computes (255 * c + a / 2) / a, and
+// the truncated, correctly rounded single precision quotient is exact for dividends below 2^16.
+// Elevation decoding divides 24-bit integers by ten, which is exact in single precision too.
+// Downsampling sums the four pixels of a block in 16 bits, and computes (sum + 2) >> 2.
+// Hillshade slopes are exact integers, and are scaled, clamped and offset in single precision in
+// the same order by all kernels. Offsetting by 128 and truncating rounds half up.
+
+namespace {
+
+void premultiplyScalar(uint8_t* data, std::size_t count) {
+    for (std::size_t i = 0; i < count * 4; i += 4) {
+        uint8_t& r = data[i + 0];
+        uint8_t& g = data[i + 1];
+        uint8_t& b = data[i + 2];
+        uint8_t& a = data[i + 3];
+        r = (r * a + 127) / 255;
+        g = (g * a + 127) / 255;
+        b = (b * a + 127) / 255;
+    }
+}
+
+void unpremultiplyScalar(uint8_t* data, std::size_t count) {
+    for (std::size_t i = 0; i < count * 4; i += 4) {
+        uint8_t& r = data[i + 0];
+        uint8_t& g = data[i + 1];
+        uint8_t& b = data[i + 2];
+        uint8_t& a = data[i + 3];
+        if (a) {
+            r = (255 * r + (a / 2)) / a;
+            g = (255 * g + (a / 2)) / a;
+            b = (255 * b + (a / 2)) / a;
+        }
+    }
+}
+
+void decodeMapboxDEMScalar(const uint8_t* src, int32_t* dst, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t* pixel = src + i * 4;
+        // https://www.mapbox.com/help/access-elevation-data/#mapbox-terrain-rgb
+        dst[i] = (pixel[0] * 256 * 256 + pixel[1] * 256 + pixel[2]) / 10 - 10000 + 65536;
+    }
+}
+
+void decodeTerrariumDEMScalar(const uint8_t* src, int32_t* dst, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t* pixel = src + i * 4;
+        // https://aws.amazon.com/public-datasets/terrain/
+        dst[i] = (pixel[0] * 256 + pixel[1] + pixel[2] / 256) - 32768 + 65536;
+    }
+}
+
+inline uint8_t encodeSlope(int32_t slope, float scale) {
+    return static_cast<uint8_t>(util::clamp(float(slope) * scale, -127.5f, 127.5f) + 128.0f);
+}
+
+void hillshadeSlopesScalar(const int32_t* above, const int32_t* row, const int32_t* below, uint8_t* dst, std::size_t count, float scale) {
+    for (std::size_t i = 0; i < count; i++) {
+        // a b c
+        // d e f
+        // g h k
+        const int32_t* up = above + i;
+        const int32_t* center = row + i;
+        const int32_t* down = below + i;
+        const int32_t a = up[-1], b = up[0], c = up[1];
+        const int32_t d = center[-1], f = center[1];
+        const int32_t g = down[-1], h = down[0], k = down[1];
+        dst[i * 4 + 0] = encodeSlope((c + f + f + k) - (a + d + d + g), scale);
+        dst[i * 4 + 1] = encodeSlope((g + h + h + k) - (a + b + b + c), scale);
+        dst[i * 4 + 2] = 255;
+        dst[i * 4 + 3] = 255;
+    }
+}
+
+void downsampleScalar(const uint8_t* src0, const uint8_t* src1, uint8_t* dst, std::size_t count) {
+    for (std::size_t i = 0; i < count * 4; i++) {
+        const std::size_t j = (i & ~std::size_t(3)) * 2 + (i & 3);
+        dst[i] = (src0[j] + src0[j + 4] + src1[j] + src1[j + 4] + 2) >> 2;
+    }
+}
+
+#if defined(MBGL_PIXEL_KERNELS_SSE2)
+
+// Broadcasts the alpha of each of two RGBA pixels widened to 16 bits.
+inline __m128i alphaSSE2(__m128i pixels) {
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+inline __m128i alphaMaskSSE2() {
+    return _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+}
+
+inline __m128i premultiplySSE2(__m128i pixels) {
+    const __m128i alpha = alphaSSE2(pixels);
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(128));
+    t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    return _mm_or_si128(_mm_and_si128(alphaMaskSSE2(), pixels), _mm_andnot_si128(alphaMaskSSE2(), t));
+}
+
+std::size_t premultiplySSE2(uint8_t* data, std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i * 4);
+        const __m128i pixels = _mm_loadu_si128(p);
+        _mm_storeu_si128(p, _mm_packus_epi16(premultiplySSE2(_mm_unpacklo_epi8(pixels, zero)),
+                                             premultiplySSE2(_mm_unpackhi_epi8(pixels, zero))));
+    }
+    return i;
+}
+
+inline __m128i divideSSE2(__m128i dividend, __m128i divisor) {
+    const __m128 quotient = _mm_div_ps(_mm_cvtepi32_ps(dividend), _mm_cvtepi32_ps(divisor));
+    // Keep the low byte, like the scalar kernel's assignment to uint8_t.
+    return _mm_and_si128(_mm_cvttps_epi32(quotient), _mm_set1_epi32(0xFF));
+}
+
+inline __m128i unpremultiplySSE2(__m128i pixels) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha = alphaSSE2(pixels);
+
+    // 255 * c + a / 2, which fits in 16 bits.
+    const __m128i dividend = _mm_add_epi16(_mm_sub_epi16(_mm_slli_epi16(pixels, 8), pixels),
+                                           _mm_srli_epi16(alpha, 1));
+    const __m128i quotient = _mm_packs_epi32(
+        divideSSE2(_mm_unpacklo_epi16(dividend, zero), _mm_unpacklo_epi16(alpha, zero)),
+        divideSSE2(_mm_unpackhi_epi16(dividend, zero), _mm_unpackhi_epi16(alpha, zero)));
+
+    // Alpha is kept, and so is the color of transparent pixels.
+    const __m128i keep = _mm_or_si128(alphaMaskSSE2(), _mm_cmpeq_epi16(alpha, zero));
+    return _mm_or_si128(_mm_and_si128(keep, pixels), _mm_andnot_si128(keep, quotient));
+}
+
+std::size_t unpremultiplySSE2(uint8_t* data, std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(data + i * 4);
+        const __m128i pixels = _mm_loadu_si128(p);
+        _mm_storeu_si128(p, _mm_packus_epi16(unpremultiplySSE2(_mm_unpacklo_epi8(pixels, zero)),
+                                             unpremultiplySSE2(_mm_unpackhi_epi8(pixels, zero))));
+    }
+    return i;
+}
+
+std::size_t decodeMapboxDEMSSE2(const uint8_t* src, int32_t* dst, std::size_t count) {
+    const __m128i byte = _mm_set1_epi32(0xFF);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i rgb = _mm_or_si128(
+            _mm_or_si128(_mm_slli_epi32(_mm_and_si128(pixels, byte), 16),
+                         _mm_and_si128(pixels, _mm_set1_epi32(0xFF00))),
+            _mm_and_si128(_mm_srli_epi32(pixels, 16), byte));
+        const __m128i elevation = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(rgb), _mm_set1_ps(10)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_add_epi32(elevation, _mm_set1_epi32(65536 - 10000)));
+    }
+    return i;
+}
+
+std::size_t decodeTerrariumDEMSSE2(const uint8_t* src, int32_t* dst, std::size_t count) {
+    const __m128i byte = _mm_set1_epi32(0xFF);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        const __m128i rg = _mm_add_epi32(_mm_slli_epi32(_mm_and_si128(pixels, byte), 8),
+                                         _mm_and_si128(_mm_srli_epi32(pixels, 8), byte));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_add_epi32(rg, _mm_set1_epi32(65536 - 32768)));
+    }
+    return i;
+}
+
+inline __m128i loadSSE2(const int32_t* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+inline __m128i encodeSlopeSSE2(__m128i slope, __m128 scale) {
+    const __m128 scaled = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(slope), scale), _mm_set1_ps(-127.5f)),
+                                     _mm_set1_ps(127.5f));
+    return _mm_cvttps_epi32(_mm_add_ps(scaled, _mm_set1_ps(128.0f)));
+}
+
+std::size_t hillshadeSlopesSSE2(const int32_t* above, const int32_t* row, const int32_t* below, uint8_t* dst, std::size_t count, float scale_) {
+    const __m128 scale = _mm_set1_ps(scale_);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i a = loadSSE2(above + i - 1), b = loadSSE2(above + i), c = loadSSE2(above + i + 1);
+        const __m128i d = loadSSE2(row + i - 1), f = loadSSE2(row + i + 1);
+        const __m128i g = loadSSE2(below + i - 1), h = loadSSE2(below + i), k = loadSSE2(below + i + 1);
+        const __m128i dx = _mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(c, k), _mm_slli_epi32(f, 1)),
+                                         _mm_add_epi32(_mm_add_epi32(a, g), _mm_slli_epi32(d, 1)));
+        const __m128i dy = _mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(g, k), _mm_slli_epi32(h, 1)),
+                                         _mm_add_epi32(_mm_add_epi32(a, c), _mm_slli_epi32(b, 1)));
+        const __m128i pixels = _mm_or_si128(
+            _mm_or_si128(encodeSlopeSSE2(dx, scale), _mm_slli_epi32(encodeSlopeSSE2(dy, scale), 8)),
+            _mm_set1_epi32(int32_t(0xFFFF0000)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), pixels);
+    }
+    return i;
+}
+
+// Sums two rows of four pixels each into the 16 bit sums of their two 2x2 blocks.
+inline __m128i downsampleSSE2(const uint8_t* src0, const uint8_t* src1) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src0));
+    const __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src1));
+    // Pixels 0 and 1, and 2 and 3 of both rows.
+    const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(row0, zero), _mm_unpacklo_epi8(row1, zero));
+    const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(row0, zero), _mm_unpackhi_epi8(row1, zero));
+    const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+}
+
+std::size_t downsampleSSE2(const uint8_t* src0, const uint8_t* src1, uint8_t* dst, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const std::size_t j = i * 8;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4),
+                         _mm_packus_epi16(downsampleSSE2(src0 + j, src1 + j),
+                                          downsampleSSE2(src0 + j + 16, src1 + j + 16)));
+    }
+    return i;
+}
+
+#endif // MBGL_PIXEL_KERNELS_SSE2
+
+#if defined(MBGL_PIXEL_KERNELS_AVX2)
+
+__attribute__((target("avx2")))
+inline __m256i premultiplyAVX2(__m256i pixels) {
+    const __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    const __m256i alphaMask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0, -1, 0, 0, 0);
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(pixels, alpha), _mm256_set1_epi16(128));
+    t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+    return _mm256_blendv_epi8(t, pixels, alphaMask);
+}
+
+// Unpacking and packing both work within 128-bit lanes, so pixels stay in order.
+__attribute__((target("avx2")))
+std::size_t premultiplyAVX2(uint8_t* data, std::size_t count) {
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(data + i * 4);
+        const __m256i pixels = _mm256_loadu_si256(p);
+        _mm256_storeu_si256(p, _mm256_packus_epi16(premultiplyAVX2(_mm256_unpacklo_epi8(pixels, zero)),
+                                                   premultiplyAVX2(_mm256_unpackhi_epi8(pixels, zero))));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t decodeMapboxDEMAVX2(const uint8_t* src, int32_t* dst, std::size_t count) {
+    const __m256i byte = _mm256_set1_epi32(0xFF);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        const __m256i rgb = _mm256_or_si256(
+            _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(pixels, byte), 16),
+                            _mm256_and_si256(pixels, _mm256_set1_epi32(0xFF00))),
+            _mm256_and_si256(_mm256_srli_epi32(pixels, 16), byte));
+        const __m256i elevation = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(rgb), _mm256_set1_ps(10)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_add_epi32(elevation, _mm256_set1_epi32(65536 - 10000)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t decodeTerrariumDEMAVX2(const uint8_t* src, int32_t* dst, std::size_t count) {
+    const __m256i byte = _mm256_set1_epi32(0xFF);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+        const __m256i rg = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(pixels, byte), 8),
+                                            _mm256_and_si256(_mm256_srli_epi32(pixels, 8), byte));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_add_epi32(rg, _mm256_set1_epi32(65536 - 32768)));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline __m256i loadAVX2(const int32_t* data) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+}
+
+__attribute__((target("avx2")))
+inline __m256i encodeSlopeAVX2(__m256i slope, __m256 scale) {
+    const __m256 scaled = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(slope), scale), _mm256_set1_ps(-127.5f)),
+                                        _mm256_set1_ps(127.5f));
+    return _mm256_cvttps_epi32(_mm256_add_ps(scaled, _mm256_set1_ps(128.0f)));
+}
+
+__attribute__((target("avx2")))
+std::size_t hillshadeSlopesAVX2(const int32_t* above, const int32_t* row, const int32_t* below, uint8_t* dst, std::size_t count, float scale_) {
+    const __m256 scale = _mm256_set1_ps(scale_);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i a = loadAVX2(above + i - 1), b = loadAVX2(above + i), c = loadAVX2(above + i + 1);
+        const __m256i d = loadAVX2(row + i - 1), f = loadAVX2(row + i + 1);
+        const __m256i g = loadAVX2(below + i - 1), h = loadAVX2(below + i), k = loadAVX2(below + i + 1);
+        const __m256i dx = _mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(c, k), _mm256_slli_epi32(f, 1)),
+                                            _mm256_add_epi32(_mm256_add_epi32(a, g), _mm256_slli_epi32(d, 1)));
+        const __m256i dy = _mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(g, k), _mm256_slli_epi32(h, 1)),
+                                            _mm256_add_epi32(_mm256_add_epi32(a, c), _mm256_slli_epi32(b, 1)));
+        const __m256i pixels = _mm256_or_si256(
+            _mm256_or_si256(encodeSlopeAVX2(dx, scale), _mm256_slli_epi32(encodeSlopeAVX2(dy, scale), 8)),
+            _mm256_set1_epi32(int32_t(0xFFFF0000)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), pixels);
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+inline __m256i downsampleAVX2(const uint8_t* src0, const uint8_t* src1) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i row0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src0));
+    const __m256i row1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src1));
+    const __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(row0, zero), _mm256_unpacklo_epi8(row1, zero));
+    const __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(row0, zero), _mm256_unpackhi_epi8(row1, zero));
+    const __m256i sum = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+    return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(2)), 2);
+}
+
+// Each 128-bit lane yields two pixels per call, so the packed result has its 64-bit quarters out
+// of order.
+__attribute__((target("avx2")))
+std::size_t downsampleAVX2(const uint8_t* src0, const uint8_t* src1, uint8_t* dst, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const std::size_t j = i * 8;
+        const __m256i packed = _mm256_packus_epi16(downsampleAVX2(src0 + j, src1 + j),
+                                                   downsampleAVX2(src0 + j + 32, src1 + j + 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4),
+                            _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    return i;
+}
+
+#endif // MBGL_PIXEL_KERNELS_AVX2
+
+#if defined(MBGL_PIXEL_KERNELS_NEON)
+
+inline uint8x16_t premultiplyNEON(uint8x16_t color, uint8x16_t alpha) {
+    uint16x8_t lo = vaddq_u16(vmull_u8(vget_low_u8(color), vget_low_u8(alpha)), vdupq_n_u16(128));
+    uint16x8_t hi = vaddq_u16(vmull_u8(vget_high_u8(color), vget_high_u8(alpha)), vdupq_n_u16(128));
+    lo = vaddq_u16(lo, vshrq_n_u16(lo, 8));
+    hi = vaddq_u16(hi, vshrq_n_u16(hi, 8));
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+std::size_t premultiplyNEON(uint8_t* data, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t pixels = vld4q_u8(data + i * 4);
+        pixels.val[0] = premultiplyNEON(pixels.val[0], pixels.val[3]);
+        pixels.val[1] = premultiplyNEON(pixels.val[1], pixels.val[3]);
+        pixels.val[2] = premultiplyNEON(pixels.val[2], pixels.val[3]);
+        vst4q_u8(data + i * 4, pixels);
+    }
+    return i;
+}
+
+std::size_t decodeTerrariumDEMNEON(const uint8_t* src, int32_t* dst, std::size_t count) {
+    const int32x4_t offset = vdupq_n_s32(65536 - 32768);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8x8x4_t pixels = vld4_u8(src + i * 4);
+        const uint16x8_t rg = vaddw_u8(vshll_n_u8(pixels.val[0], 8), pixels.val[1]);
+        vst1q_s32(dst + i, vaddq_s32(vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(rg))), offset));
+        vst1q_s32(dst + i + 4, vaddq_s32(vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(rg))), offset));
+    }
+    return i;
+}
+
+inline uint32x4_t encodeSlopeNEON(int32x4_t slope, float32x4_t scale) {
+    const float32x4_t scaled = vminq_f32(vmaxq_f32(vmulq_f32(vcvtq_f32_s32(slope), scale), vdupq_n_f32(-127.5f)),
+                                         vdupq_n_f32(127.5f));
+    return vcvtq_u32_f32(vaddq_f32(scaled, vdupq_n_f32(128.0f)));
+}
+
+std::size_t hillshadeSlopesNEON(const int32_t* above, const int32_t* row, const int32_t* below, uint8_t* dst, std::size_t count, float scale_) {
+    const float32x4_t scale = vdupq_n_f32(scale_);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const int32x4_t a = vld1q_s32(above + i - 1), b = vld1q_s32(above + i), c = vld1q_s32(above + i + 1);
+        const int32x4_t d = vld1q_s32(row + i - 1), f = vld1q_s32(row + i + 1);
+        const int32x4_t g = vld1q_s32(below + i - 1), h = vld1q_s32(below + i), k = vld1q_s32(below + i + 1);
+        const int32x4_t dx = vsubq_s32(vaddq_s32(vaddq_s32(c, k), vshlq_n_s32(f, 1)),
+                                       vaddq_s32(vaddq_s32(a, g), vshlq_n_s32(d, 1)));
+        const int32x4_t dy = vsubq_s32(vaddq_s32(vaddq_s32(g, k), vshlq_n_s32(h, 1)),
+                                       vaddq_s32(vaddq_s32(a, c), vshlq_n_s32(b, 1)));
+        const uint32x4_t pixels = vorrq_u32(
+            vorrq_u32(encodeSlopeNEON(dx, scale), vshlq_n_u32(encodeSlopeNEON(dy, scale), 8)),
+            vdupq_n_u32(0xFFFF0000));
+        vst1q_u8(dst + i * 4, vreinterpretq_u8_u32(pixels));
+    }
+    return i;
+}
+
+std::size_t downsampleNEON(const uint8_t* src0, const uint8_t* src1, uint8_t* dst, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8x16x4_t row0 = vld4q_u8(src0 + i * 8);
+        const uint8x16x4_t row1 = vld4q_u8(src1 + i * 8);
+        uint8x8x4_t pixels;
+        for (int c = 0; c < 4; c++) {
+            // Adds horizontally adjacent pixels, and rounds the sum of both rows.
+            pixels.val[c] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(row0.val[c]), row1.val[c]), 2);
+        }
+        vst4_u8(dst + i * 4, pixels);
+    }
+    return i;
+}
+
+// Vector division is only available on AArch64.
+#if defined(__aarch64__)
+#define MBGL_PIXEL_KERNELS_NEON_DIVIDE
+
+inline uint16x4_t divideNEON(uint16x4_t dividend, uint16x4_t divisor) {
+    const float32x4_t quotient = vdivq_f32(vcvtq_f32_u32(vmovl_u16(dividend)), vcvtq_f32_u32(vmovl_u16(divisor)));
+    return vmovn_u32(vcvtq_u32_f32(quotient));
+}
+
+inline uint8x16_t unpremultiplyNEON(uint8x16_t color, uint8x16_t alpha) {
+    // 255 * c + a / 2, which fits in 16 bits.
+    const uint8x16_t halfAlpha = vshrq_n_u8(alpha, 1);
+    const uint16x8_t lo = vmlal_u8(vmovl_u8(vget_low_u8(halfAlpha)), vget_low_u8(color), vdup_n_u8(255));
+    const uint16x8_t hi = vmlal_u8(vmovl_u8(vget_high_u8(halfAlpha)), vget_high_u8(color), vdup_n_u8(255));
+    const uint16x8_t alphaLo = vmovl_u8(vget_low_u8(alpha));
+    const uint16x8_t alphaHi = vmovl_u8(vget_high_u8(alpha));
+
+    // Narrowing keeps the low byte, like the scalar kernel's assignment to uint8_t.
+    const uint8x16_t quotient = vcombine_u8(
+        vmovn_u16(vcombine_u16(divideNEON(vget_low_u16(lo), vget_low_u16(alphaLo)),
+                               divideNEON(vget_high_u16(lo), vget_high_u16(alphaLo)))),
+        vmovn_u16(vcombine_u16(divideNEON(vget_low_u16(hi), vget_low_u16(alphaHi)),
+                               divideNEON(vget_high_u16(hi), vget_high_u16(alphaHi)))));
+
+    // Transparent pixels keep their color.
+    return vbslq_u8(vceqq_u8(alpha, vdupq_n_u8(0)), color, quotient);
+}
+
+std::size_t unpremultiplyNEON(uint8_t* data, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        uint8x16x4_t pixels = vld4q_u8(data + i * 4);
+        pixels.val[0] = unpremultiplyNEON(pixels.val[0], pixels.val[3]);
+        pixels.val[1] = unpremultiplyNEON(pixels.val[1], pixels.val[3]);
+        pixels.val[2] = unpremultiplyNEON(pixels.val[2], pixels.val[3]);
+        vst4q_u8(data + i * 4, pixels);
+    }
+    return i;
+}
+
+std::size_t decodeMapboxDEMNEON(const uint8_t* src, int32_t* dst, std::size_t count) {
+    const float32x4_t ten = vdupq_n_f32(10);
+    const int32x4_t offset = vdupq_n_s32(65536 - 10000);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8x8x4_t pixels = vld4_u8(src + i * 4);
+        const uint16x8_t gb = vaddw_u8(vshll_n_u8(pixels.val[1], 8), pixels.val[2]);
+        const uint16x8_t r = vmovl_u8(pixels.val[0]);
+        const uint32x4_t lo = vorrq_u32(vshll_n_u16(vget_low_u16(r), 16), vmovl_u16(vget_low_u16(gb)));
+        const uint32x4_t hi = vorrq_u32(vshll_n_u16(vget_high_u16(r), 16), vmovl_u16(vget_high_u16(gb)));
+        vst1q_s32(dst + i, vaddq_s32(vcvtq_s32_f32(vdivq_f32(vcvtq_f32_u32(lo), ten)), offset));
+        vst1q_s32(dst + i + 4, vaddq_s32(vcvtq_s32_f32(vdivq_f32(vcvtq_f32_u32(hi), ten)), offset));
+    }
+    return i;
+}
+
+#endif // __aarch64__
+
+#endif // MBGL_PIXEL_KERNELS_NEON
+
+} // namespace
+
+bool supports(InstructionSet set) {
+    switch (set) {
+    case InstructionSet::Scalar:
+        return true;
+    case InstructionSet::SSE2:
+#if defined(MBGL_PIXEL_KERNELS_SSE2)
+        return true;
+#else
+        return false;
+#endif
+    case InstructionSet::AVX2: {
+#if defined(MBGL_PIXEL_KERNELS_AVX2) && defined(MBGL_PIXEL_KERNELS_SSE2)
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+#else
+        return false;
+#endif
+    }
+    case InstructionSet::NEON:
+#if defined(MBGL_PIXEL_KERNELS_NEON)
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+InstructionSet bestInstructionSet() {
+    static const InstructionSet best = [] {
+        for (auto set : { InstructionSet::AVX2, InstructionSet::SSE2, InstructionSet::NEON }) {
+            if (supports(set)) {
+                return set;
+            }
+        }
+        return InstructionSet::Scalar;
+    }();
+    return best;
+}
+
+// Kernels without an AVX2 variant use SSE2, which all CPUs with AVX2 support.
+
+void premultiply(uint8_t* data, std::size_t count, InstructionSet set) {
+    assert(supports(set));
+    std::size_t i = 0;
+    switch (set) {
+#if defined(MBGL_PIXEL_KERNELS_AVX2)
+    case InstructionSet::AVX2:
+        i = premultiplyAVX2(data, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_SSE2)
+    case InstructionSet::SSE2:
+        i = premultiplySSE2(data, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_NEON)
+    case InstructionSet::NEON:
+        i = premultiplyNEON(data, count);
+        break;
+#endif
+    default:
+        break;
+    }
+    premultiplyScalar(data + i * 4, count - i);
+}
+
+void unpremultiply(uint8_t* data, std::size_t count, InstructionSet set) {
+    assert(supports(set));
+    std::size_t i = 0;
+    switch (set) {
+#if defined(MBGL_PIXEL_KERNELS_SSE2)
+    case InstructionSet::AVX2:
+    case InstructionSet::SSE2:
+        i = unpremultiplySSE2(data, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_NEON_DIVIDE)
+    case InstructionSet::NEON:
+        i = unpremultiplyNEON(data, count);
+        break;
+#endif
+    default:
+        break;
+    }
+    unpremultiplyScalar(data + i * 4, count - i);
+}
+
+void decodeMapboxDEM(const uint8_t* src, int32_t* dst, std::size_t count, InstructionSet set) {
+    assert(supports(set));
+    std::size_t i = 0;
+    switch (set) {
+#if defined(MBGL_PIXEL_KERNELS_AVX2)
+    case InstructionSet::AVX2:
+        i = decodeMapboxDEMAVX2(src, dst, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_SSE2)
+    case InstructionSet::SSE2:
+        i = decodeMapboxDEMSSE2(src, dst, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_NEON_DIVIDE)
+    case InstructionSet::NEON:
+        i = decodeMapboxDEMNEON(src, dst, count);
+        break;
+#endif
+    default:
+        break;
+    }
+    decodeMapboxDEMScalar(src + i * 4, dst + i, count - i);
+}
+
+void decodeTerrariumDEM(const uint8_t* src, int32_t* dst, std::size_t count, InstructionSet set) {
+    assert(supports(set));
+    std::size_t i = 0;
+    switch (set) {
+#if defined(MBGL_PIXEL_KERNELS_AVX2)
+    case InstructionSet::AVX2:
+        i = decodeTerrariumDEMAVX2(src, dst, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_SSE2)
+    case InstructionSet::SSE2:
+        i = decodeTerrariumDEMSSE2(src, dst, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_NEON)
+    case InstructionSet::NEON:
+        i = decodeTerrariumDEMNEON(src, dst, count);
+        break;
+#endif
+    default:
+        break;
+    }
+    decodeTerrariumDEMScalar(src + i * 4, dst + i, count - i);
+}
+
+void hillshadeSlopes(const int32_t* above, const int32_t* row, const int32_t* below, uint8_t* dst, std::size_t count, float scale, InstructionSet set) {
+    assert(supports(set));
+    std::size_t i = 0;
+    switch (set) {
+#if defined(MBGL_PIXEL_KERNELS_AVX2)
+    case InstructionSet::AVX2:
+        i = hillshadeSlopesAVX2(above, row, below, dst, count, scale);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_SSE2)
+    case InstructionSet::SSE2:
+        i = hillshadeSlopesSSE2(above, row, below, dst, count, scale);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_NEON)
+    case InstructionSet::NEON:
+        i = hillshadeSlopesNEON(above, row, below, dst, count, scale);
+        break;
+#endif
+    default:
+        break;
+    }
+    hillshadeSlopesScalar(above + i, row + i, below + i, dst + i * 4, count - i, scale);
+}
+
+void downsample(const uint8_t* src0, const uint8_t* src1, uint8_t* dst, std::size_t count, InstructionSet set) {
+    assert(supports(set));
+    std::size_t i = 0;
+    switch (set) {
+#if defined(MBGL_PIXEL_KERNELS_AVX2)
+    case InstructionSet::AVX2:
+        i = downsampleAVX2(src0, src1, dst, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_SSE2)
+    case InstructionSet::SSE2:
+        i = downsampleSSE2(src0, src1, dst, count);
+        break;
+#endif
+#if defined(MBGL_PIXEL_KERNELS_NEON)
+    case InstructionSet::NEON:
+        i = downsampleNEON(src0, src1, dst, count);
+        break;
+#endif
+    default:
+        break;
+    }
+    downsampleScalar(src0 + i * 8, src1 + i * 8, dst + i * 4, count - i);
+}
+
+} // namespace util
+} // namespace mbgl
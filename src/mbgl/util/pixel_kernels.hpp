@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mbgl {
+namespace util {
+
+// Instruction sets the pixel kernels are vectorized for. All of them produce the same output as
+// the scalar implementation, bit for bit.
+enum class InstructionSet : uint8_t {
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON,
+};
+
+// Whether the kernels can use the given instruction set on this CPU.
+bool supports(InstructionSet);
+
+// The fastest instruction set the kernels can use on this CPU, detected at runtime.
+InstructionSet bestInstructionSet();
+
+// Converts `count` RGBA pixels in place from unassociated to premultiplied alpha, and back.
+void premultiply(uint8_t* data, std::size_t count, InstructionSet = bestInstructionSet());
+void unpremultiply(uint8_t* data, std::size_t count, InstructionSet = bestInstructionSet());
+
+// Decodes the elevation of `count` Mapbox Terrain-RGB or Terrarium encoded RGBA pixels into
+// `dst`, offset by 65536 as stored by DEMData.
+void decodeMapboxDEM(const uint8_t* src, int32_t* dst, std::size_t count, InstructionSet = bestInstructionSet());
+void decodeTerrariumDEM(const uint8_t* src, int32_t* dst, std::size_t count, InstructionSet = bestInstructionSet());
+
+// Computes the slopes of `count` elevations of the DEMData row `row` with a Sobel operator over
+// their eight neighbors, like the hillshade_prepare shader. `above` and `below` are the adjacent
+// rows; all three are read from one pixel before the first to one after the last. Each slope
+// times `scale` is clamped to +/-127.5, offset by 127.5 and rounded, and stored in the red and
+// green channels of an opaque RGBA pixel in `dst`.
+void hillshadeSlopes(const int32_t* above, const int32_t* row, const int32_t* below, uint8_t* dst, std::size_t count, float scale, InstructionSet = bestInstructionSet());
+
+// Averages each 2x2 block of RGBA pixels of the rows `src0` and `src1`, which are `2 * count`
+// pixels wide, into `count` pixels in `dst`, rounding to nearest.
+void downsample(const uint8_t* src0, const uint8_t* src1, uint8_t* dst, std::size_t count, InstructionSet = bestInstructionSet());
+
+} // namespace util
+} // namespace mbgl
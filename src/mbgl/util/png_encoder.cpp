@@ -0,0 +1,43 @@
+#include <mbgl/util/png_encoder.hpp>
+#include <mbgl/actor/actor.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+class PNGEncoder::Worker {
+public:
+    Worker(PNGEncodeOptions options_) : options(std::move(options_)) {
+    }
+
+    void encode(PremultipliedImage image, Callback callback) {
+        std::string png;
+        std::exception_ptr error;
+        try {
+            png = encodePNG(image, options);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        callback(error, std::move(png));
+    }
+
+private:
+    const PNGEncodeOptions options;
+};
+
+PNGEncoder::PNGEncoder(Scheduler& scheduler, std::size_t concurrency, PNGEncodeOptions options) {
+    assert(concurrency > 0);
+    workers.reserve(concurrency);
+    for (std::size_t i = 0; i < concurrency; i++) {
+        workers.push_back(std::make_unique<Actor<Worker>>(scheduler, options));
+    }
+}
+
+PNGEncoder::~PNGEncoder() = default;
+
+// Every worker encodes the images it is sent in order, so they are sent to the workers in turn.
+void PNGEncoder::encode(PremultipliedImage image, Callback callback) {
+    workers[next++ % workers.size()]->invoke(&Worker::encode, std::move(image), std::move(callback));
+}
+
+} // namespace mbgl
@@ -0,0 +1,137 @@
+#include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_file_source.hpp>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/gl/headless_frontend.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/projection.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <mapbox/pixelmatch.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace mbgl;
+
+namespace {
+
+// Translucent polygons and lines across the seams between the tiles of zoom level 2, and no
+// symbols, whose placement differs between a block and its tiles on their own.
+const char* const style = R"STYLE({
+  "version": 8,
+  "sources": {
+    "shapes": {
+      "type": "geojson",
+      "data": {
+        "type": "FeatureCollection",
+        "features": [{
+          "type": "Feature",
+          "properties": {},
+          "geometry": { "type": "Polygon", "coordinates": [[[-120, -50], [30, -50], [30, 60], [-120, 60], [-120, -50]]] }
+        }, {
+          "type": "Feature",
+          "properties": {},
+          "geometry": { "type": "LineString", "coordinates": [[-170, -70], [-40, 10], [100, 75]] }
+        }]
+      }
+    }
+  },
+  "layers": [{
+    "id": "background",
+    "type": "background",
+    "paint": { "background-color": "white" }
+  }, {
+    "id": "fill",
+    "type": "fill",
+    "source": "shapes",
+    "paint": { "fill-color": "red", "fill-opacity": 0.5, "fill-outline-color": "black" }
+  }, {
+    "id": "line",
+    "type": "line",
+    "source": "shapes",
+    "paint": { "line-color": "blue", "line-width": 6, "line-opacity": 0.5 }
+  }]
+})STYLE";
+
+class MetatileTest {
+public:
+    util::RunLoop loop;
+    StubFileSource fileSource;
+    ThreadPool threadPool { 4 };
+};
+
+// Renders the tile on its own, with a map of the tile's size centered on it.
+PremultipliedImage renderTile(MetatileTest& test, const CanonicalTileID& id, uint32_t tileSize) {
+    HeadlessFrontend frontend { { tileSize, tileSize }, 1, test.fileSource, test.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, test.fileSource,
+              test.threadPool, MapMode::Tile };
+    map.getStyle().loadJSON(style);
+
+    CameraOptions camera;
+    camera.center = Projection::unproject({ (id.x + 0.5) * util::tileSize, (id.y + 0.5) * util::tileSize },
+                                          std::pow(2.0, id.z));
+    camera.zoom = id.z + std::log2(double(tileSize) / util::tileSize);
+    map.jumpTo(camera);
+
+    return frontend.render(map);
+}
+
+} // namespace
+
+TEST(Metatile, MatchesTiles) {
+    MetatileTest test;
+
+    for (const uint32_t tileSize : { 512u, 256u }) {
+        HeadlessFrontend frontend { 1, test.fileSource, test.threadPool };
+        Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, test.fileSource,
+                  test.threadPool, MapMode::Tile };
+        map.getStyle().loadJSON(style);
+
+        const CanonicalTileID id { 2, 1, 1 };
+        const auto tiles = frontend.renderMetatile(map, id, 2, tileSize);
+        ASSERT_EQ(4u, tiles.size());
+
+        for (uint32_t i = 0; i < tiles.size(); i++) {
+            const CanonicalTileID tileID { id.z, id.x + i % 2, id.y + i / 2 };
+            const PremultipliedImage expected = renderTile(test, tileID, tileSize);
+
+            ASSERT_EQ(Size(tileSize, tileSize), tiles[i].size);
+            ASSERT_EQ(expected.size, tiles[i].size);
+
+            // The tiles are drawn with a different projection than on their own, which may round
+            // the edges of the shapes differently.
+            PremultipliedImage diff { expected.size };
+            const double pixels = mapbox::pixelmatch(tiles[i].data.get(), expected.data.get(),
+                                                     expected.size.width, expected.size.height,
+                                                     diff.data.get(), 0.1);
+            EXPECT_LE(pixels / (expected.size.width * expected.size.height), 0.001)
+                << "tile " << uint32_t(tileID.z) << "/" << tileID.x << "/" << tileID.y
+                << " of " << tileSize << " pixels";
+        }
+
+        // The frontend and the map are left at the size of the block.
+        EXPECT_EQ(Size(2 * tileSize, 2 * tileSize), frontend.getSize());
+        EXPECT_EQ(Size(2 * tileSize, 2 * tileSize), map.getSize());
+    }
+}
+
+TEST(Metatile, OutsideWorld) {
+    MetatileTest test;
+    HeadlessFrontend frontend { 1, test.fileSource, test.threadPool };
+    Map map { frontend, MapObserver::nullObserver(), frontend.getSize(), 1, test.fileSource,
+              test.threadPool, MapMode::Tile };
+    map.getStyle().loadJSON(style);
+
+    EXPECT_THROW(frontend.renderMetatile(map, { 2, 3, 0 }, 2), std::invalid_argument);
+    EXPECT_THROW(frontend.renderMetatile(map, { 2, 0, 3 }, 2), std::invalid_argument);
+    EXPECT_THROW(frontend.renderMetatile(map, { 0, 0, 0 }, 2), std::invalid_argument);
+    EXPECT_THROW(frontend.renderMetatile(map, { 2, 0, 0 }, 0), std::invalid_argument);
+
+    // Nothing was resized.
+    EXPECT_EQ(Size(256, 256), frontend.getSize());
+    EXPECT_EQ(Size(256, 256), map.getSize());
+}
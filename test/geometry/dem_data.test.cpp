@@ -3,6 +3,9 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/tileset.hpp>
 #include <mbgl/geometry/dem_data.hpp>
+#include <mbgl/math/clamp.hpp>
+
+#include <cmath>
 
 using namespace mbgl;
 
@@ -15,6 +18,23 @@ auto fakeImage = [](Size s) {
     return img;
 };
 
+// A slope with some bumps, in Mapbox Terrain-RGB encoding.
+auto terrainImage = [](Size s, int32_t slope) {
+    PremultipliedImage img = PremultipliedImage(s);
+
+    for (uint32_t y = 0; y < s.height; y++) {
+        for (uint32_t x = 0; x < s.width; x++) {
+            const uint32_t value = (10000 + 1000 + slope * (x + 2 * y) + (x * y) % 7 * 5) * 10;
+            uint8_t* pixel = img.data.get() + (y * s.width + x) * 4;
+            pixel[0] = value >> 16;
+            pixel[1] = value >> 8;
+            pixel[2] = value;
+            pixel[3] = 255;
+        }
+    }
+    return img;
+};
+
 TEST(DEMData, ConstructorMapbox) {
     PremultipliedImage image = fakeImage({16, 16});
     DEMData demdata(image, Tileset::DEMEncoding::Mapbox);
@@ -105,7 +125,8 @@ TEST(DEMData, BackfillNeighbor) {
     PremultipliedImage image2 = fakeImage({4, 4});
     DEMData dem1(image2, Tileset::DEMEncoding::Mapbox);
 
-    dem0.backfillBorder(dem1, -1, 0);
+    // The backfilled pixels are returned in image coordinates, offset by the border.
+    EXPECT_TRUE(dem0.backfillBorder(dem1, -1, 0) == Rect<uint32_t>(1, 2, 1, 4));
     for (int y = 0; y < 4; y++) {
         // dx = -1, dy = 0, so the left edge of dem1 should equal the right edge of dem0
         // backfills Left neighbor
@@ -135,7 +156,7 @@ TEST(DEMData, BackfillNeighbor) {
     // backfulls TopRight neighbor
     EXPECT_TRUE(dem0.get(-1, 4) == dem1.get(3, 0));
 
-    dem0.backfillBorder(dem1, 1, 1);
+    EXPECT_TRUE(dem0.backfillBorder(dem1, 1, 1) == Rect<uint32_t>(6, 6, 1, 1));
     // backfulls BottomRight neighbor
     EXPECT_TRUE(dem0.get(4, 4) == dem1.get(0, 0));
 
@@ -147,3 +168,53 @@ TEST(DEMData, BackfillNeighbor) {
     // backfulls BottomLeft neighbor
     EXPECT_TRUE(dem0.get(4, -1) == dem1.get(0, 3));
 };
+
+TEST(DEMData, PrepareHillshade) {
+    PremultipliedImage image = terrainImage({16, 16}, 20);
+    DEMData dem(image, Tileset::DEMEncoding::Mapbox);
+    const uint8_t zoom = 10;
+    const uint8_t maxzoom = 15;
+
+    PremultipliedImage slopes = dem.prepareHillshade(zoom, maxzoom);
+    ASSERT_EQ(slopes.size, Size(16, 16));
+
+    // Compare against the arithmetic of the hillshade_prepare shader.
+    auto elevation = [&] (int x, int y) {
+        return float(dem.get(x, y) + 65536) / 4.0f;
+    };
+    auto encode = [] (float slope) {
+        return int(std::round(util::clamp(slope / 2.0f + 0.5f, 0.0f, 1.0f) * 255.0f));
+    };
+    const float divisor = std::pow(2.0f, (zoom - maxzoom) * 0.3f + 19.2562f - zoom);
+
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+            const float dx = (elevation(x + 1, y - 1) + 2 * elevation(x + 1, y) + elevation(x + 1, y + 1)) -
+                             (elevation(x - 1, y - 1) + 2 * elevation(x - 1, y) + elevation(x - 1, y + 1));
+            const float dy = (elevation(x - 1, y + 1) + 2 * elevation(x, y + 1) + elevation(x + 1, y + 1)) -
+                             (elevation(x - 1, y - 1) + 2 * elevation(x, y - 1) + elevation(x + 1, y - 1));
+            const uint8_t* pixel = slopes.data.get() + (y * 16 + x) * 4;
+            EXPECT_LE(std::abs(pixel[0] - encode(dx / divisor)), 1);
+            EXPECT_LE(std::abs(pixel[1] - encode(dy / divisor)), 1);
+            EXPECT_EQ(pixel[2], 255);
+            EXPECT_EQ(pixel[3], 255);
+        }
+    }
+}
+
+TEST(DEMData, PrepareHillshadeEdge) {
+    PremultipliedImage image0 = terrainImage({16, 16}, 10);
+    DEMData dem0(image0, Tileset::DEMEncoding::Mapbox);
+    PremultipliedImage image1 = terrainImage({16, 16}, -10);
+    DEMData dem1(image1, Tileset::DEMEncoding::Mapbox);
+
+    PremultipliedImage slopes = dem0.prepareHillshade(4, 15);
+    dem0.backfillBorder(dem1, -1, 0);
+    dem0.backfillBorder(dem1, 1, 1);
+    EXPECT_NE(slopes, dem0.prepareHillshade(4, 15));
+
+    // Only slopes along the edges depend on the border.
+    EXPECT_TRUE(dem0.prepareHillshadeEdge(slopes, -1, 0, 4, 15) == Rect<uint32_t>(0, 0, 1, 16));
+    EXPECT_TRUE(dem0.prepareHillshadeEdge(slopes, 1, 1, 4, 15) == Rect<uint32_t>(15, 15, 1, 1));
+    EXPECT_EQ(slopes, dem0.prepareHillshade(4, 15));
+}
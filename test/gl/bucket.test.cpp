@@ -4,16 +4,27 @@
 #include <mbgl/renderer/backend_scope.hpp>
 #include <mbgl/renderer/buckets/circle_bucket.hpp>
 #include <mbgl/renderer/buckets/fill_bucket.hpp>
+#include <mbgl/renderer/buckets/fill_extrusion_bucket.hpp>
 #include <mbgl/renderer/buckets/line_bucket.hpp>
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
+#include <mbgl/renderer/layers/render_circle_layer.hpp>
+#include <mbgl/renderer/property_evaluation_parameters.hpp>
+#include <mbgl/renderer/transition_parameters.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
 
 #include <mbgl/map/mode.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace mbgl {
 
 template <class Attributes>
@@ -61,6 +72,44 @@ TEST(Buckets, CircleBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+TEST(Buckets, CircleBucketSharedBinders) {
+    HeadlessBackend backend({ 512, 256 });
+    BackendScope scope { backend };
+
+    const style::SourceFunction<float> radius { "radius", style::IdentityStops<float>() };
+    const style::SourceFunction<float> width { "width", style::IdentityStops<float>() };
+
+    std::vector<std::unique_ptr<RenderLayer>> renderLayers;
+    for (const auto& id : { "a", "b", "c" }) {
+        style::CircleLayer layer { id, "source" };
+        layer.setCircleRadius(std::string(id) == "c" ? width : radius);
+        auto renderLayer = RenderLayer::create(layer.baseImpl);
+        renderLayer->transition(TransitionParameters { Clock::now(), {} });
+        renderLayer->evaluate(PropertyEvaluationParameters { 0 });
+        renderLayers.push_back(std::move(renderLayer));
+    }
+
+    gl::Context context;
+    CircleBucket bucket { { {0, 0, 0}, MapMode::Static, 1.0, gl::IndexType::UnsignedShort, true },
+                          { renderLayers[0].get(), renderLayers[1].get(), renderLayers[2].get() } };
+
+    // Layers with the same function share its attribute values.
+    const auto& a = bucket.paintPropertyBinders.at("a");
+    const auto& b = bucket.paintPropertyBinders.at("b");
+    const auto& c = bucket.paintPropertyBinders.at("c");
+    EXPECT_EQ(&a.statistics<style::CircleRadius>(), &b.statistics<style::CircleRadius>());
+    EXPECT_NE(&a.statistics<style::CircleRadius>(), &c.statistics<style::CircleRadius>());
+
+    GeometryCollection point { { { 0, 0 } } };
+    PropertyMap values { { "radius", 3.0 }, { "width", 2.5 } };
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Point, point, values }, point);
+    EXPECT_EQ(3.0f, *a.statistics<style::CircleRadius>().max());
+    EXPECT_EQ(2.5f, *c.statistics<style::CircleRadius>().max());
+
+    bucket.upload(context);
+    EXPECT_FALSE(bucket.needsUpload());
+}
+
 TEST(Buckets, FillBucket) {
     HeadlessBackend backend({ 512, 256 });
     BackendScope scope { backend };
@@ -102,6 +151,111 @@ TEST(Buckets, LineBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+namespace {
+
+// A ring of `count` vertices around the center of a tile.
+GeometryCoordinates circle(std::size_t count) {
+    GeometryCoordinates ring;
+    for (std::size_t i = 0; i < count; i++) {
+        const double angle = util::M2PI * i / count;
+        ring.emplace_back(4096 + std::round(16000 * std::cos(angle)), 4096 + std::round(16000 * std::sin(angle)));
+    }
+    return ring;
+}
+
+} // namespace
+
+TEST(Buckets, FillBucketUint16Indices) {
+    FillBucket bucket { { {0, 0, 0}, MapMode::Static, 1.0 }, {} };
+
+    // A polygon with more vertices than 16-bit indices can address can't be drawn.
+    GeometryCollection polygon { circle(70000) };
+    EXPECT_ANY_THROW(bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon));
+
+    // Smaller polygons are split into several segments.
+    GeometryCollection small { circle(40000) };
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, small, properties }, small);
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, small, properties }, small);
+    EXPECT_EQ(gl::IndexType::UnsignedShort, bucket.triangles.indexType());
+    EXPECT_EQ(2u, bucket.triangleSegments.size());
+    EXPECT_EQ(2u, bucket.lineSegments.size());
+}
+
+TEST(Buckets, FillBucketUint32Indices) {
+    FillBucket bucket { { {0, 0, 0}, MapMode::Static, 1.0, gl::IndexType::UnsignedInt }, {} };
+
+    GeometryCollection polygon { circle(70000) };
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon);
+    bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon);
+
+    EXPECT_EQ(gl::IndexType::UnsignedInt, bucket.triangles.indexType());
+    ASSERT_EQ(1u, bucket.triangleSegments.size());
+    ASSERT_EQ(1u, bucket.lineSegments.size());
+    EXPECT_EQ(140000u, bucket.triangleSegments[0].vertexLength);
+    EXPECT_EQ(140000u * 2, bucket.lineSegments[0].indexLength);
+    EXPECT_EQ(bucket.triangles.indexSize() * sizeof(uint32_t), bucket.triangles.byteSize());
+
+    // Indices of the second polygon refer past the first 65535 vertices.
+    const auto& indices = bucket.triangles.vector32();
+    EXPECT_EQ(139999u, *std::max_element(indices.begin(), indices.end()));
+}
+
+TEST(Buckets, FillBucketParallelTessellation) {
+    ThreadPool threadPool { 4 };
+    FillBucket serial { { {0, 0, 0}, MapMode::Static, 1.0, gl::IndexType::UnsignedShort }, {} };
+    FillBucket parallel { { {0, 0, 0}, MapMode::Static, 1.0, gl::IndexType::UnsignedShort, false, &threadPool }, {} };
+
+    for (std::size_t count = 100; count <= 12800; count *= 2) {
+        GeometryCollection polygon { circle(count) };
+        serial.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon);
+        parallel.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon);
+    }
+
+    // Polygons are only tessellated once all features are added.
+    EXPECT_TRUE(parallel.triangleSegments.empty());
+    serial.finishFeatures();
+    parallel.finishFeatures();
+
+    EXPECT_EQ(serial.triangles.vector(), parallel.triangles.vector());
+    EXPECT_EQ(serial.triangleSegments, parallel.triangleSegments);
+    EXPECT_EQ(serial.lineSegments, parallel.lineSegments);
+}
+
+TEST(Buckets, FillExtrusionBucketParallelTessellation) {
+    ThreadPool threadPool { 4 };
+    FillExtrusionBucket serial { { {0, 0, 0}, MapMode::Static, 1.0, gl::IndexType::UnsignedShort }, {} };
+    FillExtrusionBucket parallel { { {0, 0, 0}, MapMode::Static, 1.0, gl::IndexType::UnsignedShort, false, &threadPool }, {} };
+
+    // With their walls, the polygons need more vertices than a segment with 16-bit indices holds.
+    for (std::size_t count = 100; count <= 12800; count *= 2) {
+        GeometryCollection polygon { circle(count) };
+        serial.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon);
+        parallel.addFeature(StubGeometryTileFeature { {}, FeatureType::Polygon, polygon, properties }, polygon);
+    }
+
+    EXPECT_TRUE(parallel.triangleSegments.empty());
+    serial.finishFeatures();
+    parallel.finishFeatures();
+
+    EXPECT_LT(1u, serial.triangleSegments.size());
+    EXPECT_EQ(serial.vertices.vector(), parallel.vertices.vector());
+    EXPECT_EQ(serial.triangles.vector(), parallel.triangles.vector());
+    EXPECT_EQ(serial.triangleSegments, parallel.triangleSegments);
+}
+
+TEST(Buckets, LineBucketUint32Indices) {
+    LineBucket bucket { { {0, 0, 0}, MapMode::Static, 1.0, gl::IndexType::UnsignedInt }, {}, {} };
+
+    GeometryCollection line { circle(20000) };
+    for (int i = 0; i < 3; i++) {
+        bucket.addFeature(StubGeometryTileFeature { {}, FeatureType::LineString, line, properties }, line);
+    }
+
+    EXPECT_GT(bucket.vertices.vertexSize(), std::size_t(std::numeric_limits<uint16_t>::max()));
+    ASSERT_EQ(1u, bucket.segments.size());
+    EXPECT_EQ(bucket.vertices.vertexSize(), bucket.segments[0].vertexLength);
+}
+
 TEST(Buckets, SymbolBucket) {
     HeadlessBackend backend({ 512, 256 });
     BackendScope scope { backend };
@@ -7,6 +7,7 @@
 #include <mbgl/map/map.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/headless_frontend.hpp>
+#include <mbgl/renderer/renderer.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/storage/default_file_source.hpp>
@@ -15,11 +16,14 @@
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/async_task.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/image.hpp>
 #include <mbgl/style/layers/background_layer.hpp>
 #include <mbgl/util/color.hpp>
 
+#include <set>
+
 using namespace mbgl;
 using namespace mbgl::style;
 using namespace std::literals::string_literals;
@@ -430,6 +434,187 @@ TEST(Map, WithoutVAOExtension) {
     test::checkImage("test/fixtures/map/no_vao", test.frontend.render(test.map), 0.002);
 }
 
+TEST(Map, TileMaskClipping) {
+    MapTest<> test;
+
+    // A translucent polygon across the four tiles of zoom level 1, which are drawn with their
+    // buffers. Any part of a tile drawn outside its own area blends twice.
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "polygon": {
+          "type": "geojson",
+          "data": { "type": "Polygon", "coordinates": [[[-60, -40], [60, -40], [60, 40], [-60, 40], [-60, -40]]] }
+        }
+      },
+      "layers": [{
+        "id": "polygon",
+        "type": "fill",
+        "source": "polygon",
+        "paint": { "fill-color": "red", "fill-opacity": 0.5, "fill-outline-color": "black" }
+      }]
+    })STYLE");
+    test.map.setLatLngZoom({ 0, 0 }, 1);
+
+    const PremultipliedImage stencil = test.frontend.render(test.map);
+    test.frontend.getRenderer()->setTileMaskClipping(true);
+    const PremultipliedImage masks = test.frontend.render(test.map);
+
+    ASSERT_EQ(stencil.bytes(), masks.bytes());
+    EXPECT_TRUE(std::equal(stencil.data.get(), stencil.data.get() + stencil.bytes(), masks.data.get()));
+}
+
+TEST(Map, TileMaskClippingZoomTransition) {
+    MapTest<> test { 1, MapMode::Continuous };
+
+    // Every tile is served the same data, so a parent standing in for its children draws the
+    // translucent water at a different scale than they do. Tiles that aren't served fail once,
+    // which lets the frames complete, and are served as soon as they're added to the set.
+    const std::string data = util::read_file("test/fixtures/api/assets/streets/0-0-0.vector.pbf");
+    std::set<std::string> served { "0/0/0" };
+    std::set<std::string> failed;
+    std::set<std::string> delivered;
+    test.fileSource.tileResponse = [&] (const Resource& resource) -> optional<Response> {
+        const Resource::TileData& tile = *resource.tileData;
+        const std::string id = util::toString(int(tile.z)) + "/" + util::toString(tile.x) + "/" + util::toString(tile.y);
+        Response response;
+        if (served.count(id)) {
+            response.data = std::make_shared<std::string>(data);
+            delivered.insert(id);
+        } else if (failed.insert(id).second) {
+            response.error = std::make_unique<Response::Error>(Response::Error::Reason::Other, "not served");
+        } else {
+            return {};
+        }
+        return response;
+    };
+
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "streets": { "type": "vector", "tiles": [ "http://tiles/{z}-{x}-{y}.pbf" ] }
+      },
+      "layers": [{
+        "id": "water",
+        "type": "fill",
+        "source": "streets",
+        "source-layer": "water",
+        "paint": { "fill-color": "red", "fill-opacity": 0.5, "fill-outline-color": "black" }
+      }]
+    })STYLE");
+    test.map.setLatLngZoom({ 0, 0 }, 0);
+
+    std::size_t frames = 0;
+    bool complete = false;
+    bool capture = false;
+    PremultipliedImage image;
+    test.observer.didFinishRenderingFrameCallback = [&] (MapObserver::RenderMode mode) {
+        frames++;
+        complete = mode == MapObserver::RenderMode::Full;
+        if (capture) {
+            image = test.frontend.readStillImage();
+        }
+    };
+
+    auto renderFrame = [&] {
+        const std::size_t frame = frames;
+        test.map.triggerRepaint();
+        while (frames == frame) {
+            test.runLoop.runOnce();
+        }
+    };
+
+    auto renderComplete = [&] {
+        do {
+            renderFrame();
+        } while (!complete);
+    };
+
+    // Renders a frame with stencil and then with mask clipping.
+    auto renderBoth = [&] {
+        capture = true;
+        test.frontend.getRenderer()->setTileMaskClipping(false);
+        renderFrame();
+        PremultipliedImage stencil = std::move(image);
+        test.frontend.getRenderer()->setTileMaskClipping(true);
+        renderFrame();
+        PremultipliedImage masks = std::move(image);
+        capture = false;
+
+        EXPECT_EQ(stencil.size, masks.size);
+        EXPECT_TRUE(std::equal(stencil.data.get(), stencil.data.get() + stencil.bytes(), masks.data.get()));
+        return stencil;
+    };
+
+    renderComplete();
+
+    // Three of the four tiles around the center of zoom level 2 arrive, and the parent is
+    // drawn in the remaining quadrant with a mask of several parts.
+    served.insert({ "2/2/1", "2/1/2", "2/2/2" });
+    test.map.setZoom(2);
+    renderComplete();
+    const PremultipliedImage partial = renderBoth();
+
+    // Once the last one arrives, the children cover all of the parent's area.
+    served.insert("2/1/1");
+    while (!delivered.count("2/1/1")) {
+        renderFrame();
+    }
+    complete = false;
+    renderComplete();
+    const PremultipliedImage covered = renderBoth();
+
+    EXPECT_FALSE(std::equal(partial.data.get(), partial.data.get() + partial.bytes(), covered.data.get()));
+}
+
+TEST(Map, RenderPipelined) {
+    MapTest<> test;
+
+    test.map.getStyle().loadJSON(R"STYLE({
+      "version": 8,
+      "sources": {
+        "polygon": {
+          "type": "geojson",
+          "data": { "type": "Polygon", "coordinates": [[[-60, -40], [60, -40], [60, 40], [-60, 40], [-60, -40]]] }
+        }
+      },
+      "layers": [{
+        "id": "background",
+        "type": "background",
+        "paint": { "background-color": "white" }
+      }, {
+        "id": "polygon",
+        "type": "fill",
+        "source": "polygon",
+        "paint": { "fill-color": "red", "fill-outline-color": "black" }
+      }]
+    })STYLE");
+
+    auto equal = [] (const PremultipliedImage& a, const PremultipliedImage& b) {
+        return a.size == b.size && std::equal(a.data.get(), a.data.get() + a.bytes(), b.data.get());
+    };
+
+    const LatLng first { 0, 0 };
+    const LatLng second { 40, 60 };
+
+    // Each call returns the image of the previous one, and finishRender() that of the last.
+    test.map.setLatLngZoom(first, 1);
+    const PremultipliedImage none = test.frontend.renderPipelined(test.map);
+    test.map.setLatLngZoom(second, 2);
+    const PremultipliedImage pipelinedFirst = test.frontend.renderPipelined(test.map);
+    const PremultipliedImage pipelinedSecond = test.frontend.finishRender();
+
+    test.map.setLatLngZoom(first, 1);
+    const PremultipliedImage expectedFirst = test.frontend.render(test.map);
+    test.map.setLatLngZoom(second, 2);
+    const PremultipliedImage expectedSecond = test.frontend.render(test.map);
+
+    ASSERT_FALSE(equal(expectedFirst, expectedSecond));
+    EXPECT_FALSE(none.valid());
+    EXPECT_TRUE(equal(expectedFirst, pipelinedFirst));
+    EXPECT_TRUE(equal(expectedSecond, pipelinedSecond));
+}
+
 TEST(Map, RemoveLayer) {
     MapTest<> test;
 
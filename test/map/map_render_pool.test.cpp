@@ -0,0 +1,123 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/map_render_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+class RenderPoolTest {
+public:
+    struct Result {
+        bool failed;
+        uint32_t width;
+        std::thread::id thread;
+    };
+
+    MapRenderPool::Callback callback() {
+        return [this] (std::exception_ptr error, PremultipliedImage image) {
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back({ bool(error), image.size.width, std::this_thread::get_id() });
+            received.notify_all();
+        };
+    }
+
+    std::vector<Result> wait(std::size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        received.wait(lock, [&] { return results.size() >= count; });
+        return results;
+    }
+
+    util::RunLoop loop;
+    DefaultFileSource fileSource { ":memory:", "." };
+    ThreadPool threadPool { 4 };
+    const std::string styleURL = "asset://test/fixtures/api/empty.json";
+
+private:
+    std::mutex mutex;
+    std::condition_variable received;
+    std::vector<Result> results;
+};
+
+MapRenderPool::Request request(uint32_t size, float pixelRatio) {
+    return { CameraOptions(), { size, size }, pixelRatio };
+}
+
+} // namespace
+
+TEST(MapRenderPool, QueuesRequests) {
+    RenderPoolTest test;
+    MapRenderPool pool { test.fileSource, test.threadPool, test.styleURL, 1 };
+
+    // The map is busy with the first request. Once it's done, it takes the queued request with
+    // its pixel ratio before the older one that needs it to be recreated.
+    pool.render(request(40, 1), test.callback());
+    pool.render(request(30, 2), test.callback());
+    pool.render(request(20, 1), test.callback());
+
+    auto results = test.wait(3);
+    ASSERT_EQ(3u, results.size());
+    EXPECT_FALSE(results[0].failed);
+    EXPECT_FALSE(results[1].failed);
+    EXPECT_FALSE(results[2].failed);
+    EXPECT_EQ(40u, results[0].width);
+    EXPECT_EQ(20u, results[1].width);
+    EXPECT_EQ(60u, results[2].width);
+}
+
+TEST(MapRenderPool, PrefersMapsWithPixelRatio) {
+    RenderPoolTest test;
+    MapRenderPool pool { test.fileSource, test.threadPool, test.styleURL, 2 };
+
+    // The first idle map is recreated with the new pixel ratio.
+    pool.render(request(10, 2), test.callback());
+    test.wait(1);
+
+    // Both maps are idle, and each request goes to the one with its pixel ratio.
+    pool.render(request(10, 1), test.callback());
+    pool.render(request(10, 2), test.callback());
+
+    auto results = test.wait(3);
+    ASSERT_EQ(3u, results.size());
+    for (std::size_t i = 1; i < 3; i++) {
+        EXPECT_FALSE(results[i].failed);
+        if (results[i].width == 20) {
+            EXPECT_EQ(results[0].thread, results[i].thread);
+        } else {
+            EXPECT_EQ(10u, results[i].width);
+            EXPECT_NE(results[0].thread, results[i].thread);
+        }
+    }
+}
+
+TEST(MapRenderPool, DestructionCallsBackOutstandingRequests) {
+    RenderPoolTest test;
+    auto pool = std::make_unique<MapRenderPool>(test.fileSource, test.threadPool, test.styleURL, 1);
+
+    pool->render(request(10, 1), test.callback());
+    pool->render(request(10, 1), test.callback());
+    pool->render(request(10, 1), test.callback());
+    pool.reset();
+
+    // Every request is called back, at least the queued ones with an error and no image.
+    auto results = test.wait(3);
+    ASSERT_EQ(3u, results.size());
+    std::size_t failed = 0;
+    for (const auto& result : results) {
+        if (result.failed) {
+            EXPECT_EQ(0u, result.width);
+            failed++;
+        }
+    }
+    EXPECT_LE(2u, failed);
+}
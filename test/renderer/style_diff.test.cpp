@@ -0,0 +1,84 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/style_diff.hpp>
+#include <mbgl/style/collection.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+TEST(StyleDiff, JournalChanged) {
+    Collection<Layer> layers;
+    layers.add(std::make_unique<LineLayer>("a", "source"));
+    layers.add(std::make_unique<LineLayer>("b", "source"));
+
+    auto beforeImpls = layers.getImpls();
+    auto beforeJournal = layers.getJournal();
+
+    auto line = static_cast<LineLayer*>(layers.get("b"));
+    line->setLineColor(Color::red());
+    layers.update(*line);
+
+    LayerDifference diff = diffLayers(beforeImpls, layers.getImpls(), beforeJournal, layers.getJournal());
+    EXPECT_TRUE(diff.added.empty());
+    EXPECT_TRUE(diff.removed.empty());
+    ASSERT_EQ(1u, diff.changed.size());
+    EXPECT_EQ(line->baseImpl, diff.changed.at("b").after);
+    EXPECT_FALSE(hasLayoutDifference(diff, "b"));
+}
+
+TEST(StyleDiff, JournalAddedAndRemoved) {
+    Collection<Layer> layers;
+    layers.add(std::make_unique<LineLayer>("a", "source"));
+    layers.add(std::make_unique<LineLayer>("b", "source"));
+
+    auto beforeImpls = layers.getImpls();
+    auto beforeJournal = layers.getJournal();
+
+    layers.remove("a");
+    layers.add(std::make_unique<CircleLayer>("c", "source"));
+    layers.add(std::make_unique<CircleLayer>("d", "source"));
+    layers.remove("d");
+
+    LayerDifference diff = diffLayers(beforeImpls, layers.getImpls(), beforeJournal, layers.getJournal());
+    ASSERT_EQ(1u, diff.added.size());
+    EXPECT_EQ(1u, diff.added.count("c"));
+    ASSERT_EQ(1u, diff.removed.size());
+    EXPECT_EQ(1u, diff.removed.count("a"));
+    EXPECT_TRUE(diff.changed.empty());
+}
+
+TEST(StyleDiff, JournalTypeChange) {
+    Collection<Layer> layers;
+    layers.add(std::make_unique<LineLayer>("a", "source"));
+
+    auto beforeImpls = layers.getImpls();
+    auto beforeJournal = layers.getJournal();
+
+    layers.remove("a");
+    layers.add(std::make_unique<CircleLayer>("a", "source"));
+
+    LayerDifference diff = diffLayers(beforeImpls, layers.getImpls(), beforeJournal, layers.getJournal());
+    EXPECT_EQ(1u, diff.added.count("a"));
+    EXPECT_EQ(1u, diff.removed.count("a"));
+    EXPECT_TRUE(diff.changed.empty());
+}
+
+TEST(StyleDiff, JournalFallback) {
+    Collection<Layer> layers;
+    layers.add(std::make_unique<LineLayer>("a", "source"));
+
+    auto beforeImpls = layers.getImpls();
+    auto beforeJournal = layers.getJournal();
+
+    // Clearing the collection resets the journal, which requires a full diff.
+    layers.clear();
+    layers.add(std::make_unique<LineLayer>("b", "source"));
+    EXPECT_FALSE(layers.getJournal()->covers(beforeJournal->collection, beforeJournal->version));
+
+    LayerDifference diff = diffLayers(beforeImpls, layers.getImpls(), beforeJournal, layers.getJournal());
+    EXPECT_EQ(1u, diff.added.count("b"));
+    EXPECT_EQ(1u, diff.removed.count("a"));
+    EXPECT_TRUE(diff.changed.empty());
+}
@@ -4,6 +4,7 @@
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -407,6 +408,56 @@ TEST(OfflineDatabase, PutReturnsSize) {
     EXPECT_EQ(0u, db.put(Resource::style("http://example.com/noContent"), noContent).second);
 }
 
+TEST(OfflineDatabase, PutCompressionCodec) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+
+    Response compressible;
+    compressible.data = std::make_shared<std::string>(1024, 0);
+    EXPECT_EQ(17u, db.put(Resource::style("http://example.com/zlib"), compressible).second);
+
+    db.setCompressionCodec(util::CompressionCodec::LZ4);
+    EXPECT_EQ(18u, db.put(Resource::style("http://example.com/lz4"), compressible).second);
+
+    db.setCompressionCodec(util::CompressionCodec::None);
+    EXPECT_EQ(1024u, db.put(Resource::style("http://example.com/none"), compressible).second);
+
+    // Data is read back with the codec it was written with.
+    for (const auto url : { "http://example.com/zlib", "http://example.com/lz4", "http://example.com/none" }) {
+        auto result = db.get(Resource::style(url));
+        ASSERT_TRUE(result && result->data);
+        EXPECT_EQ(*compressible.data, *result->data);
+    }
+}
+
+TEST(OfflineDatabase, PutCompressedTile) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+    Resource resource = Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+
+    // Tiles the server compressed are stored and returned as they are.
+    Response compressed;
+    compressed.data = std::make_shared<std::string>(util::compress(std::string(1024, 0)));
+    EXPECT_EQ(compressed.data->size(), db.put(resource, compressed).second);
+    EXPECT_EQ(*compressed.data, *db.get(resource)->data);
+
+    // Tiles compressed with zlib by the database are returned compressed too, and the tile
+    // workers inflate them.
+    Response compressible;
+    compressible.data = std::make_shared<std::string>(1024, 0);
+    db.put(resource, compressible);
+    auto result = db.get(resource);
+    EXPECT_TRUE(util::isCompressed(*result->data));
+    EXPECT_EQ(*compressible.data, util::decompress(*result->data));
+
+    // Other codecs are decompressed by the database.
+    db.setCompressionCodec(util::CompressionCodec::LZ4);
+    db.put(resource, compressible);
+    EXPECT_EQ(*compressible.data, *db.get(resource)->data);
+}
+
 TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     using namespace mbgl;
 
@@ -758,3 +809,42 @@ TEST(OfflineDatabase, DowngradeSchema) {
                                          "compressed", "accessed", "must_revalidate" }),
               databaseTableColumns("test/fixtures/offline_database/migrated.db", "resources"));
 }
+
+TEST(OfflineDatabase, CompressionCodecSchemaVersion) {
+    using namespace mbgl;
+
+    deleteFile("test/fixtures/offline_database/migrated.db");
+
+    Response compressible;
+    compressible.data = std::make_shared<std::string>(1024, 0);
+
+    // Databases without LZ4 rows stay readable by earlier versions.
+    {
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db");
+        db.put(Resource::style("http://example.com/zlib"), compressible);
+        db.setCompressionCodec(util::CompressionCodec::None);
+        db.put(Resource::style("http://example.com/none"), compressible);
+    }
+
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+
+    {
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db");
+        db.setCompressionCodec(util::CompressionCodec::LZ4);
+        db.put(Resource::style("http://example.com/lz4"), compressible);
+    }
+
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+
+    // The database is kept once it's at version 7.
+    {
+        OfflineDatabase db("test/fixtures/offline_database/migrated.db");
+        for (const auto url : { "http://example.com/zlib", "http://example.com/none", "http://example.com/lz4" }) {
+            auto result = db.get(Resource::style(url));
+            ASSERT_TRUE(result && result->data);
+            EXPECT_EQ(*compressible.data, *result->data);
+        }
+    }
+
+    EXPECT_EQ(7, databaseUserVersion("test/fixtures/offline_database/migrated.db"));
+}
@@ -1,4 +1,5 @@
 #include <mbgl/test/util.hpp>
+#include <mbgl/test/stub_geometry_tile_feature.hpp>
 
 #include <mbgl/style/conversion/json.hpp>
 #include <mbgl/style/conversion/constant.hpp>
@@ -78,3 +79,28 @@ TEST(StyleConversion, CompositeFunctionExpression) {
     ASSERT_FALSE(fn5);
     ASSERT_EQ(R"("zoom" expression may only be used as input to a top-level "step" or "interpolate" expression.)", error.message);
 }
+
+TEST(StyleConversion, FeatureStateExpression) {
+    Error error;
+
+    JSDocument doc;
+    doc.Parse<0>(R"(["case", ["boolean", ["feature-state", "hover"], false], 1, 0])");
+    auto fn = convert<DataDrivenPropertyValue<float>>(doc, error);
+    ASSERT_TRUE(fn);
+    ASSERT_TRUE(fn->isDataDriven());
+
+    StubGeometryTileFeature feature { PropertyMap {} };
+    FeatureState hover {{ "hover", true }};
+    FeatureState noHover {{ "hover", false }};
+
+    fn->match(
+        [&] (const SourceFunction<float>& function) {
+            EXPECT_EQ(0.0f, function.evaluate(feature, 2.0f));
+            EXPECT_EQ(0.0f, function.evaluate(feature, FeatureState {}, 2.0f));
+            EXPECT_EQ(0.0f, function.evaluate(feature, noHover, 2.0f));
+            EXPECT_EQ(1.0f, function.evaluate(feature, hover, 2.0f));
+        },
+        [&] (const auto&) {
+            FAIL() << "expected a source function";
+        });
+}
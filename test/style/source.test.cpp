@@ -9,6 +9,7 @@
 #include <mbgl/style/sources/raster_dem_source.hpp>
 #include <mbgl/style/sources/vector_source.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/style/sources/image_source.hpp>
 #include <mbgl/style/sources/custom_geometry_source.hpp>
 #include <mbgl/style/layers/hillshade_layer.cpp>
@@ -39,6 +40,9 @@
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 
+#include <numeric>
+#include <set>
+
 #include <cstdint>
 
 using namespace mbgl;
@@ -708,6 +712,155 @@ TEST(Source, GeoJSonSourceUrlUpdate) {
     test.run();
 }
 
+TEST(Source, GeoJSONSourceUpdate) {
+    auto point = [] (double lng, double lat, uint64_t id) {
+        Feature feature { mapbox::geometry::point<double>{ lng, lat } };
+        feature.id = id;
+        return feature;
+    };
+
+    GeoJSONSource source("source");
+    source.setGeoJSON(GeoJSON{ FeatureCollection{ point(10, 10, 1), point(20, 20, 2), point(-30, -30, 3) } });
+
+    auto initial = static_cast<const GeoJSONSource::Impl&>(*source.baseImpl).getData();
+    ASSERT_TRUE(initial);
+    EXPECT_EQ(3u, initial->getTile({ 0, 0, 0 }).size());
+
+    GeoJSONDiff diff;
+    diff.add.push_back(point(40, 40, 2));
+    diff.add.push_back(point(50, 50, 4));
+    diff.remove.push_back(uint64_t(3));
+    source.updateGeoJSON(diff);
+
+    auto updated = static_cast<const GeoJSONSource::Impl&>(*source.baseImpl).getData();
+    ASSERT_TRUE(updated);
+    EXPECT_NE(initial, updated);
+
+    // The previous data is left untouched.
+    EXPECT_EQ(3u, initial->getTile({ 0, 0, 0 }).size());
+
+    auto features = updated->getTile({ 0, 0, 0 });
+    ASSERT_EQ(3u, features.size());
+    std::set<uint64_t> ids;
+    for (const auto& feature : features) {
+        ids.insert(feature.id->get<uint64_t>());
+    }
+    EXPECT_EQ((std::set<uint64_t>{ 1, 2, 4 }), ids);
+
+    // Changed bounds cover the old and new position of the replaced feature, the added feature
+    // and the removed feature, but not the unchanged one.
+    auto changed = updated->changedSince(*initial);
+    ASSERT_TRUE(bool(changed));
+    auto changedAt = [&] (double lng, double lat) {
+        for (const auto& bounds : *changed) {
+            if (bounds.contains(LatLng{ lat, lng })) {
+                return true;
+            }
+        }
+        return false;
+    };
+    EXPECT_FALSE(changedAt(10, 10));
+    EXPECT_TRUE(changedAt(20, 20));
+    EXPECT_TRUE(changedAt(40, 40));
+    EXPECT_TRUE(changedAt(50, 50));
+    EXPECT_TRUE(changedAt(-30, -30));
+
+    // Data that wasn't derived through updates reloads all tiles.
+    EXPECT_FALSE(bool(initial->changedSince(*updated)));
+    source.setGeoJSON(GeoJSON{ FeatureCollection{} });
+    auto replaced = static_cast<const GeoJSONSource::Impl&>(*source.baseImpl).getData();
+    EXPECT_FALSE(bool(replaced->changedSince(*updated)));
+}
+
+TEST(Source, GeoJSONSourceKeepsFeatureOrder) {
+    // Enough features to be split into several partitions, half of them without an ID.
+    const std::size_t count = 10000;
+    auto feature = [] (std::size_t i) {
+        Feature result { mapbox::geometry::point<double>{ -170.0 + (i % 100) * 3.4, -80.0 + (i / 100) * 1.6 } };
+        result.properties["index"] = uint64_t(i);
+        if (i % 2 == 0) {
+            result.id = uint64_t(i);
+        }
+        return result;
+    };
+
+    FeatureCollection features;
+    for (std::size_t i = 0; i < count; i++) {
+        features.push_back(feature(i));
+    }
+
+    auto indices = [] (const mapbox::geometry::feature_collection<int16_t>& tile) {
+        std::vector<uint64_t> result;
+        for (const auto& tileFeature : tile) {
+            result.push_back(tileFeature.properties.at("index").get<uint64_t>());
+        }
+        return result;
+    };
+
+    std::shared_ptr<GeoJSONData> data = GeoJSONData::create(GeoJSON{ features }, GeoJSONOptions());
+    auto tile = data->getTile({ 0, 0, 0 });
+    ASSERT_EQ(count, tile.size());
+
+    std::vector<uint64_t> expected(count);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(expected, indices(tile));
+
+    // Features keep their ID, or lack of one.
+    EXPECT_EQ(uint64_t(0), tile[0].id->get<uint64_t>());
+    EXPECT_FALSE(bool(tile[1].id));
+
+    // Replaced features keep their position, and added ones come after all others.
+    GeoJSONDiff diff;
+    diff.add.push_back(feature(count));
+    diff.add.push_back(feature(10));
+    diff.add.back().properties["index"] = uint64_t(count + 1);
+    diff.remove.push_back(uint64_t(20));
+    auto updated = data->update(diff);
+
+    expected.erase(expected.begin() + 20);
+    expected[10] = count + 1;
+    expected.push_back(count);
+    EXPECT_EQ(expected, indices(updated->getTile({ 0, 0, 0 })));
+}
+
+TEST(Source, GeoJSONSourceLoadsInBackground) {
+    SourceTest test;
+
+    GeoJSONSource source("source");
+    source.setObserver(&test.styleObserver);
+    source.loadDescription(test.fileSource);
+    EXPECT_TRUE(source.loaded);
+
+    Feature feature { mapbox::geometry::point<double>{ 0, 0 } };
+    feature.id = uint64_t(1);
+    source.setGeoJSON(GeoJSON{ FeatureCollection{ feature } });
+
+    // Data is indexed on the thread pool, and the source is loaded when it arrives.
+    EXPECT_FALSE(source.loaded);
+    EXPECT_FALSE(source.impl().getData());
+
+    GeoJSONDiff diff;
+    diff.remove.push_back(uint64_t(1));
+    source.updateGeoJSON(diff);
+
+    std::size_t changes = 0;
+    test.styleObserver.sourceChanged = [&] (Source&) {
+        changes++;
+    };
+    test.styleObserver.sourceLoaded = [&] (Source&) {
+        // Intermediate data is applied before the data of the latest request.
+        EXPECT_EQ(1u, changes);
+        EXPECT_TRUE(source.loaded);
+
+        auto data = source.impl().getData();
+        ASSERT_TRUE(data);
+        EXPECT_TRUE(data->getTile({ 0, 0, 0 }).empty());
+        test.end();
+    };
+
+    test.run();
+}
+
 TEST(Source, ImageSourceImageUpdate) {
     SourceTest test;
 
@@ -10,8 +10,15 @@
 #include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/conversion/data_driven_property_value.hpp>
+#include <mbgl/style/conversion/json.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/backend_scope.hpp>
+#include <mbgl/renderer/buckets/circle_bucket.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/style/conversion/filter.hpp>
 #include <mbgl/text/glyph_manager.hpp>
 
 #include <memory>
@@ -113,3 +120,140 @@ TEST(GeoJSONTile, Issue9927) {
     ASSERT_TRUE(tile.isRenderable());
     ASSERT_NE(nullptr, tile.getBucket(*layer.baseImpl));
  }
+
+// Tests that paint-only layer changes update the paint attributes of the existing bucket instead
+// of laying it out again, and that layout changes still lay it out again.
+TEST(GeoJSONTile, PaintPropertyUpdate) {
+    GeoJSONTileTest test;
+    HeadlessBackend backend({ 512, 256 });
+    BackendScope scope { backend };
+    gl::Context context;
+
+    CircleLayer layer("circle", "source");
+
+    auto color = [] (const std::string& json) {
+        style::conversion::Error error;
+        auto result = style::conversion::convertJSON<DataDrivenPropertyValue<Color>>(json, error);
+        EXPECT_TRUE(result) << error.message;
+        return *result;
+    };
+    layer.setCircleColor(color(R"(["to-color", ["get", "color"]])"));
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    for (const auto& value : { "red", "blue" }) {
+        features.push_back(mapbox::geometry::feature<int16_t> {
+            mapbox::geometry::point<int16_t>(0, 0)
+        });
+        features.back().properties["color"] = std::string(value);
+    }
+
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, features);
+
+    tile.setLayers({{ layer.baseImpl }});
+
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    auto bucket = static_cast<CircleBucket*>(tile.getBucket(*layer.baseImpl));
+    ASSERT_NE(nullptr, bucket);
+    bucket->upload(context);
+    ASSERT_TRUE(bucket->vertexBuffer && bucket->indexBuffer);
+    const gl::BufferID vertexBuffer = bucket->vertexBuffer->buffer.get();
+    const gl::BufferID indexBuffer = bucket->indexBuffer->buffer.get();
+
+    // The packed colors of the four vertices of each circle.
+    using ColorBinder = SourceFunctionPaintPropertyBinder<Color, CircleColor::Attribute::Type>;
+    auto colors = [&] {
+        auto binder = dynamic_cast<const ColorBinder*>(&bucket->paintPropertyBinders.at("circle").get<CircleColor>());
+        EXPECT_NE(nullptr, binder);
+        std::vector<std::array<float, 2>> result;
+        for (const auto& vertex : binder->getVertexVector().vector()) {
+            result.push_back(vertex.a1);
+        }
+        return result;
+    };
+    auto expected = [] (Color first, Color second) {
+        std::vector<std::array<float, 2>> result(4, attributeValue(first));
+        result.resize(8, attributeValue(second));
+        return result;
+    };
+
+    EXPECT_EQ(expected(Color::red(), Color::blue()), colors());
+
+    layer.setCircleColor(color(R"(["match", ["get", "color"], "red", "green", "black"])"));
+    tile.setLayers({{ layer.baseImpl }});
+
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    // The bucket keeps its layout buffers, and only its paint attributes are uploaded again.
+    ASSERT_EQ(bucket, tile.getBucket(*layer.baseImpl));
+    EXPECT_EQ(expected(*Color::parse("green"), Color::black()), colors());
+    EXPECT_TRUE(bucket->needsUpload());
+    bucket->upload(context);
+    EXPECT_EQ(vertexBuffer, bucket->vertexBuffer->buffer.get());
+    EXPECT_EQ(indexBuffer, bucket->indexBuffer->buffer.get());
+
+    // A filter is part of the layout, and changing it lays the tile out again.
+    style::conversion::Error error;
+    auto filter = style::conversion::convertJSON<Filter>(R"(["has", "color"])", error);
+    ASSERT_TRUE(filter) << error.message;
+    layer.setFilter(*filter);
+    tile.setLayers({{ layer.baseImpl }});
+
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    auto laidOut = static_cast<CircleBucket*>(tile.getBucket(*layer.baseImpl));
+    ASSERT_NE(nullptr, laidOut);
+    EXPECT_NE(bucket, laidOut);
+    EXPECT_FALSE(laidOut->vertexBuffer);
+    EXPECT_EQ(8u, laidOut->vertices.vertexSize());
+}
+
+TEST(GeoJSONTile, FeatureState) {
+    GeoJSONTileTest test;
+
+    CircleLayer layer("circle", "source");
+
+    style::conversion::Error error;
+    auto radius = style::conversion::convertJSON<DataDrivenPropertyValue<float>>(
+        R"(["case", ["boolean", ["feature-state", "hover"], false], 10, 5])", error);
+    ASSERT_TRUE(radius);
+    layer.setCircleRadius(*radius);
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(0, 0)
+    });
+    features.back().id = FeatureIdentifier { uint64_t(1) };
+    features.push_back(mapbox::geometry::feature<int16_t> {
+        mapbox::geometry::point<int16_t>(10, 10)
+    });
+
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, features);
+
+    tile.setLayers({{ layer.baseImpl }});
+
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+
+    Bucket* bucket = tile.getBucket(*layer.baseImpl);
+    ASSERT_NE(nullptr, bucket);
+
+    // Only features with an ID can have state.
+    ASSERT_EQ(1u, bucket->featureVertexRanges.size());
+    ASSERT_EQ(1u, bucket->featureVertexRanges.count("1"));
+    EXPECT_EQ(0u, tile.getFeatureStateVersion());
+
+    LayerFeatureStates states;
+    states[""]["1"] = FeatureState {{ "hover", true }};
+    tile.setFeatureState(states, 1);
+
+    EXPECT_EQ(bucket, tile.getBucket(*layer.baseImpl));
+    EXPECT_EQ(1u, tile.getFeatureStateVersion());
+}
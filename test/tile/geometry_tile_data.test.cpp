@@ -105,3 +105,40 @@ TEST(GeometryTileData, limitHoles3) {
     ASSERT_EQ(original.at(3), polygon.at(2));
 
 }
+
+TEST(GeometryTileData, simplifyLine) {
+    GeometryCollection simplified = simplifyGeometries({
+      { {0, 0}, {10, 1}, {20, -1}, {30, 0}, {30, 20}, {31, 40} }
+    }, FeatureType::LineString, 2);
+
+    // output: the points within 2 units of the simplified line are dropped, the endpoints kept
+    ASSERT_EQ(simplified.size(), 1u);
+    ASSERT_EQ(simplified[0], GeometryCoordinates({ {0, 0}, {30, 0}, {31, 40} }));
+
+    // a tolerance of 0 drops just the points on the simplified line
+    ASSERT_EQ(simplifyGeometries({ { {0, 0}, {10, 0}, {20, 0}, {20, 10} } }, FeatureType::LineString, 0),
+              GeometryCollection({ { {0, 0}, {20, 0}, {20, 10} } }));
+}
+
+TEST(GeometryTileData, simplifyPolygon) {
+    GeometryCollection simplified = simplifyGeometries({
+      { {0, 0}, {0, 20}, {1, 40}, {40, 40}, {40, 0}, {0, 0} },
+      { {10, 10}, {20, 10}, {20, 20}, {10, 10} },
+      { {30, 30}, {31, 30}, {31, 31}, {30, 30} },
+      { {100, 100}, {100, 101}, {101, 101}, {101, 100}, {100, 100} },
+      { {100, 100}, {101, 100}, {100, 101}, {100, 100} },
+      { {200, 200}, {200, 240}, {240, 240}, {240, 200}, {200, 200} },
+    }, FeatureType::Polygon, 2);
+
+    // output: the small hole and the small outer ring are dropped, along with the hole of the
+    // latter, and the exterior loses its point within tolerance
+    ASSERT_EQ(simplified.size(), 3u);
+    ASSERT_EQ(simplified[0], GeometryCoordinates({ {0, 0}, {1, 40}, {40, 40}, {40, 0}, {0, 0} }));
+    ASSERT_EQ(simplified[1], GeometryCoordinates({ {10, 10}, {20, 10}, {20, 20}, {10, 10} }));
+    ASSERT_EQ(simplified[2], GeometryCoordinates({ {200, 200}, {200, 240}, {240, 240}, {240, 200}, {200, 200} }));
+
+    std::vector<GeometryCollection> polygons = classifyRings(simplified);
+    ASSERT_EQ(polygons.size(), 2u);
+    ASSERT_EQ(polygons[0].size(), 2u);
+    ASSERT_EQ(polygons[1].size(), 1u);
+}
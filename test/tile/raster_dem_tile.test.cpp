@@ -91,3 +91,24 @@ TEST(RasterDEMTile, onParsedEmpty) {
     EXPECT_TRUE(tile.isComplete());
 }
 
+
+TEST(RasterDEMTile, BackfillBorder) {
+    RasterDEMTileTest test;
+    RasterDEMTile tile(OverscaledTileID(2, 1, 1), test.tileParameters, test.tileset);
+    RasterDEMTile neighbor(OverscaledTileID(2, 2, 1), test.tileParameters, test.tileset);
+    EXPECT_TRUE(tile.neighboringTiles == DEMTileNeighbors::Empty);
+
+    tile.onParsed(std::make_unique<HillshadeBucket>(PremultipliedImage({16, 16}), Tileset::DEMEncoding::Mapbox), 0);
+    neighbor.onParsed(std::make_unique<HillshadeBucket>(PremultipliedImage({16, 16}), Tileset::DEMEncoding::Mapbox), 0);
+    tile.backfillBorder(neighbor, DEMTileNeighbors::Right);
+    EXPECT_TRUE(tile.neighboringTiles == DEMTileNeighbors::Right);
+
+    // New data replaces the backfilled border, so it needs to be backfilled again.
+    tile.onParsed(std::make_unique<HillshadeBucket>(PremultipliedImage({16, 16}), Tileset::DEMEncoding::Mapbox), 1);
+    EXPECT_TRUE(tile.neighboringTiles == DEMTileNeighbors::Empty);
+
+    // Tiles at the top of the world have no upper neighbors.
+    RasterDEMTile top(OverscaledTileID(2, 1, 0), test.tileParameters, test.tileset);
+    top.onParsed(std::make_unique<HillshadeBucket>(PremultipliedImage({16, 16}), Tileset::DEMEncoding::Mapbox), 0);
+    EXPECT_TRUE(top.neighboringTiles == DEMTileNeighbors::NoUpper);
+}
@@ -1,15 +1,25 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/test/fake_file_source.hpp>
 #include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
+#include <mbgl/tile/geojson_tile_data.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/style/style.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/renderer/buckets/fill_bucket.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/property_evaluation_parameters.hpp>
+#include <mbgl/renderer/transition_parameters.hpp>
+#include <mbgl/text/collision_index.hpp>
 #include <mbgl/renderer/query.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
@@ -106,3 +116,56 @@ TEST(VectorTile, Issue8542) {
     std::vector<Feature> result;
     tile.querySourceFeatures(result, { { {"layer"} }, {} });
 }
+
+TEST(VectorTile, SimplificationKeepsQueryGeometry) {
+    VectorTileTest test;
+
+    // 4 pixels are 64 tile units at zoom level 0.
+    VectorTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, test.tileset, 4);
+
+    style::FillLayer layer("fill", "source");
+    layer.setSourceLayer("layer");
+    auto renderLayer = RenderLayer::create(layer.baseImpl);
+    renderLayer->transition(TransitionParameters { Clock::now(), {} });
+    renderLayer->evaluate(PropertyEvaluationParameters { 0 });
+
+    // A square with a spike of 40 tile units on its top edge, which is simplified away.
+    mapbox::geometry::feature_collection<int16_t> features;
+    features.push_back(mapbox::geometry::feature<int16_t> { mapbox::geometry::polygon<int16_t> { {
+        { 1000, 1000 }, { 5000, 1000 }, { 5000, 5000 }, { 3000, 5040 }, { 1000, 5000 }, { 1000, 1000 }
+    } } });
+
+    tile.setLayers({{ layer.baseImpl }});
+    tile.GeometryTile::setData(std::make_unique<GeoJSONTileData>(features));
+
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+    tile.commitFeatureIndex();
+
+    auto bucket = static_cast<FillBucket*>(tile.getBucket(*layer.baseImpl));
+    ASSERT_NE(nullptr, bucket);
+    EXPECT_EQ(5u, bucket->vertices.vertexSize());
+
+    // The tip of the spike is outside of the drawn polygon, but queries still find the feature
+    // there, and with its original geometry.
+    CollisionIndex collisionIndex { test.transformState };
+    std::unordered_map<std::string, std::vector<Feature>> result;
+    tile.queryRenderedFeatures(result, { { 3000, 5020 } }, test.transformState, { renderLayer.get() }, {}, collisionIndex);
+
+    ASSERT_EQ(1u, result["fill"].size());
+    const auto& polygon = result["fill"][0].geometry.get<mapbox::geometry::polygon<double>>();
+    ASSERT_EQ(1u, polygon.size());
+    EXPECT_EQ(6u, polygon[0].size());
+}
+
+TEST(VectorTileData, Compressed) {
+    const std::string raw = util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf");
+    VectorTileData tile(std::make_shared<std::string>(util::compress(raw)));
+
+    // Compressed data is inflated when it's parsed.
+    EXPECT_EQ(VectorTileData(std::make_shared<std::string>(raw)).layerNames(), tile.layerNames());
+    auto layer = tile.getLayer("road");
+    ASSERT_TRUE(layer);
+    EXPECT_LT(0u, layer->featureCount());
+}
@@ -0,0 +1,148 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compressed_image.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+// Reference decoders for the opaque subsets of BC1 and ETC1 the encoder produces.
+
+std::array<uint8_t, 3> unpack565(uint16_t c) {
+    const uint8_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    return {{ uint8_t(r << 3 | r >> 2), uint8_t(g << 2 | g >> 4), uint8_t(b << 3 | b >> 2) }};
+}
+
+void decodeBC1Block(const uint8_t* src, std::array<std::array<uint8_t, 3>, 16>& dst) {
+    const uint16_t c0 = src[0] | src[1] << 8;
+    const uint16_t c1 = src[2] | src[3] << 8;
+    const uint32_t indices = src[4] | src[5] << 8 | src[6] << 16 | uint32_t(src[7]) << 24;
+    const auto a = unpack565(c0);
+    const auto b = unpack565(c1);
+    std::array<std::array<uint8_t, 3>, 4> palette {{ a, b, {}, {} }};
+    for (int i = 0; i < 3; i++) {
+        if (c0 > c1) {
+            palette[2][i] = (2 * a[i] + b[i]) / 3;
+            palette[3][i] = (a[i] + 2 * b[i]) / 3;
+        } else {
+            palette[2][i] = (a[i] + b[i]) / 2;
+            palette[3][i] = 0;
+        }
+    }
+    for (int p = 0; p < 16; p++) {
+        dst[p] = palette[(indices >> (2 * p)) & 3];
+    }
+}
+
+void decodeETC1Block(const uint8_t* src, std::array<std::array<uint8_t, 3>, 16>& dst) {
+    static const int modifiers[8][2] = {
+        { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 }
+    };
+    const uint32_t high = uint32_t(src[0]) << 24 | src[1] << 16 | src[2] << 8 | src[3];
+    const uint32_t low = uint32_t(src[4]) << 24 | src[5] << 16 | src[6] << 8 | src[7];
+    const bool differential = high & 2;
+    const bool flip = high & 1;
+    int base[2][3];
+    for (int i = 0; i < 3; i++) {
+        const int channel = (high >> (24 - 8 * i)) & 0xFF;
+        if (differential) {
+            const int c0 = channel >> 3;
+            const int delta = (channel & 4) ? (channel & 7) - 8 : (channel & 7);
+            const int c1 = c0 + delta;
+            base[0][i] = c0 << 3 | c0 >> 2;
+            base[1][i] = c1 << 3 | c1 >> 2;
+        } else {
+            base[0][i] = (channel >> 4) * 17;
+            base[1][i] = (channel & 0xF) * 17;
+        }
+    }
+    const int tables[2] = { int(high >> 5) & 7, int(high >> 2) & 7 };
+    for (int y = 0; y < 4; y++) {
+        for (int x = 0; x < 4; x++) {
+            const int s = flip ? (y >= 2) : (x >= 2);
+            const int bit = x * 4 + y;
+            const int index = ((low >> (16 + bit)) & 1) << 1 | ((low >> bit) & 1);
+            const int modifier = (index & 2 ? -1 : 1) * modifiers[tables[s]][index & 1];
+            for (int i = 0; i < 3; i++) {
+                dst[y * 4 + x][i] = std::max(0, std::min(255, base[s][i] + modifier));
+            }
+        }
+    }
+}
+
+// The peak signal to noise ratio of the compressed image, in dB.
+double psnr(const PremultipliedImage& image, const CompressedImage& compressed) {
+    double error = 0;
+    const uint8_t* block = compressed.data.get();
+    for (std::size_t by = 0; by < compressed.blocksHigh(); by++) {
+        for (std::size_t bx = 0; bx < compressed.blocksWide(); bx++, block += 8) {
+            std::array<std::array<uint8_t, 3>, 16> pixels;
+            if (compressed.format == CompressedImageFormat::BC1) {
+                decodeBC1Block(block, pixels);
+            } else {
+                decodeETC1Block(block, pixels);
+            }
+            for (std::size_t p = 0; p < 16; p++) {
+                const std::size_t x = bx * 4 + p % 4;
+                const std::size_t y = by * 4 + p / 4;
+                if (x >= image.size.width || y >= image.size.height) {
+                    continue;
+                }
+                for (std::size_t i = 0; i < 3; i++) {
+                    const double d = double(pixels[p][i]) - image.data[y * image.stride() + x * 4 + i];
+                    error += d * d;
+                }
+            }
+        }
+    }
+    const double mse = error / (image.size.width * image.size.height * 3);
+    return 10 * std::log10(255.0 * 255.0 / mse);
+}
+
+} // namespace
+
+TEST(CompressedImage, Translucent) {
+    PremultipliedImage image({ 8, 8 });
+    image.fill(0x80);
+    EXPECT_FALSE(util::compress(image, CompressedImageFormat::BC1));
+    EXPECT_FALSE(util::compress(image, CompressedImageFormat::ETC1));
+}
+
+TEST(CompressedImage, Size) {
+    PremultipliedImage image({ 5, 3 });
+    image.fill(0xFF);
+    auto compressed = util::compress(image, CompressedImageFormat::BC1);
+    ASSERT_TRUE(compressed);
+    EXPECT_EQ(2u, compressed->blocksWide());
+    EXPECT_EQ(1u, compressed->blocksHigh());
+    EXPECT_EQ(16u, compressed->bytes());
+}
+
+TEST(CompressedImage, SolidColor) {
+    PremultipliedImage image({ 4, 4 });
+    for (std::size_t i = 0; i < 16; i++) {
+        image.data[i * 4 + 0] = 0xFF;
+        image.data[i * 4 + 1] = 0x00;
+        image.data[i * 4 + 2] = 0x84;
+        image.data[i * 4 + 3] = 0xFF;
+    }
+    for (auto format : { CompressedImageFormat::BC1, CompressedImageFormat::ETC1 }) {
+        auto compressed = util::compress(image, format);
+        ASSERT_TRUE(compressed);
+        EXPECT_LT(40.0, psnr(image, *compressed));
+    }
+}
+
+TEST(CompressedImage, RasterTile) {
+    const PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/tile.jpeg"));
+    for (auto format : { CompressedImageFormat::BC1, CompressedImageFormat::ETC1 }) {
+        auto compressed = util::compress(image, format);
+        ASSERT_TRUE(compressed);
+        EXPECT_EQ(image.bytes() / 8, compressed->bytes());
+        EXPECT_LT(30.0, psnr(image, *compressed));
+    }
+}
@@ -0,0 +1,134 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace mbgl;
+using util::CompressionCodec;
+
+TEST(Compression, LZ4) {
+    std::mt19937 generator;
+    std::string random(100000, '\0');
+    for (auto& byte : random) {
+        byte = char(generator());
+    }
+
+    const std::string tile = util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf");
+
+    for (const std::string& raw : { std::string(), std::string("a"), std::string(13, 'a'),
+                                    std::string(100000, 'a'), random, tile }) {
+        const std::string compressed = util::compress(raw, CompressionCodec::LZ4);
+        EXPECT_EQ(raw, util::decompress(compressed, CompressionCodec::LZ4));
+    }
+
+    // Compressible data, and the worst case of incompressible data.
+    EXPECT_EQ(18u, util::compress(std::string(1024, '\0'), CompressionCodec::LZ4).size());
+    EXPECT_GT(tile.size(), util::compress(tile, CompressionCodec::LZ4).size());
+    EXPECT_GE(random.size() + random.size() / 255 + 16, util::compress(random, CompressionCodec::LZ4).size());
+}
+
+TEST(Compression, LZ4Reference) {
+    // Blocks compressed by the reference liblz4 1.9.4 with LZ4_compress_default(). They cover
+    // literal and match lengths that spill into extra bytes, overlapping matches and offsets
+    // that need both bytes. The stored data is prefixed with the uncompressed size.
+    const std::string bytes = [] {
+        std::string result;
+        for (int i = 0; i < 256; i++) {
+            result += char(i);
+        }
+        return result;
+    }();
+
+    struct Vector {
+        std::string raw;
+        std::string stored;
+    };
+
+    const std::vector<Vector> vectors = {
+        { "", std::string("\x00\x00\x00\x00\x00", 5) },
+        { "hello hello hello hello hello hello",
+          std::string("\x23\x00\x00\x00\x6f\x68\x65\x6c\x6c\x6f\x20\x06\x00\x05\x50\x68\x65\x6c\x6c\x6f", 20) },
+        { "abcdefghijklmnopqrstuvwxyz abcdefghijklmnopqrstuvwxyz abcdefghijklmnopqrstuvwxyz",
+          std::string("\x50\x00\x00\x00\xff\x0c", 6) + "abcdefghijklmnopqrstuvwxyz " +
+          std::string("\x1b\x00\x1d\x50", 4) + "vwxyz" },
+        { std::string(300, 'x'),
+          std::string("\x2c\x01\x00\x00\x1f\x78\x01\x00\xff\x14\x50\x78\x78\x78\x78\x78", 16) },
+        { bytes + bytes.substr(0, 64) + "end of block",
+          std::string("\x4c\x01\x00\x00\xff\xf1", 6) + bytes +
+          std::string("\x00\x01\x2d\xc0", 4) + "end of block" },
+    };
+
+    for (const auto& vector : vectors) {
+        EXPECT_EQ(vector.raw, util::decompress(vector.stored, CompressionCodec::LZ4));
+        // The encoder makes the same choices as liblz4 for these.
+        EXPECT_EQ(vector.stored, util::compress(vector.raw, CompressionCodec::LZ4));
+    }
+}
+
+TEST(Compression, LZ4Corrupt) {
+    const std::string raw = util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf");
+    const std::string compressed = util::compress(raw, CompressionCodec::LZ4);
+
+    // Truncated data.
+    EXPECT_THROW(util::decompress("", CompressionCodec::LZ4), std::runtime_error);
+    EXPECT_THROW(util::decompress(compressed.substr(0, compressed.size() / 2), CompressionCodec::LZ4), std::runtime_error);
+
+    // A wrong uncompressed size.
+    std::string wrongSize = compressed;
+    wrongSize[0]++;
+    EXPECT_THROW(util::decompress(wrongSize, CompressionCodec::LZ4), std::runtime_error);
+
+    // A match before the start of the data.
+    EXPECT_THROW(util::decompress(std::string("\x08\x00\x00\x00\x00\x01\x00\x00", 8), CompressionCodec::LZ4), std::runtime_error);
+
+    // Data compressed with another codec.
+    EXPECT_THROW(util::decompress(util::compress(raw), CompressionCodec::LZ4), std::runtime_error);
+}
+
+TEST(Compression, Codecs) {
+    const std::string raw = util::read_file("test/fixtures/api/assets/streets.json");
+
+    for (auto codec : { CompressionCodec::None, CompressionCodec::Zlib, CompressionCodec::LZ4 }) {
+        EXPECT_EQ(raw, util::decompress(util::compress(raw, codec), codec));
+    }
+
+    EXPECT_EQ(raw, util::compress(raw, CompressionCodec::None));
+    EXPECT_EQ(util::compress(raw), util::compress(raw, CompressionCodec::Zlib));
+    EXPECT_THROW(util::decompress(raw, CompressionCodec(255)), std::runtime_error);
+}
+
+TEST(Compression, Gzip) {
+    // "hello hello hello", as compressed by gzip.
+    const std::string gzip("\x1f\x8b\x08\x00\x00\x00\x00\x00\x02\x03\xcb\x48\xcd\xc9\xc9\x57\xc8\x40"
+                           "\x90\x00\x80\x88\xf9\xe5\x11\x00\x00\x00", 28);
+    EXPECT_TRUE(util::isCompressed(gzip));
+    EXPECT_EQ("hello hello hello", util::decompress(gzip));
+    EXPECT_EQ("hello hello hello", util::decompress(gzip, CompressionCodec::Zlib));
+}
+
+TEST(Compression, IsCompressed) {
+    EXPECT_TRUE(util::isCompressed(util::compress("hello hello hello")));
+    EXPECT_FALSE(util::isCompressed(""));
+    EXPECT_FALSE(util::isCompressed("x"));
+    EXPECT_FALSE(util::isCompressed("hello hello hello"));
+
+    // None of the formats tiles come in looks compressed.
+    EXPECT_FALSE(util::isCompressed(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf")));
+    EXPECT_FALSE(util::isCompressed(util::read_file("test/fixtures/image/tile.png")));
+    EXPECT_FALSE(util::isCompressed(util::read_file("test/fixtures/image/tile.jpeg")));
+    EXPECT_FALSE(util::isCompressed(util::read_file("test/fixtures/image/tile.webp")));
+}
+
+TEST(Compression, InflateIfCompressed) {
+    auto raw = std::make_shared<const std::string>("hello hello hello");
+    EXPECT_EQ(raw, util::inflateIfCompressed(raw));
+    EXPECT_EQ(nullptr, util::inflateIfCompressed(nullptr));
+
+    auto inflated = util::inflateIfCompressed(std::make_shared<const std::string>(util::compress(*raw)));
+    ASSERT_TRUE(inflated);
+    EXPECT_EQ(*raw, *inflated);
+}
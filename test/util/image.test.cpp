@@ -4,6 +4,9 @@
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+
 using namespace mbgl;
 
 TEST(Image, PNGRoundTrip) {
@@ -34,6 +37,68 @@ TEST(Image, PNGRoundTripAlpha) {
     EXPECT_EQ(128, image.data[3]);
 }
 
+// A gradient with translucent edges and many more than 256 colors.
+static PremultipliedImage gradient() {
+    PremultipliedImage image({ 64, 48 });
+    for (uint32_t y = 0; y < image.size.height; y++) {
+        for (uint32_t x = 0; x < image.size.width; x++) {
+            uint8_t* pixel = image.data.get() + 4 * (y * image.size.width + x);
+            const uint8_t alpha = x < 4 ? 64 * x : 255;
+            pixel[0] = uint8_t(4 * x) * alpha / 255;
+            pixel[1] = uint8_t(5 * y) * alpha / 255;
+            pixel[2] = uint8_t(2 * (x + y)) * alpha / 255;
+            pixel[3] = alpha;
+        }
+    }
+    return image;
+}
+
+TEST(Image, PNGRoundTripFilters) {
+    const PremultipliedImage rgba = gradient();
+    const PremultipliedImage expected = decodeImage(encodePNG(rgba));
+
+    using Filter = PNGEncodeOptions::Filter;
+    for (auto filter : { Filter::Sub, Filter::Up, Filter::Average, Filter::Paeth, Filter::Adaptive }) {
+        PNGEncodeOptions options;
+        options.filter = filter;
+        options.compressionLevel = 9;
+        EXPECT_EQ(expected, decodeImage(encodePNG(rgba, options)));
+    }
+}
+
+TEST(Image, PNGRoundTripPalette) {
+    PremultipliedImage rgba({ 16, 16 });
+    for (uint32_t i = 0; i < 16 * 16; i++) {
+        const uint8_t colors[3][4] = { { 255, 0, 0, 255 }, { 0, 64, 0, 128 }, { 0, 0, 0, 0 } };
+        std::copy(colors[i % 3], colors[i % 3] + 4, rgba.data.get() + 4 * i);
+    }
+
+    PNGEncodeOptions options;
+    options.palette = PNGEncodeOptions::Palette::Exact;
+    const std::string png = encodePNG(rgba, options);
+    EXPECT_EQ(decodeImage(encodePNG(rgba)), decodeImage(png));
+#if !defined(__QT__)
+    EXPECT_EQ(3, png[25]); // Indexed color type
+#endif
+
+    // Images with more than 256 colors are encoded as RGBA, unless they are quantized.
+    const PremultipliedImage many = gradient();
+    EXPECT_EQ(decodeImage(encodePNG(many)), decodeImage(encodePNG(many, options)));
+
+    options.palette = PNGEncodeOptions::Palette::Quantize;
+    const PremultipliedImage expected = decodeImage(encodePNG(many));
+    const PremultipliedImage quantized = decodeImage(encodePNG(many, options));
+    ASSERT_EQ(expected.size, quantized.size);
+    int maxError = 0;
+    double totalError = 0;
+    for (std::size_t i = 0; i < expected.bytes(); i++) {
+        maxError = std::max(maxError, std::abs(expected.data[i] - quantized.data[i]));
+        totalError += std::abs(expected.data[i] - quantized.data[i]);
+    }
+    EXPECT_LE(maxError, 32);
+    EXPECT_LE(totalError / expected.bytes(), 4);
+}
+
 TEST(Image, PNGReadNoProfile) {
     PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/no_profile.png"));
     EXPECT_EQ(128, image.data[0]);
@@ -79,6 +144,11 @@ TEST(Image, JPEGTile) {
 }
 
 #if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+TEST(Image, PNGTruncated) {
+    const std::string data = util::read_file("test/fixtures/image/tile.png");
+    EXPECT_THROW(decodeImage(data.substr(0, data.size() / 2)), std::runtime_error);
+}
+
 TEST(Image, WebPTile) {
     PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/tile.webp"));
     EXPECT_EQ(256u, image.size.width);
@@ -0,0 +1,113 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/image_buffer_pool.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::util;
+
+TEST(ImageBufferPool, Reuse) {
+    ImageBufferPool pool;
+
+    uint8_t* first = nullptr;
+    {
+        PremultipliedImage image({ 256, 256 }, pool);
+        first = image.data.get();
+        EXPECT_EQ(256u * 256 * 4, pool.getStats().bytesInUse);
+        EXPECT_EQ(0u, pool.getStats().bytesRetained);
+    }
+    EXPECT_EQ(0u, pool.getStats().bytesInUse);
+    EXPECT_EQ(256u * 256 * 4, pool.getStats().bytesRetained);
+
+    PremultipliedImage image({ 256, 256 }, pool);
+    EXPECT_EQ(first, image.data.get());
+
+    const auto stats = pool.getStats();
+    EXPECT_EQ(2u, stats.acquired);
+    EXPECT_EQ(1u, stats.reused);
+    EXPECT_DOUBLE_EQ(0.5, stats.reuseRate());
+    EXPECT_EQ(256u * 256 * 4, stats.peakBytes);
+}
+
+TEST(ImageBufferPool, SizeClasses) {
+    ImageBufferPool pool;
+
+    // A bordered 256px DEM tile fits the buffer of a 257px raster tile, but not the one of a
+    // 256px raster tile.
+    { PremultipliedImage image({ 258, 258 }, pool); }
+    { PremultipliedImage image({ 257, 257 }, pool); }
+    EXPECT_EQ(1u, pool.getStats().reused);
+    { PremultipliedImage image({ 256, 256 }, pool); }
+    EXPECT_EQ(1u, pool.getStats().reused);
+
+    // Buffers are at most 25% larger than requested.
+    for (std::size_t bytes = ImageBufferPool::minPooledBytes; bytes < 4 * 1024 * 1024; bytes += 4099) {
+        auto buffer = pool.acquire(bytes);
+        EXPECT_LE(bytes, pool.getStats().bytesInUse);
+        EXPECT_GE(bytes * 5 / 4, pool.getStats().bytesInUse);
+    }
+}
+
+TEST(ImageBufferPool, SmallBuffers) {
+    ImageBufferPool pool;
+    { AlphaImage image({ 16, 16 }, pool); }
+    EXPECT_EQ(0u, pool.getStats().acquired);
+    EXPECT_EQ(0u, pool.getStats().bytesRetained);
+}
+
+TEST(ImageBufferPool, MaxRetainedBytes) {
+    ImageBufferPool pool(256 * 256 * 4);
+    {
+        PremultipliedImage a({ 256, 256 }, pool);
+        PremultipliedImage b({ 256, 256 }, pool);
+        EXPECT_EQ(2u * 256 * 256 * 4, pool.getStats().peakBytes);
+    }
+    EXPECT_EQ(256u * 256 * 4, pool.getStats().bytesRetained);
+
+    pool.setMaxRetainedBytes(0);
+    EXPECT_EQ(0u, pool.getStats().bytesRetained);
+
+    pool.setMaxRetainedBytes(256 * 256 * 4);
+    { PremultipliedImage image({ 256, 256 }, pool); }
+    EXPECT_EQ(256u * 256 * 4, pool.getStats().bytesRetained);
+    pool.clear();
+    EXPECT_EQ(0u, pool.getStats().bytesRetained);
+}
+
+TEST(ImageBufferPool, Premultiply) {
+    ImageBufferPool pool;
+    {
+        UnassociatedImage image({ 256, 256 }, pool);
+        image.fill(255);
+        PremultipliedImage premultiplied = util::premultiply(std::move(image));
+        EXPECT_EQ(256u * 256 * 4, pool.getStats().bytesInUse);
+    }
+    EXPECT_EQ(0u, pool.getStats().bytesInUse);
+    EXPECT_EQ(256u * 256 * 4, pool.getStats().bytesRetained);
+}
+
+TEST(ImageBufferPool, Threads) {
+    ImageBufferPool pool;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 100; j++) {
+                PremultipliedImage image({ 256, 256 }, pool);
+                image.fill(0);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto stats = pool.getStats();
+    EXPECT_EQ(400u, stats.acquired);
+    EXPECT_GE(stats.reused, 396u);
+    EXPECT_EQ(0u, stats.bytesInUse);
+    EXPECT_LE(stats.peakBytes, 4u * 256 * 256 * 4);
+}
@@ -0,0 +1,35 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/mipmap.hpp>
+
+using namespace mbgl;
+
+TEST(Mipmap, Chain) {
+    PremultipliedImage image({ 8, 8 });
+    for (std::size_t i = 0; i < image.bytes(); i += 4) {
+        // Columns alternate between black and white.
+        const uint8_t value = (i / 4) % 2 ? 255 : 0;
+        image.data[i + 0] = image.data[i + 1] = image.data[i + 2] = value;
+        image.data[i + 3] = 255;
+    }
+
+    const auto levels = util::mipmaps(image);
+    ASSERT_EQ(3u, levels.size());
+    EXPECT_EQ((Size{ 4, 4 }), levels[0].size);
+    EXPECT_EQ((Size{ 2, 2 }), levels[1].size);
+    EXPECT_EQ((Size{ 1, 1 }), levels[2].size);
+
+    for (const auto& level : levels) {
+        for (std::size_t i = 0; i < level.bytes(); i += 4) {
+            EXPECT_EQ(128, level.data[i + 0]);
+            EXPECT_EQ(255, level.data[i + 3]);
+        }
+    }
+}
+
+TEST(Mipmap, Unsupported) {
+    EXPECT_TRUE(util::mipmaps(PremultipliedImage({ 256, 128 })).empty());
+    EXPECT_TRUE(util::mipmaps(PremultipliedImage({ 300, 300 })).empty());
+    EXPECT_TRUE(util::mipmaps(PremultipliedImage()).empty());
+    EXPECT_EQ(8u, util::mipmaps(PremultipliedImage({ 256, 256 })).size());
+}
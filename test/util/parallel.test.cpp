@@ -0,0 +1,44 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/parallel.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(Parallel, CallsEachIndexOnce) {
+    ThreadPool threadPool { 4 };
+
+    std::vector<std::atomic<int>> calls(1000);
+    util::parallelFor(threadPool, calls.size(), 3, [&] (std::size_t i) { calls[i]++; });
+
+    for (const auto& count : calls) {
+        EXPECT_EQ(1, count);
+    }
+}
+
+TEST(Parallel, BusyScheduler) {
+    ThreadPool threadPool { 1 };
+
+    // When the only thread of the pool helps with the outer loop, the inner loop it runs can't
+    // be helped by it, and is completed by the calling thread alone.
+    std::atomic<std::size_t> calls { 0 };
+    util::parallelFor(threadPool, 2, 1, [&] (std::size_t) {
+        util::parallelFor(threadPool, 100, 1, [&] (std::size_t) { calls++; });
+    });
+
+    EXPECT_EQ(200u, calls);
+}
+
+TEST(Parallel, RethrowsException) {
+    ThreadPool threadPool { 4 };
+
+    EXPECT_THROW(util::parallelFor(threadPool, 100, 3, [&] (std::size_t i) {
+        if (i == 50) {
+            throw std::runtime_error("error");
+        }
+    }), std::runtime_error);
+}
@@ -0,0 +1,168 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/pixel_kernels.hpp>
+
+#include <vector>
+
+using namespace mbgl;
+using util::InstructionSet;
+
+namespace {
+
+const InstructionSet vectorized[] = { InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::NEON };
+
+// Every combination of color and alpha, followed by a few pixels that don't fill a whole vector.
+std::vector<uint8_t> allColors() {
+    std::vector<uint8_t> data;
+    for (uint32_t a = 0; a < 256; a++) {
+        for (uint32_t c = 0; c < 256; c++) {
+            data.insert(data.end(), { uint8_t(c), uint8_t(255 - c), uint8_t(c * 7), uint8_t(a) });
+        }
+    }
+    data.insert(data.end(), { 200, 100, 50, 150, 1, 2, 3, 4, 255, 255, 255, 0 });
+    return data;
+}
+
+// Every 24-bit RGB value, followed by a few pixels that don't fill a whole vector.
+std::vector<uint8_t> allElevations() {
+    std::vector<uint8_t> data;
+    data.reserve((1 << 24) * 4 + 12);
+    for (uint32_t rgb = 0; rgb < (1 << 24); rgb++) {
+        data.insert(data.end(), { uint8_t(rgb >> 16), uint8_t(rgb >> 8), uint8_t(rgb), 255 });
+    }
+    data.insert(data.end(), { 1, 134, 160, 255, 128, 0, 0, 255, 255, 255, 255, 255 });
+    return data;
+}
+
+} // end namespace
+
+TEST(PixelKernels, Scalar) {
+    std::vector<uint8_t> data = { 255, 128, 0, 128, 200, 100, 50, 0 };
+
+    util::premultiply(data.data(), 2, InstructionSet::Scalar);
+    EXPECT_EQ((std::vector<uint8_t>{ 128, 64, 0, 128, 0, 0, 0, 0 }), data);
+
+    data = { 128, 64, 0, 128, 200, 100, 50, 0 };
+    util::unpremultiply(data.data(), 2, InstructionSet::Scalar);
+    EXPECT_EQ((std::vector<uint8_t>{ 255, 128, 0, 128, 200, 100, 50, 0 }), data);
+
+    const std::vector<uint8_t> dem = { 1, 134, 160, 255, 128, 0, 0, 255 };
+    std::vector<int32_t> elevation(2);
+
+    util::decodeMapboxDEM(dem.data(), elevation.data(), 2, InstructionSet::Scalar);
+    EXPECT_EQ((std::vector<int32_t>{ 0 + 65536, 828860 + 65536 }), elevation);
+
+    util::decodeTerrariumDEM(dem.data(), elevation.data(), 2, InstructionSet::Scalar);
+    EXPECT_EQ((std::vector<int32_t>{ -32378 + 65536, 0 + 65536 }), elevation);
+
+    const std::vector<uint8_t> row0 = { 1, 255, 1, 10, 0, 255, 2, 20 };
+    const std::vector<uint8_t> row1 = { 1, 255, 3, 30, 0, 255, 4, 40 };
+    std::vector<uint8_t> pixel(4);
+    util::downsample(row0.data(), row1.data(), pixel.data(), 1, InstructionSet::Scalar);
+    EXPECT_EQ((std::vector<uint8_t>{ 1, 255, 3, 25 }), pixel);
+
+    // A plane rising by 2 to the right and by 1 to the bottom, and a flat pixel.
+    const std::vector<int32_t> above = { 0, 2, 4, 4, 4, 4 };
+    const std::vector<int32_t> center = { 1, 3, 5, 4, 4, 4 };
+    const std::vector<int32_t> below = { 2, 4, 6, 4, 4, 4 };
+    util::hillshadeSlopes(above.data() + 1, center.data() + 1, below.data() + 1, pixel.data(), 1, 10.0f, InstructionSet::Scalar);
+    EXPECT_EQ((std::vector<uint8_t>{ 128 + 127, 128 + 80, 255, 255 }), pixel);
+    util::hillshadeSlopes(above.data() + 4, center.data() + 4, below.data() + 4, pixel.data(), 1, 10.0f, InstructionSet::Scalar);
+    EXPECT_EQ((std::vector<uint8_t>{ 128, 128, 255, 255 }), pixel);
+}
+
+TEST(PixelKernels, Premultiply) {
+    const auto input = allColors();
+    auto expected = input;
+    util::premultiply(expected.data(), expected.size() / 4, InstructionSet::Scalar);
+
+    for (auto set : vectorized) {
+        if (!util::supports(set)) {
+            continue;
+        }
+        auto actual = input;
+        util::premultiply(actual.data(), actual.size() / 4, set);
+        EXPECT_EQ(expected, actual) << "instruction set " << int(set);
+    }
+}
+
+TEST(PixelKernels, Unpremultiply) {
+    const auto input = allColors();
+    auto expected = input;
+    util::unpremultiply(expected.data(), expected.size() / 4, InstructionSet::Scalar);
+
+    for (auto set : vectorized) {
+        if (!util::supports(set)) {
+            continue;
+        }
+        auto actual = input;
+        util::unpremultiply(actual.data(), actual.size() / 4, set);
+        EXPECT_EQ(expected, actual) << "instruction set " << int(set);
+    }
+}
+
+TEST(PixelKernels, Downsample) {
+    // Rows of every color, with a second row that pairs each value with every other one.
+    const auto row0 = allColors();
+    std::vector<uint8_t> row1(row0.rbegin(), row0.rend());
+    const std::size_t count = row0.size() / 8;
+
+    std::vector<uint8_t> expected(count * 4);
+    util::downsample(row0.data(), row1.data(), expected.data(), count, InstructionSet::Scalar);
+
+    for (auto set : vectorized) {
+        if (!util::supports(set)) {
+            continue;
+        }
+        std::vector<uint8_t> actual(count * 4);
+        util::downsample(row0.data(), row1.data(), actual.data(), count, set);
+        EXPECT_EQ(expected, actual) << "instruction set " << int(set);
+    }
+}
+
+TEST(PixelKernels, HillshadeSlopes) {
+    // Three rows of elevations as stored by DEMData, which vary from flat to steep, padded by a
+    // pixel on both sides.
+    const std::size_t count = 1003;
+    std::vector<int32_t> rows[3];
+    for (std::size_t r = 0; r < 3; r++) {
+        for (std::size_t i = 0; i < count + 2; i++) {
+            rows[r].push_back(65536 + int32_t((i * i * (r + 1) + i * 31 * r) % 9000));
+        }
+    }
+
+    std::vector<uint8_t> expected(count * 4);
+    util::hillshadeSlopes(rows[0].data() + 1, rows[1].data() + 1, rows[2].data() + 1,
+                          expected.data(), count, 0.37f, InstructionSet::Scalar);
+
+    for (auto set : vectorized) {
+        if (!util::supports(set)) {
+            continue;
+        }
+        std::vector<uint8_t> actual(count * 4);
+        util::hillshadeSlopes(rows[0].data() + 1, rows[1].data() + 1, rows[2].data() + 1,
+                              actual.data(), count, 0.37f, set);
+        EXPECT_EQ(expected, actual) << "instruction set " << int(set);
+    }
+}
+
+TEST(PixelKernels, DecodeDEM) {
+    const auto input = allElevations();
+    const std::size_t count = input.size() / 4;
+
+    std::vector<int32_t> expectedMapbox(count);
+    std::vector<int32_t> expectedTerrarium(count);
+    util::decodeMapboxDEM(input.data(), expectedMapbox.data(), count, InstructionSet::Scalar);
+    util::decodeTerrariumDEM(input.data(), expectedTerrarium.data(), count, InstructionSet::Scalar);
+
+    std::vector<int32_t> actual(count);
+    for (auto set : vectorized) {
+        if (!util::supports(set)) {
+            continue;
+        }
+        util::decodeMapboxDEM(input.data(), actual.data(), count, set);
+        EXPECT_TRUE(expectedMapbox == actual) << "instruction set " << int(set);
+        util::decodeTerrariumDEM(input.data(), actual.data(), count, set);
+        EXPECT_TRUE(expectedTerrarium == actual) << "instruction set " << int(set);
+    }
+}
@@ -0,0 +1,46 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/png_encoder.hpp>
+
+#include <future>
+
+using namespace mbgl;
+
+TEST(PNGEncoder, Encode) {
+    ThreadPool threadPool(4);
+    std::vector<PremultipliedImage> images;
+    std::vector<std::promise<std::string>> promises(8);
+    PNGEncoder encoder(threadPool, 3);
+
+    for (std::size_t i = 0; i < promises.size(); i++) {
+        images.emplace_back(Size { 16, uint32_t(8 + i) });
+        images.back().fill(uint8_t(30 * i));
+
+        encoder.encode(images.back().clone(), [&, i] (std::exception_ptr error, std::string png) {
+            EXPECT_FALSE(error);
+            promises[i].set_value(std::move(png));
+        });
+    }
+
+    for (std::size_t i = 0; i < promises.size(); i++) {
+        EXPECT_EQ(encodePNG(images[i]), promises[i].get_future().get());
+    }
+}
+
+#if !defined(__QT__)
+TEST(PNGEncoder, Error) {
+    ThreadPool threadPool(1);
+    std::promise<void> promise;
+    PNGEncodeOptions options;
+    options.compressionLevel = 42;
+    PNGEncoder encoder(threadPool, 1, options);
+
+    encoder.encode(PremultipliedImage({ 4, 4 }), [&] (std::exception_ptr error, std::string png) {
+        EXPECT_TRUE(error);
+        EXPECT_TRUE(png.empty());
+        promise.set_value();
+    });
+    promise.get_future().get();
+}
+#endif // !defined(__QT__)